@@ -0,0 +1,162 @@
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "core/differential/include/differential.hpp"
+#include "core/perf/include/perf.hpp"
+#include "core/task/include/task.hpp"
+#include "core/util/include/thread_pool.hpp"
+
+namespace {
+
+enum class SumVariant : uint8_t { kSequential, kParallel, kBroken };
+
+// Sum of doubles, the parallel variant rounds differently from the sequential one
+template <SumVariant kVariant>
+class SumTask : public ppc::core::Task {
+ public:
+  explicit SumTask(const ppc::core::TaskDataPtr &task_data) : Task(task_data) {}
+
+  bool ValidationImpl() override { return task_data->outputs_count[0] == 1; }
+
+  bool PreProcessingImpl() override {
+    input_ = task_data->GetInput<double>(0);
+    return true;
+  }
+
+  bool RunImpl() override {
+    if constexpr (kVariant == SumVariant::kParallel) {
+      sum_ = ppc::util::ParallelReduce(
+          0, input_.size(), 0.0,
+          [this](size_t begin, size_t end, double sum) {
+            for (size_t i = begin; i < end; i++) {
+              sum += input_[i];
+            }
+            return sum;
+          },
+          [](double a, double b) { return a + b; }, 64);
+    } else {
+      sum_ = 0.0;
+      for (double value : input_) {
+        sum_ += value;
+      }
+      if constexpr (kVariant == SumVariant::kBroken) {
+        sum_ += 1.0;
+      }
+    }
+    return true;
+  }
+
+  bool PostProcessingImpl() override {
+    task_data->GetOutput<double>(0)[0] = sum_;
+    return true;
+  }
+
+ private:
+  std::span<const double> input_;
+  double sum_ = 0.0;
+};
+
+class DifferentialTestData {
+ public:
+  explicit DifferentialTestData(size_t size) : input_(size) {
+    for (size_t i = 0; i < size; i++) {
+      input_[i] = 1.0 / static_cast<double>(i + 1);
+    }
+  }
+
+  std::shared_ptr<ppc::core::TaskData> Make() {
+    outputs_.emplace_back(std::make_unique<double>(0.0));
+    auto task_data = std::make_shared<ppc::core::TaskData>();
+    task_data->AddInput(input_.data(), input_.size());
+    task_data->AddOutput(outputs_.back().get(), 1);
+    return task_data;
+  }
+
+ private:
+  std::vector<double> input_;
+  std::vector<std::unique_ptr<double>> outputs_;
+};
+
+}  // namespace
+
+TEST(differential_tests, check_backends_agree_with_tolerance) {
+  DifferentialTestData data(10000);
+  ppc::core::DifferentialTest test([&data] { return data.Make(); });
+  test.AddBackend<SumTask<SumVariant::kSequential>>("seq");
+  test.AddBackend<SumTask<SumVariant::kParallel>>("stl");
+  test.SetComparator(0, ppc::core::CompareElements<double>(0.0, 1e-12));
+
+  auto results = test.Run();
+  ASSERT_EQ(results.size(), 2U);
+  EXPECT_TRUE(results[0].passed) << results[0].message;
+  EXPECT_TRUE(results[1].passed) << results[1].message;
+}
+
+TEST(differential_tests, check_divergent_backend_is_reported) {
+  DifferentialTestData data(1000);
+  ppc::core::DifferentialTest test([&data] { return data.Make(); });
+  test.AddBackend<SumTask<SumVariant::kSequential>>("seq");
+  test.AddBackend<SumTask<SumVariant::kBroken>>("omp");
+  test.SetComparator(0, ppc::core::CompareElements<double>(1e-9));
+
+  auto results = test.Run();
+  ASSERT_EQ(results.size(), 2U);
+  EXPECT_TRUE(results[0].passed);
+  EXPECT_FALSE(results[1].passed);
+  EXPECT_NE(results[1].message.find("output 0: element 0"), std::string::npos);
+  EXPECT_NE(ppc::core::DifferentialTest::FormatTable(results).find("FAILED"), std::string::npos);
+}
+
+TEST(differential_tests, check_byte_comparison_uses_output_desc) {
+  DifferentialTestData data(1000);
+  ppc::core::DifferentialTest test([&data] { return data.Make(); });
+  test.AddBackend<SumTask<SumVariant::kSequential>>("seq");
+  test.AddBackend<SumTask<SumVariant::kSequential>>("tbb");
+  test.AddBackend<SumTask<SumVariant::kBroken>>("all");
+
+  auto results = test.Run();
+  ASSERT_EQ(results.size(), 3U);
+  EXPECT_TRUE(results[1].passed);
+  EXPECT_EQ(results[2].message, "output 0: bytes differ");
+}
+
+TEST(differential_tests, check_compare_integers) {
+  const std::vector<int32_t> expected = {1, 2, 3};
+  const std::vector<int32_t> actual = {1, 2, 4};
+  auto comparator = ppc::core::CompareElements<int32_t>();
+  EXPECT_EQ(comparator.element_size, sizeof(int32_t));
+  EXPECT_EQ(comparator.compare(reinterpret_cast<const uint8_t *>(expected.data()),
+                               reinterpret_cast<const uint8_t *>(expected.data()), expected.size()),
+            "");
+  EXPECT_EQ(comparator.compare(reinterpret_cast<const uint8_t *>(expected.data()),
+                               reinterpret_cast<const uint8_t *>(actual.data()), expected.size()),
+            "element 2: expected 3, got 4");
+}
+
+TEST(differential_tests, check_speedup_table) {
+  DifferentialTestData data(100000);
+  ppc::core::DifferentialTest test([&data] { return data.Make(); });
+  test.AddBackend<SumTask<SumVariant::kSequential>>("seq");
+  test.AddBackend<SumTask<SumVariant::kParallel>>("stl");
+  test.SetComparator(0, ppc::core::CompareElements<double>(0.0, 1e-12));
+
+  auto perf_attr = std::make_shared<ppc::core::PerfAttr>();
+  perf_attr->num_running = 3;
+  int timer_calls = 0;
+  perf_attr->current_timer = [&] { return 0.5 * static_cast<double>(timer_calls++); };
+
+  auto results = test.Run(perf_attr);
+  ASSERT_EQ(results.size(), 2U);
+  EXPECT_DOUBLE_EQ(results[0].speedup, 1.0);
+  EXPECT_GT(results[1].time_sec, 0.0);
+  const auto table = ppc::core::DifferentialTest::FormatTable(results);
+  std::cout << table;
+  EXPECT_NE(table.find("stl"), std::string::npos);
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "core/perf/include/perf.hpp"
+#include "core/task/include/task.hpp"
+
+namespace ppc::core {
+
+// Comparison of one output buffer of a backend against the reference backend
+struct OutputComparator {
+  size_t element_size = 1;
+  // returns an empty string if count elements are equal, otherwise a
+  // description of the first mismatch
+  std::function<std::string(const uint8_t* reference, const uint8_t* actual, size_t count)> compare;
+};
+
+// Element-wise comparison, floating point elements are equal if they differ
+// by at most max(abs_tolerance, rel_tolerance * |reference|) or are both NaN
+template <typename T>
+OutputComparator CompareElements(double abs_tolerance = 0.0, double rel_tolerance = 0.0) {
+  OutputComparator comparator;
+  comparator.element_size = sizeof(T);
+  comparator.compare = [abs_tolerance, rel_tolerance](const uint8_t* reference, const uint8_t* actual, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+      T expected;
+      T value;
+      std::memcpy(&expected, reference + (i * sizeof(T)), sizeof(T));
+      std::memcpy(&value, actual + (i * sizeof(T)), sizeof(T));
+      bool equal = expected == value;
+      if constexpr (std::is_floating_point_v<T>) {
+        const auto diff = std::abs(static_cast<double>(expected) - static_cast<double>(value));
+        const auto tolerance = std::max(abs_tolerance, rel_tolerance * std::abs(static_cast<double>(expected)));
+        equal = equal || diff <= tolerance || (std::isnan(expected) && std::isnan(value));
+      }
+      if (!equal) {
+        std::ostringstream message;
+        if constexpr (std::is_integral_v<T>) {
+          message << "element " << i << ": expected " << +expected << ", got " << +value;
+        } else {
+          message << "element " << i << ": expected " << expected << ", got " << value;
+        }
+        return message.str();
+      }
+    }
+    return std::string();
+  };
+  return comparator;
+}
+
+// Runs every backend implementation of one algorithm on the same input and
+// checks their outputs against the first added backend (normally seq)
+class DifferentialTest {
+ public:
+  // data_factory returns task data with fresh output buffers on every call,
+  // the buffers must stay alive until the DifferentialTest is destroyed
+  using DataFactory = std::function<std::shared_ptr<TaskData>()>;
+  using TaskFactory = std::function<std::shared_ptr<Task>(const std::shared_ptr<TaskData>&)>;
+
+  struct BackendResult {
+    std::string name;
+    bool passed = false;
+    // reason of the failure, empty if passed
+    std::string message;
+    // time of one run and reference time divided by it, 0 if not measured
+    double time_sec = 0.0;
+    double speedup = 0.0;
+  };
+
+  explicit DifferentialTest(DataFactory data_factory);
+
+  void AddBackend(const std::string& name, TaskFactory task_factory);
+
+  template <typename TaskType>
+  void AddBackend(const std::string& name) {
+    AddBackend(name, [](const std::shared_ptr<TaskData>& task_data) { return std::make_shared<TaskType>(task_data); });
+  }
+
+  // Outputs without a comparator are compared byte by byte, which needs
+  // outputs_desc (see TaskData::AddOutput) for the element size
+  void SetComparator(size_t output_index, OutputComparator comparator);
+
+  // Run every backend once and compare outputs; with perf_attr every backend
+  // is also measured with Perf::TaskRun on fresh data
+  std::vector<BackendResult> Run(const std::shared_ptr<PerfAttr>& perf_attr = nullptr) const;
+
+  // Side-by-side table of the results
+  static std::string FormatTable(const std::vector<BackendResult>& results);
+
+ private:
+  DataFactory data_factory_;
+  std::vector<std::pair<std::string, TaskFactory>> backends_;
+  std::map<size_t, OutputComparator> comparators_;
+
+  [[nodiscard]] std::string CompareOutputs(const TaskData& reference, const TaskData& actual) const;
+};
+
+}  // namespace ppc::core
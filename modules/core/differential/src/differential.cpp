@@ -0,0 +1,107 @@
+#include "core/differential/include/differential.hpp"
+
+#include <cstddef>
+#include <cstring>
+#include <iomanip>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "core/perf/include/perf.hpp"
+#include "core/task/include/task.hpp"
+
+ppc::core::DifferentialTest::DifferentialTest(DataFactory data_factory) : data_factory_(std::move(data_factory)) {}
+
+void ppc::core::DifferentialTest::AddBackend(const std::string& name, TaskFactory task_factory) {
+  backends_.emplace_back(name, std::move(task_factory));
+}
+
+void ppc::core::DifferentialTest::SetComparator(size_t output_index, OutputComparator comparator) {
+  comparators_[output_index] = std::move(comparator);
+}
+
+std::string ppc::core::DifferentialTest::CompareOutputs(const TaskData& reference, const TaskData& actual) const {
+  if (reference.outputs.size() != actual.outputs.size()) {
+    return "count of outputs differs";
+  }
+  for (size_t i = 0; i < reference.outputs.size(); i++) {
+    if (reference.outputs_count[i] != actual.outputs_count[i]) {
+      return "output " + std::to_string(i) + ": count " + std::to_string(actual.outputs_count[i]) + " instead of " +
+             std::to_string(reference.outputs_count[i]);
+    }
+    auto comparator = comparators_.find(i);
+    std::string mismatch;
+    if (comparator != comparators_.end()) {
+      mismatch = comparator->second.compare(reference.outputs[i], actual.outputs[i], reference.outputs_count[i]);
+    } else {
+      if (i >= reference.outputs_desc.size() || reference.outputs_desc[i].element_size == 0) {
+        throw std::invalid_argument("DifferentialTest: no comparator and no element size for output " +
+                                    std::to_string(i));
+      }
+      const size_t bytes = reference.outputs_desc[i].element_size * reference.outputs_count[i];
+      if (std::memcmp(reference.outputs[i], actual.outputs[i], bytes) != 0) {
+        mismatch = "bytes differ";
+      }
+    }
+    if (!mismatch.empty()) {
+      return "output " + std::to_string(i) + ": " + mismatch;
+    }
+  }
+  return {};
+}
+
+std::vector<ppc::core::DifferentialTest::BackendResult> ppc::core::DifferentialTest::Run(
+    const std::shared_ptr<PerfAttr>& perf_attr) const {
+  if (backends_.empty()) {
+    throw std::invalid_argument("DifferentialTest: no backends");
+  }
+  std::vector<BackendResult> results;
+  std::shared_ptr<TaskData> reference_data;
+  for (const auto& [name, task_factory] : backends_) {
+    BackendResult result;
+    result.name = name;
+
+    auto task_data = data_factory_();
+    auto task = task_factory(task_data);
+    if (!task->Validation()) {
+      result.message = "validation failed";
+    } else if (!task->PreProcessing() || !task->Run() || !task->PostProcessing()) {
+      result.message = "task failed";
+    } else if (results.empty()) {
+      reference_data = task_data;
+    } else if (!reference_data) {
+      result.message = "no reference output";
+    } else {
+      result.message = CompareOutputs(*reference_data, *task_data);
+    }
+    result.passed = result.message.empty();
+
+    if (perf_attr && result.passed) {
+      auto perf_results = std::make_shared<PerfResults>();
+      Perf(task_factory(data_factory_())).TaskRun(perf_attr, perf_results);
+      result.time_sec = perf_results->GetTimePerRun();
+    }
+    results.push_back(std::move(result));
+  }
+
+  const double reference_time = results.front().time_sec;
+  for (auto& result : results) {
+    result.speedup = result.time_sec > 0.0 ? reference_time / result.time_sec : 0.0;
+  }
+  return results;
+}
+
+std::string ppc::core::DifferentialTest::FormatTable(const std::vector<BackendResult>& results) {
+  std::ostringstream table;
+  table << std::left << std::setw(12) << "backend" << std::right << std::setw(16) << "time, s" << std::setw(10)
+        << "speedup" << "  status\n";
+  for (const auto& result : results) {
+    table << std::left << std::setw(12) << result.name << std::right << std::scientific << std::setprecision(4)
+          << std::setw(16) << result.time_sec << std::fixed << std::setprecision(2) << std::setw(10) << result.speedup
+          << "  " << (result.passed ? "ok" : "FAILED: " + result.message) << '\n';
+  }
+  return table.str();
+}
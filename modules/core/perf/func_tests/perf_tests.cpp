@@ -1,13 +1,19 @@
 #include <gtest/gtest.h>
 
 #include <chrono>
+#include <cmath>
+#include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <semaphore>
+#include <thread>
 #include <vector>
 
 #include "core/perf/func_tests/test_task.hpp"
+#include "core/perf/include/counters.hpp"
 #include "core/perf/include/perf.hpp"
 #include "core/task/include/task.hpp"
+#include "core/util/include/util.hpp"
 
 TEST(perf_tests, check_perf_pipeline) {
   // Create data
@@ -175,3 +181,380 @@ TEST(perf_tests, check_perf_task_float) {
   ASSERT_LE(perf_results->time_sec, ppc::core::PerfResults::kMaxTime);
   EXPECT_EQ(out[0], in.size());
 }
+
+TEST(perf_tests, check_perf_statistics) {
+  std::vector<double> samples = {1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0, 9.0, 10.0, 1000.0};
+
+  auto stats = ppc::core::ComputePerfStatistics(samples);
+
+  EXPECT_EQ(stats.num_samples, samples.size());
+  EXPECT_EQ(stats.num_outliers, 1U);
+  EXPECT_DOUBLE_EQ(stats.min, 1.0);
+  EXPECT_DOUBLE_EQ(stats.max, 1000.0);
+  EXPECT_DOUBLE_EQ(stats.median, 6.0);
+  EXPECT_DOUBLE_EQ(stats.mean, 5.5);
+  EXPECT_NEAR(stats.stddev, 3.0276503541, 1e-9);
+  // t(0.975, 9) = 2.2622
+  EXPECT_NEAR(stats.ci_high - stats.mean, 2.2622 * stats.stddev / std::sqrt(10.0), 1e-3);
+  EXPECT_LE(stats.ci_low, stats.mean);
+  EXPECT_GE(stats.p99, stats.p90);
+  EXPECT_GE(stats.p90, stats.median);
+}
+
+TEST(perf_tests, check_perf_pipeline_per_iteration) {
+  // Create data
+  std::vector<uint32_t> in(2000, 1);
+  std::vector<uint32_t> out(1, 0);
+
+  // Create task_data
+  auto task_data = std::make_shared<ppc::core::TaskData>();
+  task_data->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  task_data->inputs_count.emplace_back(in.size());
+  task_data->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  task_data->outputs_count.emplace_back(out.size());
+
+  // Create Task
+  auto test_task = std::make_shared<ppc::test::perf::TestTask<uint32_t>>(task_data);
+
+  // Create Perf attributes: every timer call advances the clock by 0.5 sec
+  auto perf_attr = std::make_shared<ppc::core::PerfAttr>();
+  perf_attr->num_running = 5;
+  perf_attr->num_warmup = 3;
+  perf_attr->measurement_mode = ppc::core::PerfAttr::MeasurementMode::kPerIteration;
+  int timer_calls = 0;
+  perf_attr->current_timer = [&] { return 0.5 * static_cast<double>(timer_calls++); };
+
+  // Create and init perf results
+  auto perf_results = std::make_shared<ppc::core::PerfResults>();
+
+  // Create Perf analyzer
+  ppc::core::Perf perf_analyzer(test_task);
+  perf_analyzer.PipelineRun(perf_attr, perf_results);
+
+  // Get perf statistic
+  ppc::core::Perf::PrintPerfStatistic(perf_results);
+  EXPECT_EQ(timer_calls, 10);
+  ASSERT_EQ(perf_results->samples.size(), 5U);
+  EXPECT_DOUBLE_EQ(perf_results->time_sec, 2.5);
+  EXPECT_DOUBLE_EQ(perf_results->statistics.median, 0.5);
+  EXPECT_DOUBLE_EQ(perf_results->statistics.stddev, 0.0);
+  EXPECT_EQ(out[0], in.size());
+}
+
+TEST(perf_tests, check_perf_task_adaptive_stop) {
+  // Create data
+  std::vector<uint32_t> in(2000, 1);
+  std::vector<uint32_t> out(1, 0);
+
+  // Create task_data
+  auto task_data = std::make_shared<ppc::core::TaskData>();
+  task_data->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  task_data->inputs_count.emplace_back(in.size());
+  task_data->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  task_data->outputs_count.emplace_back(out.size());
+
+  // Create Task
+  auto test_task = std::make_shared<ppc::test::perf::TestTask<uint32_t>>(task_data);
+
+  // Create Perf attributes: runs take 10 and 12 ms in turn
+  auto perf_attr = std::make_shared<ppc::core::PerfAttr>();
+  perf_attr->num_running = 3;
+  perf_attr->max_running = 1000;
+  perf_attr->target_relative_error = 0.01;
+  perf_attr->measurement_mode = ppc::core::PerfAttr::MeasurementMode::kPerIteration;
+  double clock = 0.0;
+  int timer_calls = 0;
+  perf_attr->current_timer = [&] {
+    if (timer_calls++ % 2 == 1) {
+      clock += (timer_calls % 4 == 0) ? 0.012 : 0.010;
+    }
+    return clock;
+  };
+
+  // Create and init perf results
+  auto perf_results = std::make_shared<ppc::core::PerfResults>();
+
+  // Create Perf analyzer
+  ppc::core::Perf perf_analyzer(test_task);
+  perf_analyzer.TaskRun(perf_attr, perf_results);
+
+  const auto &stats = perf_results->statistics;
+  EXPECT_GT(perf_results->samples.size(), 3U);
+  EXPECT_LT(perf_results->samples.size(), 1000U);
+  EXPECT_LE(stats.relative_error, 0.01);
+  EXPECT_NEAR(stats.mean, 0.011, 0.0001);
+  EXPECT_LE(stats.ci_low, 0.011);
+  EXPECT_GE(stats.ci_high, 0.011);
+  EXPECT_EQ(out[0], in.size());
+}
+
+TEST(perf_tests, check_perf_task_adaptive_stop_keeps_time_limit) {
+  // Create data
+  std::vector<uint32_t> in(2000, 1);
+  std::vector<uint32_t> out(1, 0);
+
+  // Create task_data
+  auto task_data = std::make_shared<ppc::core::TaskData>();
+  task_data->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  task_data->inputs_count.emplace_back(in.size());
+  task_data->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  task_data->outputs_count.emplace_back(out.size());
+
+  // Create Task
+  auto test_task = std::make_shared<ppc::test::perf::TestTask<uint32_t>>(task_data);
+
+  // Create Perf attributes: runs take 0.5 and 1.5 sec in turn, too noisy to converge
+  auto perf_attr = std::make_shared<ppc::core::PerfAttr>();
+  perf_attr->num_running = 3;
+  perf_attr->max_running = 1000;
+  perf_attr->target_relative_error = 0.01;
+  perf_attr->measurement_mode = ppc::core::PerfAttr::MeasurementMode::kPerIteration;
+  double clock = 0.0;
+  int timer_calls = 0;
+  perf_attr->current_timer = [&] {
+    if (timer_calls++ % 2 == 1) {
+      clock += (timer_calls % 4 == 0) ? 1.5 : 0.5;
+    }
+    return clock;
+  };
+
+  // Create and init perf results
+  auto perf_results = std::make_shared<ppc::core::PerfResults>();
+
+  // Create Perf analyzer
+  ppc::core::Perf perf_analyzer(test_task);
+  perf_analyzer.TaskRun(perf_attr, perf_results);
+
+  EXPECT_GT(perf_results->num_runs, 3U);
+  EXPECT_LT(perf_results->time_sec, ppc::core::PerfResults::kMaxTime);
+  EXPECT_NO_THROW(ppc::core::Perf::PrintPerfStatistic(perf_results));
+  EXPECT_EQ(out[0], in.size());
+}
+
+TEST(perf_tests, check_perf_pipeline_hw_counters) {
+  // Create data
+  std::vector<uint32_t> in(20000, 1);
+  std::vector<uint32_t> out(1, 0);
+
+  // Create task_data
+  auto task_data = std::make_shared<ppc::core::TaskData>();
+  task_data->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  task_data->inputs_count.emplace_back(in.size());
+  task_data->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  task_data->outputs_count.emplace_back(out.size());
+
+  // Create Task
+  auto test_task = std::make_shared<ppc::test::perf::TestTask<uint32_t>>(task_data);
+
+  // Create Perf attributes
+  auto perf_attr = std::make_shared<ppc::core::PerfAttr>();
+  perf_attr->num_running = 10;
+  perf_attr->enable_hw_counters = true;
+  perf_attr->num_elements = in.size();
+
+  // Create and init perf results
+  auto perf_results = std::make_shared<ppc::core::PerfResults>();
+
+  // Create Perf analyzer
+  ppc::core::Perf perf_analyzer(test_task);
+  perf_analyzer.PipelineRun(perf_attr, perf_results);
+
+  // Get perf statistic
+  ppc::core::Perf::PrintPerfStatistic(perf_results);
+  EXPECT_EQ(out[0], in.size());
+  if (!perf_results->counters.available) {
+    GTEST_SKIP() << "perf_event_open is not permitted on this host";
+  }
+  // every element takes at least one instruction
+  EXPECT_GE(perf_results->counters.instructions, perf_attr->num_running * in.size());
+  EXPECT_GT(perf_results->counters.ipc, 0.0);
+}
+
+TEST(perf_tests, check_hw_counters_per_element_use_input_count) {
+  // Create data
+  std::vector<uint32_t> in(20000, 1);
+  std::vector<uint32_t> out(1, 0);
+
+  // Create task_data
+  auto task_data = std::make_shared<ppc::core::TaskData>();
+  task_data->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  task_data->inputs_count.emplace_back(in.size());
+  task_data->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  task_data->outputs_count.emplace_back(out.size());
+
+  // Create Task
+  auto test_task = std::make_shared<ppc::test::perf::TestTask<uint32_t>>(task_data);
+
+  // Create Perf attributes: num_elements is left unset
+  auto perf_attr = std::make_shared<ppc::core::PerfAttr>();
+  perf_attr->num_running = 10;
+  perf_attr->enable_hw_counters = true;
+
+  // Create and init perf results
+  auto perf_results = std::make_shared<ppc::core::PerfResults>();
+
+  // Create Perf analyzer
+  ppc::core::Perf perf_analyzer(test_task);
+  perf_analyzer.PipelineRun(perf_attr, perf_results);
+  EXPECT_EQ(perf_results->num_elements, in.size());
+  const auto &counters = perf_results->counters;
+  if (!counters.available) {
+    GTEST_SKIP() << "perf_event_open is not permitted on this host";
+  }
+  // the metrics use the element count of the record
+  const auto processed = static_cast<double>(perf_results->num_runs * perf_results->num_elements);
+  EXPECT_GT(counters.branch_misses, 0U);
+  EXPECT_GT(counters.branch_misses_per_element, 0.0);
+  EXPECT_DOUBLE_EQ(counters.branch_misses_per_element, static_cast<double>(counters.branch_misses) / processed);
+  EXPECT_DOUBLE_EQ(counters.llc_misses_per_element, static_cast<double>(counters.llc_misses) / processed);
+  EXPECT_DOUBLE_EQ(counters.dtlb_misses_per_element, static_cast<double>(counters.dtlb_misses) / processed);
+}
+
+TEST(perf_tests, check_hw_counters_cover_existing_threads) {
+  // a worker started before the counters are opened, like a pool thread
+  std::binary_semaphore start(0);
+  std::binary_semaphore done(0);
+  volatile uint64_t sum = 0;
+  std::thread worker([&] {
+    start.acquire();
+    for (uint64_t i = 0; i < 1000000; i++) {
+      sum = sum + i;
+    }
+    done.release();
+  });
+
+  ppc::core::HardwareCounters counters;
+  if (!counters.IsAvailable()) {
+    start.release();
+    worker.join();
+    GTEST_SKIP() << "perf_event_open is not permitted on this host";
+  }
+  EXPECT_GE(counters.GetNumThreads(), 2U);
+  counters.Start();
+  start.release();
+  done.acquire();
+  counters.Stop();
+  worker.join();
+  // the loop of the worker alone takes more than a million instructions
+  EXPECT_GE(counters.GetValue(ppc::core::HardwareCounters::kInstructions), 1000000U);
+}
+
+TEST(perf_tests, check_perf_task_phases) {
+  // Create data
+  std::vector<uint32_t> in(2000, 1);
+  std::vector<uint32_t> out(1, 0);
+
+  // Create task_data
+  auto task_data = std::make_shared<ppc::core::TaskData>();
+  task_data->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  task_data->inputs_count.emplace_back(in.size());
+  task_data->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  task_data->outputs_count.emplace_back(out.size());
+
+  // Create Task
+  auto test_task = std::make_shared<ppc::test::perf::TestTask<uint32_t>>(task_data);
+
+  // Create Perf attributes
+  auto perf_attr = std::make_shared<ppc::core::PerfAttr>();
+  perf_attr->num_running = 10;
+  perf_attr->num_warmup = 2;
+  perf_attr->measurement_mode = ppc::core::PerfAttr::MeasurementMode::kPerIteration;
+
+  // Create and init perf results
+  auto perf_results = std::make_shared<ppc::core::PerfResults>();
+
+  // Create Perf analyzer
+  ppc::core::Perf perf_analyzer(test_task);
+  perf_analyzer.TaskRun(perf_attr, perf_results);
+
+  // Get perf statistic
+  ppc::core::Perf::PrintPerfStatistic(perf_results);
+  const auto &phases = perf_results->phases;
+  EXPECT_GT(phases.run, 0.0);
+  EXPECT_GE(phases.validation, 0.0);
+  EXPECT_GE(phases.pre_processing, 0.0);
+  EXPECT_GE(phases.post_processing, 0.0);
+  EXPECT_EQ(out[0], in.size());
+}
+
+TEST(perf_tests, check_perf_scaling_metrics) {
+  ppc::core::ScalingAttr scaling_attr;
+  scaling_attr.flops = [](uint64_t size) { return 2.0 * static_cast<double>(size); };
+
+  // 1 thread: 1 ms per 1000 elements, 4 threads: 2 ms overhead + 0.25 ms per 1000 elements
+  ppc::core::ScalingResults scaling_results;
+  for (uint64_t size : {1000, 4000, 16000, 64000}) {
+    for (int num_threads : {1, 4}) {
+      ppc::core::ScalingPoint point;
+      point.size = size;
+      point.num_threads = num_threads;
+      const double work = static_cast<double>(size) * 1e-6;
+      point.time_sec = num_threads == 1 ? work : 2e-3 + (work / 4.0);
+      scaling_results.points.push_back(point);
+    }
+  }
+  ppc::core::ComputeScalingMetrics(scaling_attr, scaling_results);
+
+  const auto &serial = scaling_results.points[0];
+  EXPECT_DOUBLE_EQ(serial.elements_per_sec, 1e6);
+  EXPECT_DOUBLE_EQ(serial.gflops, 2e-3);
+  EXPECT_DOUBLE_EQ(serial.strong_efficiency, 1.0);
+  EXPECT_DOUBLE_EQ(serial.speedup, 1.0);
+
+  // 16000 elements on 4 threads: 6 ms against 16 ms
+  const auto &parallel = scaling_results.points[5];
+  ASSERT_EQ(parallel.size, 16000U);
+  ASSERT_EQ(parallel.num_threads, 4);
+  EXPECT_DOUBLE_EQ(parallel.speedup, 16.0 / 6.0);
+  EXPECT_DOUBLE_EQ(parallel.strong_efficiency, 16.0 / 6.0 / 4.0);
+  // same elements per thread as 4000 elements on 1 thread
+  EXPECT_DOUBLE_EQ(parallel.weak_efficiency, 4.0 / 6.0);
+  // 4000 elements: 3 ms against 4 ms, 1000 elements: 2.25 ms against 1 ms
+  EXPECT_EQ(scaling_results.crossover_size, 4000U);
+}
+
+TEST(perf_tests, check_perf_scaling_run) {
+  std::vector<std::vector<uint32_t>> inputs;
+  std::vector<std::vector<uint32_t>> outputs;
+  auto generator = [&](uint64_t size) {
+    inputs.emplace_back(size, 1);
+    outputs.emplace_back(1, 0);
+    auto task_data = std::make_shared<ppc::core::TaskData>();
+    task_data->inputs.emplace_back(reinterpret_cast<uint8_t *>(inputs.back().data()));
+    task_data->inputs_count.emplace_back(inputs.back().size());
+    task_data->outputs.emplace_back(reinterpret_cast<uint8_t *>(outputs.back().data()));
+    task_data->outputs_count.emplace_back(outputs.back().size());
+    return std::make_shared<ppc::test::perf::TestTask<uint32_t>>(task_data);
+  };
+  inputs.reserve(8);
+  outputs.reserve(8);
+
+  auto perf_attr = std::make_shared<ppc::core::PerfAttr>();
+  perf_attr->num_running = 3;
+  const auto t0 = std::chrono::high_resolution_clock::now();
+  perf_attr->current_timer = [&] {
+    auto current_time_point = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(current_time_point - t0).count();
+    return static_cast<double>(duration) * 1e-9;
+  };
+  ppc::core::ScalingAttr scaling_attr;
+  scaling_attr.sizes = {2000, 4000};
+  scaling_attr.num_threads = {1, 2};
+  const int num_threads = ppc::util::GetPPCNumThreads();
+
+  auto scaling_results = std::make_shared<ppc::core::ScalingResults>();
+  ppc::core::Perf::ScalingRun(generator, perf_attr, scaling_attr, scaling_results);
+  ppc::core::Perf::PrintScalingStatistic(scaling_results);
+
+  ASSERT_EQ(scaling_results->points.size(), 4U);
+  EXPECT_EQ(ppc::util::GetPPCNumThreads(), num_threads);
+  for (const auto &point : scaling_results->points) {
+    EXPECT_EQ(point.results.num_elements, point.size);
+    EXPECT_EQ(point.results.num_threads, point.num_threads);
+    EXPECT_GT(point.elements_per_sec, 0.0);
+  }
+  EXPECT_GT(scaling_results->points[3].weak_efficiency, 0.0);
+  for (size_t i = 0; i < outputs.size(); i++) {
+    EXPECT_EQ(outputs[i][0], inputs[i].size());
+  }
+}
@@ -0,0 +1,184 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "core/perf/func_tests/test_task.hpp"
+#include "core/perf/include/perf.hpp"
+#include "core/perf/include/report.hpp"
+#include "core/task/include/task.hpp"
+
+namespace {
+
+std::vector<std::string> ReadLines(const std::string &path) {
+  std::ifstream file(path);
+  std::vector<std::string> lines;
+  std::string line;
+  while (std::getline(file, line)) {
+    lines.push_back(line);
+  }
+  return lines;
+}
+
+std::vector<std::string> SplitCsv(const std::string &line) {
+  std::vector<std::string> fields(1);
+  for (const char c : line) {
+    if (c == ',') {
+      fields.emplace_back();
+    } else {
+      fields.back() += c;
+    }
+  }
+  return fields;
+}
+
+std::string TempPath(const std::string &name) {
+  auto path = std::filesystem::temp_directory_path() / name;
+  std::filesystem::remove(path);
+  return path.string();
+}
+
+}  // namespace
+
+TEST(report_tests, check_make_perf_record) {
+  ppc::core::PerfResults results;
+  results.type_of_running = ppc::core::PerfResults::TypeOfRunning::kTaskRun;
+  results.time_sec = 1.5;
+
+  auto record = ppc::core::MakePerfRecord("tasks/omp/example_omp", results);
+  EXPECT_EQ(record.task_id, "example_omp");
+  EXPECT_EQ(record.backend, "omp");
+  EXPECT_EQ(record.type_of_running, "task_run");
+  EXPECT_EQ(record.timestamp.size(), std::string("2025-01-01T00:00:00Z").size());
+  EXPECT_GT(record.host.num_logical_cpus, 0);
+
+  auto windows_record = ppc::core::MakePerfRecord("tasks\\seq\\example", results);
+  EXPECT_EQ(windows_record.task_id, "example");
+  EXPECT_EQ(windows_record.backend, "seq");
+}
+
+TEST(report_tests, check_json_line) {
+  ppc::core::PerfRecord record;
+  record.task_id = "task \"quoted\"";
+  record.backend = "tbb";
+  record.results.samples = {0.25, 0.5};
+  record.results.num_threads = 4;
+
+  const auto line = ppc::core::ToJsonLine(record);
+  EXPECT_EQ(line.find('\n'), std::string::npos);
+  EXPECT_NE(line.find(R"("task_id":"task \"quoted\"")"), std::string::npos);
+  EXPECT_NE(line.find(R"("samples":[0.25,0.5])"), std::string::npos);
+  EXPECT_NE(line.find(R"("num_threads":4)"), std::string::npos);
+  EXPECT_EQ(line.front(), '{');
+  EXPECT_EQ(line.back(), '}');
+}
+
+TEST(report_tests, check_csv_row_matches_header) {
+  ppc::core::PerfRecord record;
+  record.task_id = "task";
+  record.backend = "seq";
+  record.host.compiler = "gcc";
+  record.results.samples = {0.25, 0.5};
+
+  const auto header = ppc::core::GetCsvHeader();
+  const auto row = ppc::core::ToCsvRow(record);
+  EXPECT_EQ(std::ranges::count(header, ','), std::ranges::count(row, ','));
+  EXPECT_TRUE(row.ends_with("0.25;0.5"));
+}
+
+TEST(report_tests, check_counters_in_json_and_csv) {
+  ppc::core::PerfRecord record;
+  record.task_id = "task";
+  record.results.samples = {0.25, 0.5};
+  auto &counters = record.results.counters;
+  counters.available = true;
+  counters.instructions = 4000;
+  counters.cycles = 2000;
+  counters.ipc = 2.0;
+  counters.llc_misses_per_element = 0.5;
+  counters.branch_misses_per_element = 0.25;
+  counters.dtlb_misses_per_element = 0.125;
+
+  const auto line = ppc::core::ToJsonLine(record);
+  EXPECT_NE(line.find(R"("ipc":2,"llc_misses_per_element":0.5,"branch_misses_per_element":0.25,)"
+                      R"("dtlb_misses_per_element":0.125})"),
+            std::string::npos);
+
+  const auto header = SplitCsv(ppc::core::GetCsvHeader());
+  auto field = [&](const std::string &row, const std::string &name) {
+    const auto fields = SplitCsv(row);
+    const auto column = std::ranges::find(header, name) - header.begin();
+    return static_cast<size_t>(column) < fields.size() ? fields[column] : std::string("<missing>");
+  };
+  const auto row = ppc::core::ToCsvRow(record);
+  EXPECT_EQ(field(row, "ipc"), "2");
+  EXPECT_EQ(field(row, "llc_misses_per_element"), "0.5");
+  EXPECT_EQ(field(row, "branch_misses_per_element"), "0.25");
+  EXPECT_EQ(field(row, "dtlb_misses_per_element"), "0.125");
+  EXPECT_EQ(field(row, "validation"), "0");
+
+  // like the raw counts, the metrics stay empty without counters
+  counters.available = false;
+  const auto empty_row = ppc::core::ToCsvRow(record);
+  EXPECT_EQ(SplitCsv(empty_row).size(), header.size());
+  EXPECT_EQ(field(empty_row, "llc_misses_per_element"), "");
+  EXPECT_EQ(field(empty_row, "dtlb_misses_per_element"), "");
+}
+
+TEST(report_tests, check_append_csv_writes_header_once) {
+  const auto path = TempPath("ppc_report_tests.csv");
+  ppc::core::PerfRecord record;
+  record.task_id = "task";
+
+  ppc::core::AppendPerfRecord(path, record);
+  ppc::core::AppendPerfRecord(path, record);
+
+  const auto lines = ReadLines(path);
+  ASSERT_EQ(lines.size(), 3U);
+  EXPECT_EQ(lines[0], ppc::core::GetCsvHeader());
+  EXPECT_EQ(lines[1], lines[2]);
+  std::filesystem::remove(path);
+}
+
+TEST(report_tests, check_print_perf_statistic_writes_record) {
+#ifndef _WIN32
+  const auto path = TempPath("ppc_report_tests.jsonl");
+  setenv("PPC_PERF_OUTPUT", path.c_str(), 1);  // NOLINT(misc-include-cleaner)
+
+  std::vector<uint32_t> in(2000, 1);
+  std::vector<uint32_t> out(1, 0);
+  auto task_data = std::make_shared<ppc::core::TaskData>();
+  task_data->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  task_data->inputs_count.emplace_back(in.size());
+  task_data->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  task_data->outputs_count.emplace_back(out.size());
+  auto test_task = std::make_shared<ppc::test::perf::TestTask<uint32_t>>(task_data);
+
+  auto perf_attr = std::make_shared<ppc::core::PerfAttr>();
+  perf_attr->num_running = 3;
+  perf_attr->measurement_mode = ppc::core::PerfAttr::MeasurementMode::kPerIteration;
+  auto perf_results = std::make_shared<ppc::core::PerfResults>();
+
+  ppc::core::Perf perf_analyzer(test_task);
+  perf_analyzer.PipelineRun(perf_attr, perf_results);
+  ppc::core::Perf::PrintPerfStatistic(perf_results);
+  unsetenv("PPC_PERF_OUTPUT");  // NOLINT(misc-include-cleaner)
+
+  EXPECT_EQ(perf_results->num_runs, 3U);
+  EXPECT_EQ(perf_results->num_elements, in.size());
+  const auto lines = ReadLines(path);
+  ASSERT_EQ(lines.size(), 1U);
+  EXPECT_NE(lines[0].find(R"("type_of_running":"pipeline")"), std::string::npos);
+  EXPECT_NE(lines[0].find(R"("num_elements":2000)"), std::string::npos);
+  std::filesystem::remove(path);
+#else
+  GTEST_SKIP();
+#endif
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ppc::core {
+
+struct PerfCounters {
+  // true if the kernel allowed to open at least cycles and instructions
+  bool available = false;
+  // totals over all measured runs, events not supported by the host stay 0
+  uint64_t cycles = 0;
+  uint64_t instructions = 0;
+  uint64_t llc_misses = 0;
+  uint64_t branch_misses = 0;
+  uint64_t dtlb_misses = 0;
+  // instructions per cycle
+  double ipc = 0.0;
+  // misses per processed element and run (PerfResults::num_elements)
+  double llc_misses_per_element = 0.0;
+  double branch_misses_per_element = 0.0;
+  double dtlb_misses_per_element = 0.0;
+};
+
+// Hardware counters summed over the threads of the process: one counter per
+// thread that exists when they are opened (the caller and already started
+// pool, TBB or OpenMP workers), each also counting the threads that thread
+// creates while they are open (Linux perf_event_open, no-op elsewhere).
+// Work of unrelated threads of the process is counted as well.
+class HardwareCounters {
+ public:
+  enum Event : uint8_t { kCycles, kInstructions, kLlcMisses, kBranchMisses, kDtlbMisses, kNumEvents };
+
+  HardwareCounters();
+  HardwareCounters(const HardwareCounters &) = delete;
+  HardwareCounters &operator=(const HardwareCounters &) = delete;
+  ~HardwareCounters();
+
+  [[nodiscard]] bool IsAvailable() const;
+  // start counting, values accumulate over Start()/Stop() pairs
+  void Start();
+  void Stop();
+  void Reset();
+  [[nodiscard]] uint64_t GetValue(Event event) const;
+  // threads a counter was opened for
+  [[nodiscard]] size_t GetNumThreads() const;
+  // fill totals and derived metrics for num_runs runs over num_elements elements
+  [[nodiscard]] PerfCounters GetResults(uint64_t num_runs, uint64_t num_elements) const;
+
+ private:
+  std::array<std::vector<int>, kNumEvents> fds_;
+};
+
+}  // namespace ppc::core
@@ -3,7 +3,11 @@
 #include <cstdint>
 #include <functional>
 #include <memory>
+#include <source_location>
+#include <string>
+#include <vector>
 
+#include "core/perf/include/counters.hpp"
 #include "core/task/include/task.hpp"
 
 namespace ppc::core {
@@ -12,6 +16,43 @@ struct PerfAttr {
   // count of task's running
   uint64_t num_running;
   std::function<double()> current_timer = [&] { return 0.0; };
+  // kTotal times all runs with one begin/end pair, kPerIteration times
+  // every run separately and collects statistics over the samples
+  enum MeasurementMode : uint8_t { kTotal, kPerIteration } measurement_mode = kTotal;
+  // count of untimed runs before measurement (kPerIteration only)
+  uint64_t num_warmup = 0;
+  // upper bound of timed runs: after num_running runs the measurement goes on
+  // until the relative error of the mean is below target_relative_error
+  // (kPerIteration only, 0 disables the adaptive stop); the extra runs also
+  // stop once a run as slow as the slowest one so far would bring the total
+  // time to PerfResults::kMaxTime
+  uint64_t max_running = 0;
+  double target_relative_error = 0.0;
+  // confidence level of the interval for the mean
+  double confidence_level = 0.95;
+  // read hardware counters around every Run() call (Linux only)
+  bool enable_hw_counters = false;
+  // count of elements processed by one run, used for per element metrics
+  uint64_t num_elements = 0;
+};
+
+struct PerfStatistics {
+  // count of samples and count of samples rejected by Tukey's fences
+  uint64_t num_samples = 0;
+  uint64_t num_outliers = 0;
+  // order statistics over all samples (in seconds)
+  double min = 0.0;
+  double median = 0.0;
+  double p90 = 0.0;
+  double p99 = 0.0;
+  double max = 0.0;
+  // moments and confidence interval over samples without outliers (in seconds)
+  double mean = 0.0;
+  double stddev = 0.0;
+  double ci_low = 0.0;
+  double ci_high = 0.0;
+  // half-width of the confidence interval divided by the mean
+  double relative_error = 0.0;
 };
 
 struct PerfResults {
@@ -19,8 +60,72 @@ struct PerfResults {
   double time_sec = 0.0;
   enum TypeOfRunning : uint8_t { kPipeline, kTaskRun, kNone } type_of_running = kNone;
   constexpr static double kMaxTime = 10.0;
+  // count of timed runs, elements processed by one run (PerfAttr::num_elements
+  // or the first input count) and threads available to the task
+  uint64_t num_runs = 0;
+  uint64_t num_elements = 0;
+  int num_threads = 0;
+  // time of every timed run (in seconds), filled in kPerIteration mode
+  std::vector<double> samples;
+  PerfStatistics statistics;
+  // hardware counters over measured runs, filled if PerfAttr::enable_hw_counters
+  PerfCounters counters;
+  // time of every task's phase over measured runs (in seconds); for kTaskRun
+  // Validation, PreProcessing and PostProcessing are called once around the runs
+  PhaseTimings phases;
+
+  // time of one run: median of samples or mean over the total time
+  [[nodiscard]] double GetTimePerRun() const;
+};
+
+// Grid of a scaling sweep: every size is measured with every thread count
+struct ScalingAttr {
+  // problem sizes (in elements) and thread counts, empty num_threads means
+  // GetPPCNumThreads() only
+  std::vector<uint64_t> sizes;
+  std::vector<int> num_threads;
+  // floating point operations and bytes moved by one run of the size, used
+  // for GFLOP/s and bytes/s (not reported if not set)
+  std::function<double(uint64_t)> flops;
+  std::function<double(uint64_t)> bytes;
+  // sequential task of the same problem used as reference for speedups and
+  // the crossover size; without it the smallest thread count is the reference
+  std::function<std::shared_ptr<Task>(uint64_t)> baseline_generator;
+};
+
+struct ScalingPoint {
+  uint64_t size = 0;
+  int num_threads = 0;
+  // time of one run (median in kPerIteration mode, mean otherwise)
+  double time_sec = 0.0;
+  double elements_per_sec = 0.0;
+  double gflops = 0.0;
+  double bytes_per_sec = 0.0;
+  // time of one run of the reference at the same size
+  double baseline_time_sec = 0.0;
+  // baseline time / time, and speedup per thread relative to the smallest
+  // thread count of the same size
+  double speedup = 0.0;
+  double strong_efficiency = 0.0;
+  // time at the smallest thread count with the same elements per thread
+  // divided by time, 0 if the grid has no such point
+  double weak_efficiency = 0.0;
+  PerfResults results;
+};
+
+struct ScalingResults {
+  std::vector<ScalingPoint> points;
+  // smallest size from which the largest thread count is faster than the
+  // reference at every larger size, 0 if it never is
+  uint64_t crossover_size = 0;
 };
 
+// Fill throughput, speedups, efficiencies and crossover from measured times
+void ComputeScalingMetrics(const ScalingAttr& scaling_attr, ScalingResults& scaling_results);
+
+// Compute order statistics, moments and confidence interval of the samples
+PerfStatistics ComputePerfStatistics(std::vector<double> samples, double confidence_level = 0.95);
+
 class Perf {
  public:
   // Init performance analysis with initialized task and initialized data
@@ -33,13 +138,28 @@ class Perf {
   void PipelineRun(const std::shared_ptr<PerfAttr>& perf_attr, const std::shared_ptr<PerfResults>& perf_results) const;
   // Check performance of task's Run() function
   void TaskRun(const std::shared_ptr<PerfAttr>& perf_attr, const std::shared_ptr<PerfResults>& perf_results) const;
-  // Pint results for automation checkers
-  static void PrintPerfStatistic(const std::shared_ptr<PerfResults>& perf_results);
+  // Pint results for automation checkers, the task path is taken from the
+  // calling perf test file (tasks/<backend>/<task>/perf_tests/...)
+  static void PrintPerfStatistic(const std::shared_ptr<PerfResults>& perf_results,
+                                 const std::source_location& location = std::source_location::current());
+  // Same for the task path of the form tasks/<backend>/<task>
+  static void PrintPerfStatistic(const std::string& task_path, const std::shared_ptr<PerfResults>& perf_results);
+  // Check performance of Run() of tasks made by generator over the grid of
+  // sizes and thread counts, the thread count is set by SetPPCNumThreads()
+  static void ScalingRun(const std::function<std::shared_ptr<Task>(uint64_t)>& generator,
+                         const std::shared_ptr<PerfAttr>& perf_attr, const ScalingAttr& scaling_attr,
+                         const std::shared_ptr<ScalingResults>& scaling_results);
+  static void PrintScalingStatistic(const std::shared_ptr<ScalingResults>& scaling_results,
+                                    const std::source_location& location = std::source_location::current());
+  static void PrintScalingStatistic(const std::string& task_path,
+                                    const std::shared_ptr<ScalingResults>& scaling_results);
 
  private:
   std::shared_ptr<Task> task_;
-  static void CommonRun(const std::shared_ptr<PerfAttr>& perf_attr, const std::function<void()>& pipeline,
-                        const std::shared_ptr<PerfResults>& perf_results);
+  void CommonRun(const std::shared_ptr<PerfAttr>& perf_attr, const std::function<void()>& pipeline,
+                 const std::shared_ptr<PerfResults>& perf_results, HardwareCounters* counters) const;
+  void StatisticalRun(const std::shared_ptr<PerfAttr>& perf_attr, const std::function<void()>& pipeline,
+                      const std::shared_ptr<PerfResults>& perf_results, HardwareCounters* counters) const;
 };
 
 }  // namespace ppc::core
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <string>
+
+#include "core/perf/include/perf.hpp"
+
+namespace ppc::core {
+
+struct HostInfo {
+  std::string hostname;
+  std::string cpu_model;
+  std::string os;
+  std::string compiler;
+  int num_logical_cpus = 0;
+  int num_physical_cores = 0;
+  int num_numa_nodes = 0;
+};
+
+// Description of the machine and the build the measurement was taken on
+HostInfo GetHostInfo();
+
+// One measurement of one task in a form independent of the test framework
+struct PerfRecord {
+  // name of the task directory and its backend ("seq", "omp", "tbb", ...)
+  std::string task_id;
+  std::string backend;
+  // "pipeline", "task_run" or "none"
+  std::string type_of_running;
+  // UTC time of the measurement in ISO 8601
+  std::string timestamp;
+  PerfResults results;
+  HostInfo host;
+};
+
+// Record for task_path of the form "tasks/<backend>/<task_id>"
+PerfRecord MakePerfRecord(const std::string& task_path, const PerfResults& results);
+
+// Record as one line of JSON (without trailing newline)
+std::string ToJsonLine(const PerfRecord& record);
+
+// Header and rows of CSV, samples are joined with ';' in one column
+std::string GetCsvHeader();
+std::string ToCsvRow(const PerfRecord& record);
+
+// Append the record to the file, CSV for ".csv" files and JSON lines otherwise;
+// the CSV header is written when the file is empty
+void AppendPerfRecord(const std::string& file_path, const PerfRecord& record);
+
+}  // namespace ppc::core
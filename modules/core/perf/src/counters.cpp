@@ -0,0 +1,187 @@
+#include "core/perf/include/counters.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <array>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+#endif
+
+#ifdef __linux__
+namespace {
+
+struct EventConfig {
+  uint32_t type;
+  uint64_t config;
+};
+
+constexpr uint64_t HwCacheConfig(uint64_t cache, uint64_t op, uint64_t result) {
+  return cache | (op << 8) | (result << 16);
+}
+
+constexpr std::array<EventConfig, ppc::core::HardwareCounters::kNumEvents> kEventConfigs = {{
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {PERF_TYPE_HW_CACHE,
+     HwCacheConfig(PERF_COUNT_HW_CACHE_LL, PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_RESULT_MISS)},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+    {PERF_TYPE_HW_CACHE,
+     HwCacheConfig(PERF_COUNT_HW_CACHE_DTLB, PERF_COUNT_HW_CACHE_OP_READ, PERF_COUNT_HW_CACHE_RESULT_MISS)},
+}};
+
+int OpenEvent(const EventConfig &event, pid_t tid) {
+  perf_event_attr attr{};
+  std::memset(&attr, 0, sizeof(attr));
+  attr.size = sizeof(attr);
+  attr.type = event.type;
+  attr.config = event.config;
+  attr.disabled = 1;
+  // also count the threads this thread creates while the counters are open;
+  // the kernel adds their counts to the parent only when those threads exit
+  attr.inherit = 1;
+  // user space only: works with the default perf_event_paranoid level
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+  return static_cast<int>(syscall(SYS_perf_event_open, &attr, tid, -1, -1, 0));
+}
+
+// The calling thread first, then the other threads the process already has:
+// pool, TBB and OpenMP workers usually exist before the counters are opened
+// and are not covered by inherit
+std::vector<pid_t> ProcessThreads() {
+  const auto self = static_cast<pid_t>(syscall(SYS_gettid));
+  std::vector<pid_t> threads = {self};
+  std::error_code error;
+  for (const auto &entry : std::filesystem::directory_iterator("/proc/self/task", error)) {
+    const auto tid = static_cast<pid_t>(std::stol(entry.path().filename().string()));
+    if (tid != self) {
+      threads.push_back(tid);
+    }
+  }
+  return threads;
+}
+
+}  // namespace
+#endif
+
+ppc::core::HardwareCounters::HardwareCounters() {
+#ifdef __linux__
+  const auto threads = ProcessThreads();
+  for (int i = 0; i < kNumEvents; i++) {
+    // an event the calling thread cannot count is left out for all threads
+    for (const pid_t tid : threads) {
+      const int fd = OpenEvent(kEventConfigs[i], tid);
+      if (fd < 0) {
+        if (tid == threads.front()) {
+          break;
+        }
+        // the thread exited meanwhile
+        continue;
+      }
+      fds_[i].push_back(fd);
+    }
+  }
+#endif
+}
+
+ppc::core::HardwareCounters::~HardwareCounters() {
+#ifdef __linux__
+  for (const auto &fds : fds_) {
+    for (int fd : fds) {
+      close(fd);
+    }
+  }
+#endif
+}
+
+bool ppc::core::HardwareCounters::IsAvailable() const {
+  return !fds_[kCycles].empty() && !fds_[kInstructions].empty();
+}
+
+size_t ppc::core::HardwareCounters::GetNumThreads() const { return fds_[kCycles].size(); }
+
+void ppc::core::HardwareCounters::Start() {
+#ifdef __linux__
+  for (const auto &fds : fds_) {
+    for (int fd : fds) {
+      ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+  }
+#endif
+}
+
+void ppc::core::HardwareCounters::Stop() {
+#ifdef __linux__
+  for (const auto &fds : fds_) {
+    for (int fd : fds) {
+      ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+    }
+  }
+#endif
+}
+
+void ppc::core::HardwareCounters::Reset() {
+#ifdef __linux__
+  for (const auto &fds : fds_) {
+    for (int fd : fds) {
+      ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+    }
+  }
+#endif
+}
+
+uint64_t ppc::core::HardwareCounters::GetValue(Event event) const {
+#ifdef __linux__
+  uint64_t total = 0;
+  for (int fd : fds_[event]) {
+    // value, time enabled, time running
+    std::array<uint64_t, 3> data{};
+    if (read(fd, data.data(), sizeof(data)) != static_cast<ssize_t>(sizeof(data)) || data[2] == 0) {
+      continue;
+    }
+    // scale up if the kernel multiplexed the counter with other events
+    if (data[2] < data[1]) {
+      total += static_cast<uint64_t>(static_cast<double>(data[0]) * static_cast<double>(data[1]) /
+                                     static_cast<double>(data[2]));
+    } else {
+      total += data[0];
+    }
+  }
+  return total;
+#else
+  return 0;
+#endif
+}
+
+ppc::core::PerfCounters ppc::core::HardwareCounters::GetResults(uint64_t num_runs, uint64_t num_elements) const {
+  PerfCounters counters;
+  counters.available = IsAvailable();
+  if (!counters.available) {
+    return counters;
+  }
+  counters.cycles = GetValue(kCycles);
+  counters.instructions = GetValue(kInstructions);
+  counters.llc_misses = GetValue(kLlcMisses);
+  counters.branch_misses = GetValue(kBranchMisses);
+  counters.dtlb_misses = GetValue(kDtlbMisses);
+  if (counters.cycles != 0) {
+    counters.ipc = static_cast<double>(counters.instructions) / static_cast<double>(counters.cycles);
+  }
+  const auto processed = static_cast<double>(num_runs) * static_cast<double>(num_elements);
+  if (processed > 0.0) {
+    counters.llc_misses_per_element = static_cast<double>(counters.llc_misses) / processed;
+    counters.branch_misses_per_element = static_cast<double>(counters.branch_misses) / processed;
+    counters.dtlb_misses_per_element = static_cast<double>(counters.dtlb_misses) / processed;
+  }
+  return counters;
+}
@@ -1,17 +1,171 @@
 #include "core/perf/include/perf.hpp"
 
-#include <gtest/gtest.h>
-
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <iomanip>
 #include <iostream>
+#include <iterator>
 #include <memory>
+#include <numbers>
+#include <source_location>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <vector>
 
+#include "core/perf/include/counters.hpp"
+#include "core/perf/include/report.hpp"
 #include "core/task/include/task.hpp"
+#include "core/util/include/util.hpp"
+
+namespace {
+
+// Linear interpolation between closest ranks of sorted samples
+double Percentile(const std::vector<double>& sorted, double q) {
+  if (sorted.empty()) {
+    return 0.0;
+  }
+  const double pos = q * static_cast<double>(sorted.size() - 1);
+  const auto lower = static_cast<size_t>(std::floor(pos));
+  const size_t upper = std::min(lower + 1, sorted.size() - 1);
+  const double frac = pos - static_cast<double>(lower);
+  return sorted[lower] + ((sorted[upper] - sorted[lower]) * frac);
+}
+
+// Inverse of the standard normal CDF (P. J. Acklam's rational approximation)
+double NormalQuantile(double p) {
+  constexpr double kA[] = {-3.969683028665376e+01, 2.209460984245205e+02, -2.759285104469687e+02,
+                           1.383577518672690e+02,  -3.066479806614716e+01, 2.506628277459239e+00};
+  constexpr double kB[] = {-5.447609879822406e+01, 1.615858368580409e+02, -1.556989798598866e+02,
+                           6.680131188771972e+01,  -1.328068155288572e+01};
+  constexpr double kC[] = {-7.784894002430293e-03, -3.223964580411365e-01, -2.400758277161838e+00,
+                           -2.549732539343734e+00, 4.374664141464968e+00,  2.938163982698783e+00};
+  constexpr double kD[] = {7.784695709041462e-03, 3.224671290700398e-01, 2.445134137142996e+00,
+                           3.754408661907416e+00};
+  constexpr double kLow = 0.02425;
+  if (p < kLow) {
+    const double q = std::sqrt(-2.0 * std::log(p));
+    return (((((kC[0] * q + kC[1]) * q + kC[2]) * q + kC[3]) * q + kC[4]) * q + kC[5]) /
+           ((((kD[0] * q + kD[1]) * q + kD[2]) * q + kD[3]) * q + 1.0);
+  }
+  if (p > 1.0 - kLow) {
+    return -NormalQuantile(1.0 - p);
+  }
+  const double q = p - 0.5;
+  const double r = q * q;
+  return (((((kA[0] * r + kA[1]) * r + kA[2]) * r + kA[3]) * r + kA[4]) * r + kA[5]) * q /
+         (((((kB[0] * r + kB[1]) * r + kB[2]) * r + kB[3]) * r + kB[4]) * r + 1.0);
+}
+
+// Quantile of Student's t distribution: exact for 1 and 2 degrees of freedom,
+// Cornish-Fisher expansion around the normal quantile otherwise
+double StudentQuantile(double p, size_t dof) {
+  if (dof == 1) {
+    return std::tan(std::numbers::pi * (p - 0.5));
+  }
+  if (dof == 2) {
+    return (2.0 * p - 1.0) * std::sqrt(2.0 / (4.0 * p * (1.0 - p)));
+  }
+  const double z = NormalQuantile(p);
+  const double n = static_cast<double>(dof);
+  const double z3 = z * z * z;
+  const double z5 = z3 * z * z;
+  const double z7 = z5 * z * z;
+  return z + ((z3 + z) / (4.0 * n)) + ((5.0 * z5 + 16.0 * z3 + 3.0 * z) / (96.0 * n * n)) +
+         ((3.0 * z7 + 19.0 * z5 + 17.0 * z3 - 15.0 * z) / (384.0 * n * n * n));
+}
+
+// Path of the perf test file relative to the project without the tests directory
+std::string GetTestPath(const char* file) {
+  std::string relative_path(file);
+  std::string ppc_regex_template("parallel_programming_course");
+  std::string perf_regex_template("perf_tests");
+
+  auto first_found_position = relative_path.find(ppc_regex_template);
+  if (first_found_position != std::string::npos) {
+    relative_path.erase(0, first_found_position + ppc_regex_template.length() + 1);
+  }
+
+  auto last_found_position = relative_path.find(perf_regex_template);
+  if (last_found_position != std::string::npos && last_found_position > 0) {
+    relative_path.erase(last_found_position - 1, relative_path.length() - 1);
+  }
+  return relative_path;
+}
+
+// Restores PPC_NUM_THREADS changed by a scaling sweep
+class NumThreadsGuard {
+ public:
+  NumThreadsGuard() : saved_(ppc::util::GetEnvVar("PPC_NUM_THREADS")) {}
+  NumThreadsGuard(const NumThreadsGuard&) = delete;
+  NumThreadsGuard& operator=(const NumThreadsGuard&) = delete;
+  ~NumThreadsGuard() { ppc::util::SetPPCNumThreads(saved_.empty() ? 0 : std::atoi(saved_.c_str())); }
+
+ private:
+  std::string saved_;
+};
+
+}  // namespace
+
+double ppc::core::PerfResults::GetTimePerRun() const {
+  if (!samples.empty()) {
+    return statistics.median;
+  }
+  return num_runs == 0 ? 0.0 : time_sec / static_cast<double>(num_runs);
+}
+
+ppc::core::PerfStatistics ppc::core::ComputePerfStatistics(std::vector<double> samples, double confidence_level) {
+  PerfStatistics stats;
+  if (samples.empty()) {
+    return stats;
+  }
+  std::ranges::sort(samples);
+  stats.num_samples = samples.size();
+  stats.min = samples.front();
+  stats.max = samples.back();
+  stats.median = Percentile(samples, 0.5);
+  stats.p90 = Percentile(samples, 0.9);
+  stats.p99 = Percentile(samples, 0.99);
+
+  // Tukey's fences: samples further than 1.5 IQR from the quartiles are outliers
+  const double q1 = Percentile(samples, 0.25);
+  const double q3 = Percentile(samples, 0.75);
+  const double fence_low = q1 - (1.5 * (q3 - q1));
+  const double fence_high = q3 + (1.5 * (q3 - q1));
+  std::vector<double> inliers;
+  inliers.reserve(samples.size());
+  std::ranges::copy_if(samples, std::back_inserter(inliers),
+                       [&](double x) { return x >= fence_low && x <= fence_high; });
+  stats.num_outliers = samples.size() - inliers.size();
+
+  double sum = 0.0;
+  for (double x : inliers) {
+    sum += x;
+  }
+  const auto n = static_cast<double>(inliers.size());
+  stats.mean = sum / n;
+  if (inliers.size() > 1) {
+    double sq_sum = 0.0;
+    for (double x : inliers) {
+      sq_sum += (x - stats.mean) * (x - stats.mean);
+    }
+    stats.stddev = std::sqrt(sq_sum / (n - 1.0));
+  }
+
+  double half_width = 0.0;
+  if (inliers.size() > 1) {
+    const double t = StudentQuantile(0.5 + (confidence_level / 2.0), inliers.size() - 1);
+    half_width = t * stats.stddev / std::sqrt(n);
+  }
+  stats.ci_low = stats.mean - half_width;
+  stats.ci_high = stats.mean + half_width;
+  stats.relative_error = stats.mean > 0.0 ? half_width / stats.mean : 0.0;
+  return stats;
+}
 
 ppc::core::Perf::Perf(const std::shared_ptr<Task>& task_ptr) { SetTask(task_ptr); }
 
@@ -24,25 +178,59 @@ void ppc::core::Perf::PipelineRun(const std::shared_ptr<PerfAttr>& perf_attr,
                                   const std::shared_ptr<ppc::core::PerfResults>& perf_results) const {
   perf_results->type_of_running = PerfResults::TypeOfRunning::kPipeline;
 
+  std::unique_ptr<HardwareCounters> counters;
+  if (perf_attr->enable_hw_counters) {
+    counters = std::make_unique<HardwareCounters>();
+  }
+
+  task_->ResetPhaseTimings();
   CommonRun(
       perf_attr,
       [&]() {
         task_->Validation();
         task_->PreProcessing();
+        if (counters) {
+          counters->Start();
+        }
         task_->Run();
+        if (counters) {
+          counters->Stop();
+        }
         task_->PostProcessing();
       },
-      perf_results);
+      perf_results, counters.get());
+  perf_results->phases = task_->GetPhaseTimings();
 }
 
 void ppc::core::Perf::TaskRun(const std::shared_ptr<PerfAttr>& perf_attr,
                               const std::shared_ptr<ppc::core::PerfResults>& perf_results) const {
   perf_results->type_of_running = PerfResults::TypeOfRunning::kTaskRun;
 
+  std::unique_ptr<HardwareCounters> counters;
+  if (perf_attr->enable_hw_counters) {
+    counters = std::make_unique<HardwareCounters>();
+  }
+
+  task_->ResetPhaseTimings();
   task_->Validation();
   task_->PreProcessing();
-  CommonRun(perf_attr, [&]() { task_->Run(); }, perf_results);
+  auto setup_phases = task_->GetPhaseTimings();
+  CommonRun(
+      perf_attr,
+      [&]() {
+        if (counters) {
+          counters->Start();
+        }
+        task_->Run();
+        if (counters) {
+          counters->Stop();
+        }
+      },
+      perf_results, counters.get());
   task_->PostProcessing();
+  perf_results->phases = task_->GetPhaseTimings();
+  perf_results->phases.validation = setup_phases.validation;
+  perf_results->phases.pre_processing = setup_phases.pre_processing;
 
   task_->Validation();
   task_->PreProcessing();
@@ -51,19 +239,93 @@ void ppc::core::Perf::TaskRun(const std::shared_ptr<PerfAttr>& perf_attr,
 }
 
 void ppc::core::Perf::CommonRun(const std::shared_ptr<PerfAttr>& perf_attr, const std::function<void()>& pipeline,
-                                const std::shared_ptr<ppc::core::PerfResults>& perf_results) {
+                                const std::shared_ptr<ppc::core::PerfResults>& perf_results,
+                                HardwareCounters* counters) const {
+  const auto& inputs_count = task_->GetData()->inputs_count;
+  perf_results->num_elements = perf_attr->num_elements;
+  if (perf_results->num_elements == 0 && !inputs_count.empty()) {
+    perf_results->num_elements = inputs_count[0];
+  }
+  perf_results->num_threads = ppc::util::GetPPCNumThreads();
+
+  if (perf_attr->measurement_mode == PerfAttr::MeasurementMode::kPerIteration) {
+    StatisticalRun(perf_attr, pipeline, perf_results, counters);
+    return;
+  }
+
   auto begin = perf_attr->current_timer();
   for (uint64_t i = 0; i < perf_attr->num_running; i++) {
     pipeline();
   }
   auto end = perf_attr->current_timer();
   perf_results->time_sec = end - begin;
+  perf_results->num_runs = perf_attr->num_running;
+
+  if (counters != nullptr) {
+    perf_results->counters = counters->GetResults(perf_attr->num_running, perf_results->num_elements);
+  }
 }
 
-void ppc::core::Perf::PrintPerfStatistic(const std::shared_ptr<PerfResults>& perf_results) {
-  std::string relative_path(::testing::UnitTest::GetInstance()->current_test_info()->file());
-  std::string ppc_regex_template("parallel_programming_course");
-  std::string perf_regex_template("perf_tests");
+void ppc::core::Perf::StatisticalRun(const std::shared_ptr<PerfAttr>& perf_attr, const std::function<void()>& pipeline,
+                                     const std::shared_ptr<ppc::core::PerfResults>& perf_results,
+                                     HardwareCounters* counters) const {
+  for (uint64_t i = 0; i < perf_attr->num_warmup; i++) {
+    pipeline();
+  }
+  task_->ResetPhaseTimings();
+  if (counters != nullptr) {
+    counters->Reset();
+  }
+
+  const bool adaptive = perf_attr->target_relative_error > 0.0;
+  const uint64_t min_running = adaptive ? std::max<uint64_t>(perf_attr->num_running, 2) : perf_attr->num_running;
+  const uint64_t max_running = adaptive ? std::max(perf_attr->max_running, min_running) : min_running;
+
+  auto& samples = perf_results->samples;
+  samples.clear();
+  samples.reserve(min_running);
+  uint64_t next_check = min_running;
+  double total_time = 0.0;
+  double max_sample = 0.0;
+  while (samples.size() < max_running) {
+    auto begin = perf_attr->current_timer();
+    pipeline();
+    auto end = perf_attr->current_timer();
+    samples.push_back(end - begin);
+    total_time += samples.back();
+    max_sample = std::max(max_sample, samples.back());
+
+    // Recomputing statistics sorts all samples, so check the stop criterion on a geometric schedule
+    if (adaptive && samples.size() >= next_check) {
+      auto stats = ComputePerfStatistics(samples, perf_attr->confidence_level);
+      if (stats.relative_error <= perf_attr->target_relative_error) {
+        break;
+      }
+      next_check = samples.size() + std::max<size_t>(1, samples.size() / 16);
+    }
+    // Extra runs must not push the total over the limit PrintPerfStatistic checks,
+    // so stop once the slowest run so far would no longer fit
+    if (adaptive && samples.size() >= min_running && total_time + max_sample >= PerfResults::kMaxTime) {
+      break;
+    }
+  }
+
+  perf_results->statistics = ComputePerfStatistics(samples, perf_attr->confidence_level);
+  perf_results->num_runs = samples.size();
+  perf_results->time_sec = total_time;
+
+  if (counters != nullptr) {
+    perf_results->counters = counters->GetResults(samples.size(), perf_results->num_elements);
+  }
+}
+
+void ppc::core::Perf::PrintPerfStatistic(const std::shared_ptr<PerfResults>& perf_results,
+                                         const std::source_location& location) {
+  PrintPerfStatistic(GetTestPath(location.file_name()), perf_results);
+}
+
+void ppc::core::Perf::PrintPerfStatistic(const std::string& task_path,
+                                         const std::shared_ptr<PerfResults>& perf_results) {
   std::string type_test_name;
 
   auto time_secs = perf_results->time_sec;
@@ -76,23 +338,159 @@ void ppc::core::Perf::PrintPerfStatistic(const std::shared_ptr<PerfResults>& per
     type_test_name = "none";
   }
 
-  auto first_found_position = relative_path.find(ppc_regex_template) + ppc_regex_template.length() + 1;
-  relative_path.erase(0, first_found_position);
-
-  auto last_found_position = relative_path.find(perf_regex_template) - 1;
-  relative_path.erase(last_found_position, relative_path.length() - 1);
-
   std::stringstream perf_res_str;
   if (time_secs < PerfResults::kMaxTime) {
+    const std::string output_path = ppc::util::GetEnvVar("PPC_PERF_OUTPUT");
+    if (!output_path.empty()) {
+      AppendPerfRecord(output_path, MakePerfRecord(task_path, *perf_results));
+    }
     perf_res_str << std::fixed << std::setprecision(10) << time_secs;
-    std::cout << relative_path << ":" << type_test_name << ":" << perf_res_str.str() << '\n';
+    std::cout << task_path << ":" << type_test_name << ":" << perf_res_str.str() << '\n';
+    if (!perf_results->samples.empty()) {
+      const auto& stats = perf_results->statistics;
+      std::cout << task_path << ":" << type_test_name << ":statistics: " << std::scientific << std::setprecision(4)
+                << "samples=" << stats.num_samples << " outliers=" << stats.num_outliers << " min=" << stats.min
+                << " median=" << stats.median << " p90=" << stats.p90 << " p99=" << stats.p99 << " mean=" << stats.mean
+                << " stddev=" << stats.stddev << " ci=[" << stats.ci_low << ", " << stats.ci_high << "]"
+                << " rel_err=" << stats.relative_error << '\n' << std::defaultfloat;
+    }
+    if (perf_results->counters.available) {
+      const auto& counters = perf_results->counters;
+      std::cout << task_path << ":" << type_test_name << ":counters: cycles=" << counters.cycles
+                << " instructions=" << counters.instructions << " ipc=" << counters.ipc
+                << " llc_misses=" << counters.llc_misses << " branch_misses=" << counters.branch_misses
+                << " dtlb_misses=" << counters.dtlb_misses
+                << " llc_misses_per_element=" << counters.llc_misses_per_element
+                << " branch_misses_per_element=" << counters.branch_misses_per_element
+                << " dtlb_misses_per_element=" << counters.dtlb_misses_per_element << '\n';
+    }
+    const auto& phases = perf_results->phases;
+    if (phases.validation + phases.pre_processing + phases.run + phases.post_processing > 0.0) {
+      std::cout << task_path << ":" << type_test_name << ":phases: " << std::fixed << std::setprecision(10)
+                << "validation=" << phases.validation << " pre_processing=" << phases.pre_processing
+                << " run=" << phases.run << " post_processing=" << phases.post_processing << '\n'
+                << std::defaultfloat;
+    }
   } else {
     std::stringstream err_msg;
     err_msg << '\n' << "Task execute time need to be: ";
     err_msg << "time < " << PerfResults::kMaxTime << " secs." << '\n';
     err_msg << "Original time in secs: " << time_secs << '\n';
     perf_res_str << std::fixed << std::setprecision(10) << -1.0;
-    std::cout << relative_path << ":" << type_test_name << ":" << perf_res_str.str() << '\n';
+    std::cout << task_path << ":" << type_test_name << ":" << perf_res_str.str() << '\n';
     throw std::runtime_error(err_msg.str().c_str());
   }
 }
+
+void ppc::core::ComputeScalingMetrics(const ScalingAttr& scaling_attr, ScalingResults& scaling_results) {
+  auto& points = scaling_results.points;
+  if (points.empty()) {
+    return;
+  }
+  auto find_point = [&points](uint64_t size, int num_threads) -> const ScalingPoint* {
+    auto it = std::ranges::find_if(
+        points, [&](const ScalingPoint& point) { return point.size == size && point.num_threads == num_threads; });
+    return it == points.end() ? nullptr : &*it;
+  };
+  const int min_threads = std::ranges::min_element(points, {}, &ScalingPoint::num_threads)->num_threads;
+  const int max_threads = std::ranges::max_element(points, {}, &ScalingPoint::num_threads)->num_threads;
+
+  for (auto& point : points) {
+    if (point.time_sec <= 0.0) {
+      continue;
+    }
+    const auto size = static_cast<double>(point.size);
+    point.elements_per_sec = size / point.time_sec;
+    point.gflops = scaling_attr.flops ? scaling_attr.flops(point.size) / point.time_sec * 1e-9 : 0.0;
+    point.bytes_per_sec = scaling_attr.bytes ? scaling_attr.bytes(point.size) / point.time_sec : 0.0;
+
+    const auto* strong_ref = find_point(point.size, min_threads);
+    if (strong_ref != nullptr) {
+      point.strong_efficiency = strong_ref->time_sec / point.time_sec * static_cast<double>(min_threads) /
+                                static_cast<double>(point.num_threads);
+      if (point.baseline_time_sec == 0.0) {
+        point.baseline_time_sec = strong_ref->time_sec;
+      }
+    }
+    point.speedup = point.baseline_time_sec / point.time_sec;
+
+    const uint64_t weak_size = point.size * static_cast<uint64_t>(min_threads);
+    if (weak_size % static_cast<uint64_t>(point.num_threads) == 0) {
+      const auto* weak_ref = find_point(weak_size / static_cast<uint64_t>(point.num_threads), min_threads);
+      point.weak_efficiency = weak_ref == nullptr ? 0.0 : weak_ref->time_sec / point.time_sec;
+    }
+  }
+
+  std::vector<const ScalingPoint*> largest;
+  for (const auto& point : points) {
+    if (point.num_threads == max_threads) {
+      largest.push_back(&point);
+    }
+  }
+  std::ranges::sort(largest, {}, &ScalingPoint::size);
+  scaling_results.crossover_size = 0;
+  for (auto it = largest.rbegin(); it != largest.rend() && (*it)->time_sec < (*it)->baseline_time_sec; ++it) {
+    scaling_results.crossover_size = (*it)->size;
+  }
+}
+
+void ppc::core::Perf::ScalingRun(const std::function<std::shared_ptr<Task>(uint64_t)>& generator,
+                                 const std::shared_ptr<PerfAttr>& perf_attr, const ScalingAttr& scaling_attr,
+                                 const std::shared_ptr<ScalingResults>& scaling_results) {
+  NumThreadsGuard guard;
+  std::vector<int> thread_counts = scaling_attr.num_threads;
+  if (thread_counts.empty()) {
+    thread_counts.push_back(ppc::util::GetPPCNumThreads());
+  }
+
+  scaling_results->points.clear();
+  for (const uint64_t size : scaling_attr.sizes) {
+    auto point_attr = std::make_shared<PerfAttr>(*perf_attr);
+    point_attr->num_elements = size;
+
+    double baseline_time = 0.0;
+    if (scaling_attr.baseline_generator) {
+      ppc::util::SetPPCNumThreads(1);
+      auto baseline_results = std::make_shared<PerfResults>();
+      Perf(scaling_attr.baseline_generator(size)).TaskRun(point_attr, baseline_results);
+      baseline_time = baseline_results->GetTimePerRun();
+    }
+
+    for (const int num_threads : thread_counts) {
+      ppc::util::SetPPCNumThreads(num_threads);
+      ScalingPoint point;
+      point.size = size;
+      point.num_threads = num_threads;
+      point.baseline_time_sec = baseline_time;
+      auto point_results = std::make_shared<PerfResults>();
+      Perf(generator(size)).TaskRun(point_attr, point_results);
+      point.results = *point_results;
+      point.time_sec = point.results.GetTimePerRun();
+      scaling_results->points.push_back(std::move(point));
+    }
+  }
+  ComputeScalingMetrics(scaling_attr, *scaling_results);
+}
+
+void ppc::core::Perf::PrintScalingStatistic(const std::shared_ptr<ScalingResults>& scaling_results,
+                                            const std::source_location& location) {
+  PrintScalingStatistic(GetTestPath(location.file_name()), scaling_results);
+}
+
+void ppc::core::Perf::PrintScalingStatistic(const std::string& task_path,
+                                            const std::shared_ptr<ScalingResults>& scaling_results) {
+  const std::string output_path = ppc::util::GetEnvVar("PPC_PERF_OUTPUT");
+  for (const auto& point : scaling_results->points) {
+    std::cout << task_path << ":scaling: size=" << point.size << " threads=" << point.num_threads
+              << std::scientific << std::setprecision(4) << " time=" << point.time_sec
+              << " elements_per_sec=" << point.elements_per_sec << " gflops=" << point.gflops
+              << " bytes_per_sec=" << point.bytes_per_sec << " speedup=" << point.speedup
+              << " strong_efficiency=" << point.strong_efficiency << " weak_efficiency=" << point.weak_efficiency
+              << '\n'
+              << std::defaultfloat;
+    if (!output_path.empty()) {
+      AppendPerfRecord(output_path, MakePerfRecord(task_path, point.results));
+    }
+  }
+  std::cout << task_path << ":scaling: crossover_size=" << scaling_results->crossover_size << '\n';
+}
@@ -0,0 +1,292 @@
+#include "core/perf/include/report.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "core/perf/include/perf.hpp"
+#include "core/util/include/topology.hpp"
+
+#ifdef __unix__
+#include <sys/utsname.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+std::string GetCpuModel() {
+  std::ifstream cpuinfo("/proc/cpuinfo");
+  std::string line;
+  while (std::getline(cpuinfo, line)) {
+    if (line.starts_with("model name")) {
+      const auto colon = line.find(':');
+      if (colon != std::string::npos) {
+        const auto begin = line.find_first_not_of(' ', colon + 1);
+        return begin == std::string::npos ? std::string() : line.substr(begin);
+      }
+    }
+  }
+  return {};
+}
+
+std::string GetCompiler() {
+#if defined(__clang__)
+  return "clang " __clang_version__;
+#elif defined(__GNUC__)
+  return "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+  return "msvc " + std::to_string(_MSC_FULL_VER);
+#else
+  return "unknown";
+#endif
+}
+
+std::string GetCurrentTimestamp() {
+  const auto now = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
+  std::tm utc{};
+#ifdef _WIN32
+  gmtime_s(&utc, &now);
+#else
+  gmtime_r(&now, &utc);
+#endif
+  std::ostringstream out;
+  out << std::put_time(&utc, "%Y-%m-%dT%H:%M:%SZ");
+  return out.str();
+}
+
+std::string GetTypeOfRunningName(ppc::core::PerfResults::TypeOfRunning type_of_running) {
+  switch (type_of_running) {
+    case ppc::core::PerfResults::TypeOfRunning::kPipeline:
+      return "pipeline";
+    case ppc::core::PerfResults::TypeOfRunning::kTaskRun:
+      return "task_run";
+    case ppc::core::PerfResults::TypeOfRunning::kNone:
+      break;
+  }
+  return "none";
+}
+
+// Shortest representation that reads back to the same double, NaN and
+// infinities are not representable in JSON
+std::string FormatNumber(double value, bool json) {
+  if (!std::isfinite(value)) {
+    return json ? "null" : "";
+  }
+  std::ostringstream out;
+  out << std::setprecision(std::numeric_limits<double>::max_digits10) << value;
+  return out.str();
+}
+
+std::string JsonString(const std::string& value) {
+  std::ostringstream out;
+  out << '"';
+  for (const char c : value) {
+    switch (c) {
+      case '"':
+        out << "\\\"";
+        break;
+      case '\\':
+        out << "\\\\";
+        break;
+      case '\n':
+        out << "\\n";
+        break;
+      case '\r':
+        out << "\\r";
+        break;
+      case '\t':
+        out << "\\t";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          out << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c) << std::dec
+              << std::setfill(' ');
+        } else {
+          out << c;
+        }
+    }
+  }
+  out << '"';
+  return out.str();
+}
+
+std::string CsvString(const std::string& value) {
+  if (value.find_first_of(",\"\n\r") == std::string::npos) {
+    return value;
+  }
+  std::string quoted = "\"";
+  for (const char c : value) {
+    if (c == '"') {
+      quoted += '"';
+    }
+    quoted += c;
+  }
+  return quoted + '"';
+}
+
+}  // namespace
+
+ppc::core::HostInfo ppc::core::GetHostInfo() {
+  HostInfo host;
+  const auto& topology = ppc::util::GetTopology();
+  host.num_logical_cpus = static_cast<int>(topology.cpus.size());
+  host.num_physical_cores = topology.num_physical_cores;
+  host.num_numa_nodes = topology.num_numa_nodes;
+  host.cpu_model = GetCpuModel();
+  host.compiler = GetCompiler();
+#ifdef __unix__
+  std::vector<char> hostname(256, '\0');
+  if (gethostname(hostname.data(), hostname.size() - 1) == 0) {
+    host.hostname = hostname.data();
+  }
+  utsname name{};
+  if (uname(&name) == 0) {
+    host.os = std::string(name.sysname) + " " + name.release;
+  }
+#elif defined(_WIN32)
+  host.os = "Windows";
+#elif defined(__APPLE__)
+  host.os = "macOS";
+#endif
+  return host;
+}
+
+ppc::core::PerfRecord ppc::core::MakePerfRecord(const std::string& task_path, const PerfResults& results) {
+  PerfRecord record;
+  std::vector<std::string> parts;
+  std::string part;
+  for (const char c : task_path) {
+    if (c == '/' || c == '\\') {
+      if (!part.empty()) {
+        parts.push_back(part);
+      }
+      part.clear();
+    } else {
+      part += c;
+    }
+  }
+  if (!part.empty()) {
+    parts.push_back(part);
+  }
+  if (parts.size() >= 3 && parts[parts.size() - 3] == "tasks") {
+    record.backend = parts[parts.size() - 2];
+    record.task_id = parts.back();
+  } else {
+    record.task_id = task_path;
+  }
+  record.type_of_running = GetTypeOfRunningName(results.type_of_running);
+  record.timestamp = GetCurrentTimestamp();
+  record.results = results;
+  record.host = GetHostInfo();
+  return record;
+}
+
+std::string ppc::core::ToJsonLine(const PerfRecord& record) {
+  const auto& results = record.results;
+  const auto& stats = results.statistics;
+  const auto& counters = results.counters;
+  const auto& phases = results.phases;
+  const auto& host = record.host;
+  auto num = [](double value) { return FormatNumber(value, true); };
+
+  std::ostringstream out;
+  out << "{\"task_id\":" << JsonString(record.task_id) << ",\"backend\":" << JsonString(record.backend)
+      << ",\"type_of_running\":" << JsonString(record.type_of_running)
+      << ",\"timestamp\":" << JsonString(record.timestamp) << ",\"num_elements\":" << results.num_elements
+      << ",\"num_threads\":" << results.num_threads << ",\"num_runs\":" << results.num_runs
+      << ",\"time_sec\":" << num(results.time_sec) << ",\"samples\":[";
+  for (size_t i = 0; i < results.samples.size(); i++) {
+    out << (i == 0 ? "" : ",") << num(results.samples[i]);
+  }
+  out << "],\"statistics\":{\"num_samples\":" << stats.num_samples << ",\"num_outliers\":" << stats.num_outliers
+      << ",\"min\":" << num(stats.min) << ",\"median\":" << num(stats.median) << ",\"p90\":" << num(stats.p90)
+      << ",\"p99\":" << num(stats.p99) << ",\"max\":" << num(stats.max) << ",\"mean\":" << num(stats.mean)
+      << ",\"stddev\":" << num(stats.stddev) << ",\"ci_low\":" << num(stats.ci_low)
+      << ",\"ci_high\":" << num(stats.ci_high) << ",\"relative_error\":" << num(stats.relative_error) << "}";
+  out << ",\"counters\":{\"available\":" << (counters.available ? "true" : "false")
+      << ",\"cycles\":" << counters.cycles << ",\"instructions\":" << counters.instructions
+      << ",\"llc_misses\":" << counters.llc_misses << ",\"branch_misses\":" << counters.branch_misses
+      << ",\"dtlb_misses\":" << counters.dtlb_misses << ",\"ipc\":" << num(counters.ipc)
+      << ",\"llc_misses_per_element\":" << num(counters.llc_misses_per_element)
+      << ",\"branch_misses_per_element\":" << num(counters.branch_misses_per_element)
+      << ",\"dtlb_misses_per_element\":" << num(counters.dtlb_misses_per_element) << "}";
+  out << ",\"phases\":{\"validation\":" << num(phases.validation)
+      << ",\"pre_processing\":" << num(phases.pre_processing) << ",\"run\":" << num(phases.run)
+      << ",\"post_processing\":" << num(phases.post_processing) << "}";
+  out << ",\"host\":{\"hostname\":" << JsonString(host.hostname) << ",\"cpu_model\":" << JsonString(host.cpu_model)
+      << ",\"os\":" << JsonString(host.os) << ",\"compiler\":" << JsonString(host.compiler)
+      << ",\"num_logical_cpus\":" << host.num_logical_cpus << ",\"num_physical_cores\":" << host.num_physical_cores
+      << ",\"num_numa_nodes\":" << host.num_numa_nodes << "}}";
+  return out.str();
+}
+
+std::string ppc::core::GetCsvHeader() {
+  return "task_id,backend,type_of_running,timestamp,num_elements,num_threads,num_runs,time_sec,"
+         "mean,stddev,median,min,max,ci_low,ci_high,num_outliers,"
+         "cycles,instructions,llc_misses,branch_misses,dtlb_misses,ipc,"
+         "llc_misses_per_element,branch_misses_per_element,dtlb_misses_per_element,"
+         "validation,pre_processing,run,post_processing,"
+         "hostname,cpu_model,os,compiler,num_logical_cpus,num_physical_cores,num_numa_nodes,samples";
+}
+
+std::string ppc::core::ToCsvRow(const PerfRecord& record) {
+  const auto& results = record.results;
+  const auto& stats = results.statistics;
+  const auto& counters = results.counters;
+  const auto& phases = results.phases;
+  const auto& host = record.host;
+  auto num = [](double value) { return FormatNumber(value, false); };
+
+  std::ostringstream out;
+  out << CsvString(record.task_id) << ',' << CsvString(record.backend) << ',' << record.type_of_running << ','
+      << record.timestamp << ',' << results.num_elements << ',' << results.num_threads << ',' << results.num_runs
+      << ',' << num(results.time_sec) << ',';
+  if (results.samples.empty()) {
+    out << ",,,,,,,,";
+  } else {
+    out << num(stats.mean) << ',' << num(stats.stddev) << ',' << num(stats.median) << ',' << num(stats.min) << ','
+        << num(stats.max) << ',' << num(stats.ci_low) << ',' << num(stats.ci_high) << ',' << stats.num_outliers
+        << ',';
+  }
+  if (counters.available) {
+    out << counters.cycles << ',' << counters.instructions << ',' << counters.llc_misses << ','
+        << counters.branch_misses << ',' << counters.dtlb_misses << ',' << num(counters.ipc) << ','
+        << num(counters.llc_misses_per_element) << ',' << num(counters.branch_misses_per_element) << ','
+        << num(counters.dtlb_misses_per_element) << ',';
+  } else {
+    out << ",,,,,,,,,";
+  }
+  out << num(phases.validation) << ',' << num(phases.pre_processing) << ',' << num(phases.run) << ','
+      << num(phases.post_processing) << ',' << CsvString(host.hostname) << ',' << CsvString(host.cpu_model) << ','
+      << CsvString(host.os) << ',' << CsvString(host.compiler) << ',' << host.num_logical_cpus << ','
+      << host.num_physical_cores << ',' << host.num_numa_nodes << ',';
+  for (size_t i = 0; i < results.samples.size(); i++) {
+    out << (i == 0 ? "" : ";") << num(results.samples[i]);
+  }
+  return out.str();
+}
+
+void ppc::core::AppendPerfRecord(const std::string& file_path, const PerfRecord& record) {
+  const bool csv = file_path.ends_with(".csv");
+  bool empty = true;
+  {
+    std::ifstream existing(file_path, std::ios::binary | std::ios::ate);
+    empty = !existing.is_open() || existing.tellg() <= 0;
+  }
+  std::ofstream out(file_path, std::ios::app);
+  if (!out.is_open()) {
+    throw std::runtime_error("Failed to open perf output file: " + file_path);
+  }
+  if (csv && empty) {
+    out << GetCsvHeader() << '\n';
+  }
+  out << (csv ? ToCsvRow(record) : ToJsonLine(record)) << '\n';
+}
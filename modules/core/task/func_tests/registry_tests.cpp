@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "core/task/func_tests/test_task.hpp"
+#include "core/task/include/registry.hpp"
+#include "core/task/include/task.hpp"
+
+namespace {
+
+ppc::core::TaskInput GenerateSumInput(uint64_t size) {
+  return ppc::core::MakeVectorInput<int32_t>(
+      std::vector<int32_t>(size, 1), 1, [](const std::vector<int32_t> &input, const std::vector<int32_t> &output) {
+        return output[0] == std::accumulate(input.begin(), input.end(), 0);
+      });
+}
+
+ppc::core::TaskInput LoadSumInput(const std::string &path) {
+  auto input = ppc::core::ReadVectorFile<int32_t>(path);
+  const auto expected = std::accumulate(input.begin(), input.end(), 0);
+  return ppc::core::MakeVectorInput<int32_t>(
+      std::move(input), 1,
+      [expected](const std::vector<int32_t> &, const std::vector<int32_t> &output) { return output[0] == expected; });
+}
+
+}  // namespace
+
+PPC_REGISTER_TASK(ppc::test::task::TestTask<int32_t>, "registry_test_sum", "seq", GenerateSumInput, LoadSumInput);
+
+TEST(registry_tests, check_registered_task_runs) {
+  const auto *registration = ppc::core::TaskRegistry::Instance().Find("registry_test_sum", "seq");
+  ASSERT_NE(registration, nullptr);
+  EXPECT_EQ(ppc::core::TaskRegistry::Instance().Find("registry_test_sum", "omp"), nullptr);
+
+  auto input = registration->generate(100);
+  auto task = registration->make_task(input.task_data);
+  ASSERT_TRUE(task->Validation());
+  task->PreProcessing();
+  task->Run();
+  task->PostProcessing();
+  ASSERT_TRUE(input.check);
+  EXPECT_TRUE(input.check());
+}
+
+TEST(registry_tests, check_registered_task_loads_file) {
+  const auto path = (std::filesystem::temp_directory_path() / "ppc_registry_tests.txt").string();
+  {
+    std::ofstream file(path);
+    file << "1 2 3\n4\n";
+  }
+  const auto *registration = ppc::core::TaskRegistry::Instance().Find("registry_test_sum", "seq");
+  ASSERT_NE(registration, nullptr);
+  ASSERT_TRUE(registration->load);
+
+  auto input = registration->load(path);
+  EXPECT_EQ(input.task_data->inputs_count[0], 4U);
+  auto task = registration->make_task(input.task_data);
+  ASSERT_TRUE(task->Validation());
+  task->PreProcessing();
+  task->Run();
+  task->PostProcessing();
+  EXPECT_TRUE(input.check());
+  std::filesystem::remove(path);
+}
+
+TEST(registry_tests, check_duplicate_registration_throws) {
+  EXPECT_THROW(ppc::core::TaskRegistry::Instance().Register(ppc::core::MakeTaskRegistration<
+                                                             ppc::test::task::TestTask<int32_t>>(
+                   "registry_test_sum", "seq", GenerateSumInput)),
+               std::invalid_argument);
+}
+
+TEST(registry_tests, check_list_is_sorted) {
+  const auto list = ppc::core::TaskRegistry::Instance().List();
+  ASSERT_FALSE(list.empty());
+  for (size_t i = 1; i < list.size(); i++) {
+    EXPECT_LE(list[i - 1]->name, list[i]->name);
+  }
+}
+
+TEST(registry_tests, check_identity_square_input) {
+  auto input = ppc::core::MakeIdentitySquareInput(17);
+  ASSERT_EQ(input.task_data->inputs_count[0], 16U);
+  ASSERT_EQ(input.task_data->outputs_count[0], 16U);
+  const auto *matrix = reinterpret_cast<int *>(input.task_data->inputs[0]);
+  for (size_t i = 0; i < 16; i++) {
+    EXPECT_EQ(matrix[i], i % 5 == 0 ? 1 : 0);
+  }
+  EXPECT_FALSE(input.check());
+  std::copy(matrix, matrix + 16, reinterpret_cast<int *>(input.task_data->outputs[0]));
+  EXPECT_TRUE(input.check());
+}
+
+TEST(registry_tests, check_read_vector_file_errors) {
+  EXPECT_THROW(ppc::core::ReadVectorFile<int32_t>("/nonexistent/ppc_input.txt"), std::runtime_error);
+}
@@ -3,6 +3,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <stdexcept>
 #include <vector>
 
 #include "core/task/func_tests/test_task.hpp"
@@ -178,6 +179,100 @@ TEST(task_tests, check_wrong_order) {
   ASSERT_ANY_THROW(test_task.PostProcessing());
 }
 
+TEST(task_tests, check_phase_timings) {
+  // Create data
+  std::vector<int32_t> in(20, 1);
+  std::vector<int32_t> out(1, 0);
+
+  // Create task_data
+  auto task_data = std::make_shared<ppc::core::TaskData>();
+  task_data->inputs.emplace_back(reinterpret_cast<uint8_t *>(in.data()));
+  task_data->inputs_count.emplace_back(in.size());
+  task_data->outputs.emplace_back(reinterpret_cast<uint8_t *>(out.data()));
+  task_data->outputs_count.emplace_back(out.size());
+
+  // Create Task
+  ppc::test::task::FakeShortRunTask<int32_t> test_task(task_data);
+  ASSERT_TRUE(test_task.Validation());
+  test_task.PreProcessing();
+  test_task.Run();
+  test_task.PostProcessing();
+
+  const auto &timings = test_task.GetPhaseTimings();
+  EXPECT_GE(timings.run, 0.02);
+  EXPECT_GE(timings.validation, 0.0);
+  EXPECT_GE(timings.pre_processing, 0.0);
+  EXPECT_GE(timings.post_processing, 0.0);
+  EXPECT_LT(timings.validation + timings.pre_processing + timings.post_processing, timings.run);
+
+  test_task.ResetPhaseTimings();
+  EXPECT_EQ(test_task.GetPhaseTimings().run, 0.0);
+  ASSERT_EQ(static_cast<size_t>(out[0]), in.size());
+}
+
+TEST(task_tests, check_typed_views) {
+  // Create data
+  std::vector<double> in(20, 1.0);
+  std::vector<double> out(20, 0.0);
+
+  // Create task_data
+  auto task_data = std::make_shared<ppc::core::TaskData>();
+  task_data->AddInput(in.data(), in.size());
+  task_data->AddOutput(out.data(), out.size());
+
+  auto input = task_data->GetInput<double>(0);
+  auto output = task_data->GetOutput<double>(0);
+  ASSERT_EQ(input.size(), in.size());
+  ASSERT_EQ(output.size(), out.size());
+  EXPECT_EQ(input.data(), in.data());
+  output[3] = 5.0;
+  EXPECT_EQ(out[3], 5.0);
+  EXPECT_EQ(task_data->inputs_desc[0].element_size, sizeof(double));
+  EXPECT_FALSE(task_data->IsInPlace());
+
+  EXPECT_THROW((void)task_data->GetInput<int32_t>(0), std::invalid_argument);
+  EXPECT_THROW((void)task_data->GetMutableInput<double>(0), std::invalid_argument);
+  EXPECT_THROW((void)task_data->GetInput<double>(1), std::out_of_range);
+  EXPECT_THROW((void)task_data->GetOutput<double>(1), std::out_of_range);
+}
+
+TEST(task_tests, check_typed_views_raw_buffers) {
+  // Create data
+  std::vector<int32_t> data(21, 1);
+
+  // Create task_data sharing one buffer for input and output
+  auto task_data = std::make_shared<ppc::core::TaskData>();
+  task_data->inputs.emplace_back(reinterpret_cast<uint8_t *>(data.data()));
+  task_data->inputs_count.emplace_back(data.size());
+  task_data->outputs.emplace_back(reinterpret_cast<uint8_t *>(data.data()));
+  task_data->outputs_count.emplace_back(data.size());
+
+  EXPECT_TRUE(task_data->IsInPlace());
+  EXPECT_EQ(task_data->GetInput<int32_t>(0).size(), data.size());
+  EXPECT_THROW((void)task_data->GetMutableInput<int32_t>(0), std::invalid_argument);
+
+  // Misaligned view over raw bytes
+  task_data->inputs[0] = reinterpret_cast<uint8_t *>(data.data()) + 1;
+  task_data->inputs_count[0] = 4;
+  EXPECT_THROW((void)task_data->GetInput<int32_t>(0), std::invalid_argument);
+  EXPECT_EQ(task_data->GetInput<uint8_t>(0).size(), 4U);
+}
+
+TEST(task_tests, check_typed_views_writable_input) {
+  // Create data
+  std::vector<float> data(8, 2.0F);
+  std::vector<float> out(1, 0.0F);
+
+  // Create task_data
+  auto task_data = std::make_shared<ppc::core::TaskData>();
+  task_data->AddInput(data.data(), data.size(), true);
+  task_data->AddOutput(out.data(), out.size());
+
+  auto input = task_data->GetMutableInput<float>(0);
+  input[0] = 3.0F;
+  EXPECT_EQ(data[0], 3.0F);
+}
+
 int main(int argc, char **argv) {
   testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
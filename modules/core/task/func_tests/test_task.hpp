@@ -46,4 +46,15 @@ class FakeSlowTask : public TestTask<T> {
   }
 };
 
+template <class T>
+class FakeShortRunTask : public TestTask<T> {
+ public:
+  explicit FakeShortRunTask(ppc::core::TaskDataPtr perf_task_data) : TestTask<T>(perf_task_data) {}
+
+  bool RunImpl() override {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    return TestTask<T>::RunImpl();
+  }
+};
+
 }  // namespace ppc::test::task
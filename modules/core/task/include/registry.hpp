@@ -0,0 +1,191 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "core/task/include/task.hpp"
+#include "core/util/include/sort_inputs.hpp"
+
+namespace ppc::core {
+
+// Task data of a registered task together with the memory its buffers point to
+struct TaskInput {
+  TaskDataPtr task_data;
+  std::shared_ptr<void> storage;
+  // check of the outputs after the run, not set if the task has none
+  std::function<bool()> check;
+};
+
+struct TaskRegistration {
+  // task directory name and backend ("seq", "omp", "tbb", "stl", ...)
+  std::string name;
+  std::string backend;
+  std::function<std::shared_ptr<Task>(const TaskDataPtr &)> make_task;
+  // input of about size elements
+  std::function<TaskInput(uint64_t size)> generate;
+  // input read from a file, not set if the task cannot load files
+  std::function<TaskInput(const std::string &path)> load;
+  // input of size elements drawn from a distribution, set for sorting tasks only
+  std::function<TaskInput(ppc::util::SortDistribution distribution, uint64_t size)> generate_sort;
+};
+
+// Process-wide list of tasks that can be run by name outside of tests
+class TaskRegistry {
+ public:
+  static TaskRegistry &Instance();
+
+  // throws std::invalid_argument if the name and backend are registered already
+  void Register(TaskRegistration registration);
+  // nullptr if there is no such task
+  [[nodiscard]] const TaskRegistration *Find(const std::string &name, const std::string &backend) const;
+  // registrations sorted by name and backend
+  [[nodiscard]] std::vector<const TaskRegistration *> List() const;
+
+ private:
+  std::vector<std::unique_ptr<TaskRegistration>> registrations_;
+};
+
+// Registers a task during static initialization, see PPC_REGISTER_TASK
+class TaskRegistrar {
+ public:
+  explicit TaskRegistrar(TaskRegistration registration);
+};
+
+// Input of one vector and one output vector of output_size elements; check
+// gets both vectors after the run
+template <typename In, typename Out = In>
+TaskInput MakeVectorInput(
+    std::vector<In> input, std::size_t output_size,
+    std::type_identity_t<std::function<bool(const std::vector<In> &, const std::vector<Out> &)>> check = nullptr) {
+  struct Storage {
+    std::vector<In> input;
+    std::vector<Out> output;
+  };
+  auto storage = std::make_shared<Storage>(Storage{std::move(input), std::vector<Out>(output_size)});
+  TaskInput task_input;
+  task_input.task_data = std::make_shared<TaskData>();
+  task_input.task_data->AddInput(storage->input.data(), storage->input.size());
+  task_input.task_data->AddOutput(storage->output.data(), storage->output.size());
+  if (check) {
+    task_input.check = [storage, check = std::move(check)] { return check(storage->input, storage->output); };
+  }
+  task_input.storage = storage;
+  return task_input;
+}
+
+// True if out is a permutation of in (compared bit for bit) in ascending
+// order. NaNs may stand anywhere, the other values must not decrease; -0.0
+// and 0.0 compare equal for the order but are kept apart as elements.
+template <typename T>
+bool IsSortedPermutation(const std::vector<T> &in, const std::vector<T> &out) {
+  const auto strong_less = [](const T &a, const T &b) { return std::strong_order(a, b) < 0; };
+  const auto strong_equal = [](const T &a, const T &b) { return std::strong_order(a, b) == 0; };
+  std::vector<T> expected = in;
+  std::vector<T> actual = out;
+  std::ranges::sort(expected, strong_less);
+  std::ranges::sort(actual, strong_less);
+  if (!std::ranges::equal(expected, actual, strong_equal)) {
+    return false;
+  }
+  const T *previous = nullptr;
+  for (const T &value : out) {
+    if constexpr (std::is_floating_point_v<T>) {
+      if (std::isnan(value)) {
+        continue;
+      }
+    }
+    if (previous != nullptr && value < *previous) {
+      return false;
+    }
+    previous = &value;
+  }
+  return true;
+}
+
+// Input of a sorting task: the output must be the sorted permutation of the input
+template <typename T>
+TaskInput MakeSortInput(std::vector<T> input) {
+  const std::size_t size = input.size();
+  return MakeVectorInput<T>(std::move(input), size, IsSortedPermutation<T>);
+}
+
+// Input of a task squaring a row-major int matrix (the example tasks): the
+// identity matrix of about size elements, its square is the same matrix
+TaskInput MakeIdentitySquareInput(uint64_t size);
+
+// Whitespace separated values of a text file
+template <typename T>
+std::vector<T> ReadVectorFile(const std::string &path) {
+  std::ifstream file(path);
+  if (!file.is_open()) {
+    throw std::runtime_error("Failed to open input file: " + path);
+  }
+  std::vector<T> values;
+  T value{};
+  while (file >> value) {
+    values.push_back(value);
+  }
+  if (!file.eof()) {
+    throw std::runtime_error("Failed to parse input file: " + path);
+  }
+  return values;
+}
+
+// Registration of TaskType created with std::make_shared<TaskType>(task_data)
+template <typename TaskType>
+TaskRegistration MakeTaskRegistration(std::string name, std::string backend,
+                                      std::function<TaskInput(uint64_t)> generate,
+                                      std::function<TaskInput(const std::string &)> load = nullptr) {
+  TaskRegistration registration;
+  registration.name = std::move(name);
+  registration.backend = std::move(backend);
+  registration.make_task = [](const TaskDataPtr &task_data) { return std::make_shared<TaskType>(task_data); };
+  registration.generate = std::move(generate);
+  registration.load = std::move(load);
+  return registration;
+}
+
+// Registration of a task sorting a vector of T into an output vector of the
+// same size: uniform generated inputs, inputs of every SortDistribution and
+// files of whitespace separated values
+template <typename TaskType, typename T>
+TaskRegistration MakeSortTaskRegistration(std::string name, std::string backend) {
+  auto registration = MakeTaskRegistration<TaskType>(
+      std::move(name), std::move(backend),
+      [](uint64_t size) {
+        return MakeSortInput(ppc::util::GenerateSortData<T>(ppc::util::SortDistribution::kUniform, size, size));
+      },
+      [](const std::string &path) { return MakeSortInput(ReadVectorFile<T>(path)); });
+  registration.generate_sort = [](ppc::util::SortDistribution distribution, uint64_t size) {
+    return MakeSortInput(ppc::util::GenerateSortData<T>(distribution, size, size));
+  };
+  return registration;
+}
+
+}  // namespace ppc::core
+
+#define PPC_REGISTRAR_CONCAT_IMPL(a, b) a##b
+#define PPC_REGISTRAR_CONCAT(a, b) PPC_REGISTRAR_CONCAT_IMPL(a, b)
+
+// Register TaskType under name and backend with a generator of inputs
+// (TaskInput(uint64_t size)) and optionally a file loader (TaskInput(const std::string &path)),
+// use at namespace scope of a source file of the task library
+#define PPC_REGISTER_TASK(TaskType, name, backend, ...)                                 \
+  static const ::ppc::core::TaskRegistrar PPC_REGISTRAR_CONCAT(ppc_task_registrar_, __LINE__)( \
+      ::ppc::core::MakeTaskRegistration<TaskType>(name, backend, __VA_ARGS__))
+
+// Register TaskType sorting a vector of T (int32_t or double), see MakeSortTaskRegistration
+#define PPC_REGISTER_SORT_TASK(TaskType, name, backend, T)                                     \
+  static const ::ppc::core::TaskRegistrar PPC_REGISTRAR_CONCAT(ppc_task_registrar_, __LINE__)( \
+      ::ppc::core::MakeSortTaskRegistration<TaskType, T>(name, backend))
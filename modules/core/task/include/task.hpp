@@ -1,23 +1,73 @@
 #pragma once
 
 #include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <span>
+#include <stdexcept>
 #include <string>
+#include <type_traits>
 #include <vector>
 
 namespace ppc::core {
 
+// Element type and access rights of one input or output buffer
+struct BufferDesc {
+  std::size_t element_size = 0;
+  std::size_t alignment = 1;
+  bool writable = false;
+};
+
 struct TaskData {
   std::vector<uint8_t *> inputs;
   std::vector<std::uint32_t> inputs_count;
   std::vector<uint8_t *> outputs;
   std::vector<std::uint32_t> outputs_count;
   enum StateOfTesting : uint8_t { kFunc, kPerf } state_of_testing;
+  // optional descriptions of buffers, filled by AddInput() and AddOutput();
+  // buffers pushed to inputs/outputs directly are described by nothing
+  std::vector<BufferDesc> inputs_desc{};
+  std::vector<BufferDesc> outputs_desc{};
+
+  // add typed input buffer of count elements, writable inputs may be modified by the task
+  template <typename T>
+  void AddInput(T *data, std::size_t count, bool writable = false);
+
+  // add typed output buffer of count elements
+  template <typename T>
+  void AddOutput(T *data, std::size_t count);
+
+  // read-only view over the input buffer without copying
+  template <typename T>
+  [[nodiscard]] std::span<const T> GetInput(std::size_t index) const;
+
+  // writable view over the input buffer, the buffer must be added as writable
+  template <typename T>
+  [[nodiscard]] std::span<T> GetMutableInput(std::size_t index) const;
+
+  // writable view over the output buffer without copying
+  template <typename T>
+  [[nodiscard]] std::span<T> GetOutput(std::size_t index) const;
+
+  // true if the task may work in place: the input and the output share memory
+  [[nodiscard]] bool IsInPlace(std::size_t input_index = 0, std::size_t output_index = 0) const;
+
+ private:
+  template <typename T>
+  static std::span<T> MakeView(uint8_t *data, std::uint32_t count, const BufferDesc *desc, const char *kind);
 };
 
 using TaskDataPtr = std::shared_ptr<ppc::core::TaskData>;
 
+// Accumulated wall-clock time of every phase of the task (in seconds)
+struct PhaseTimings {
+  double validation = 0.0;
+  double pre_processing = 0.0;
+  double run = 0.0;
+  double post_processing = 0.0;
+};
+
 // Memory of inputs and outputs need to be initialized before create object of
 // Task class
 class Task {
@@ -42,6 +92,12 @@ class Task {
   // get input and output data
   [[nodiscard]] TaskDataPtr GetData() const;
 
+  // get time spent in every phase since creation or last reset
+  [[nodiscard]] const PhaseTimings &GetPhaseTimings() const;
+
+  // reset time spent in every phase
+  void ResetPhaseTimings();
+
   virtual ~Task();
 
  protected:
@@ -65,6 +121,73 @@ class Task {
   std::vector<std::string> right_functions_order_ = {"Validation", "PreProcessing", "Run", "PostProcessing"};
   const double max_test_time_ = 1.0;
   std::chrono::high_resolution_clock::time_point tmp_time_point_;
+  PhaseTimings phase_timings_;
+
+  template <typename Impl>
+  bool TimePhase(double &phase_time, Impl impl);
 };
 
+template <typename T>
+void TaskData::AddInput(T *data, std::size_t count, bool writable) {
+  inputs_desc.resize(inputs.size());
+  inputs.emplace_back(reinterpret_cast<uint8_t *>(const_cast<std::remove_const_t<T> *>(data)));
+  inputs_count.emplace_back(static_cast<std::uint32_t>(count));
+  inputs_desc.push_back({.element_size = sizeof(T), .alignment = alignof(T), .writable = writable});
+}
+
+template <typename T>
+void TaskData::AddOutput(T *data, std::size_t count) {
+  outputs_desc.resize(outputs.size());
+  outputs.emplace_back(reinterpret_cast<uint8_t *>(data));
+  outputs_count.emplace_back(static_cast<std::uint32_t>(count));
+  outputs_desc.push_back({.element_size = sizeof(T), .alignment = alignof(T), .writable = true});
+}
+
+template <typename T>
+std::span<const T> TaskData::GetInput(std::size_t index) const {
+  if (index >= inputs.size() || index >= inputs_count.size()) {
+    throw std::out_of_range("TaskData: no input with index " + std::to_string(index));
+  }
+  const BufferDesc *desc = index < inputs_desc.size() ? &inputs_desc[index] : nullptr;
+  return MakeView<const T>(inputs[index], inputs_count[index], desc, "input");
+}
+
+template <typename T>
+std::span<T> TaskData::GetMutableInput(std::size_t index) const {
+  if (index >= inputs.size() || index >= inputs_count.size()) {
+    throw std::out_of_range("TaskData: no input with index " + std::to_string(index));
+  }
+  if (index >= inputs_desc.size() || !inputs_desc[index].writable) {
+    throw std::invalid_argument("TaskData: input " + std::to_string(index) + " is read-only");
+  }
+  return MakeView<T>(inputs[index], inputs_count[index], &inputs_desc[index], "input");
+}
+
+template <typename T>
+std::span<T> TaskData::GetOutput(std::size_t index) const {
+  if (index >= outputs.size() || index >= outputs_count.size()) {
+    throw std::out_of_range("TaskData: no output with index " + std::to_string(index));
+  }
+  const BufferDesc *desc = index < outputs_desc.size() ? &outputs_desc[index] : nullptr;
+  return MakeView<T>(outputs[index], outputs_count[index], desc, "output");
+}
+
+template <typename T>
+std::span<T> TaskData::MakeView(uint8_t *data, std::uint32_t count, const BufferDesc *desc, const char *kind) {
+  if (desc != nullptr && desc->element_size != 0 && desc->element_size != sizeof(T)) {
+    throw std::invalid_argument(std::string("TaskData: ") + kind + " element size is " +
+                                std::to_string(desc->element_size) + ", requested " + std::to_string(sizeof(T)));
+  }
+  if (count == 0) {
+    return {};
+  }
+  if (data == nullptr) {
+    throw std::invalid_argument(std::string("TaskData: ") + kind + " buffer is null");
+  }
+  if (reinterpret_cast<std::uintptr_t>(data) % alignof(T) != 0) {
+    throw std::invalid_argument(std::string("TaskData: ") + kind + " buffer is misaligned");
+  }
+  return {reinterpret_cast<T *>(data), count};
+}
+
 }  // namespace ppc::core
@@ -0,0 +1,63 @@
+#include "core/task/include/registry.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+ppc::core::TaskRegistry &ppc::core::TaskRegistry::Instance() {
+  static TaskRegistry registry;
+  return registry;
+}
+
+void ppc::core::TaskRegistry::Register(TaskRegistration registration) {
+  if (Find(registration.name, registration.backend) != nullptr) {
+    throw std::invalid_argument("Task " + registration.name + " (" + registration.backend +
+                                ") is registered already");
+  }
+  if (!registration.make_task || !registration.generate) {
+    throw std::invalid_argument("Task " + registration.name + " (" + registration.backend +
+                                ") needs a factory and a generator");
+  }
+  registrations_.emplace_back(std::make_unique<TaskRegistration>(std::move(registration)));
+}
+
+const ppc::core::TaskRegistration *ppc::core::TaskRegistry::Find(const std::string &name,
+                                                                 const std::string &backend) const {
+  auto it = std::ranges::find_if(registrations_, [&](const auto &registration) {
+    return registration->name == name && registration->backend == backend;
+  });
+  return it == registrations_.end() ? nullptr : it->get();
+}
+
+std::vector<const ppc::core::TaskRegistration *> ppc::core::TaskRegistry::List() const {
+  std::vector<const TaskRegistration *> list;
+  list.reserve(registrations_.size());
+  for (const auto &registration : registrations_) {
+    list.push_back(registration.get());
+  }
+  std::ranges::sort(list, [](const auto *a, const auto *b) {
+    return a->name != b->name ? a->name < b->name : a->backend < b->backend;
+  });
+  return list;
+}
+
+ppc::core::TaskInput ppc::core::MakeIdentitySquareInput(uint64_t size) {
+  const auto count = static_cast<size_t>(std::sqrt(static_cast<double>(size)));
+  std::vector<int> input(count * count, 0);
+  for (size_t i = 0; i < count; i++) {
+    input[(i * count) + i] = 1;
+  }
+  const size_t output_size = input.size();
+  return MakeVectorInput<int>(std::move(input), output_size,
+                              [](const std::vector<int> &in, const std::vector<int> &out) { return in == out; });
+}
+
+ppc::core::TaskRegistrar::TaskRegistrar(TaskRegistration registration) {
+  TaskRegistry::Instance().Register(std::move(registration));
+}
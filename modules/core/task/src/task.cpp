@@ -1,5 +1,6 @@
 #include "core/task/include/task.hpp"
 
+#include <chrono>
 #include <cstddef>
 #include <iomanip>
 #include <iostream>
@@ -7,6 +8,11 @@
 #include <stdexcept>
 #include <string>
 
+bool ppc::core::TaskData::IsInPlace(std::size_t input_index, std::size_t output_index) const {
+  return input_index < inputs.size() && output_index < outputs.size() && inputs[input_index] != nullptr &&
+         inputs[input_index] == outputs[output_index];
+}
+
 void ppc::core::Task::SetData(TaskDataPtr task_data_ptr) {
   task_data_ptr->state_of_testing = TaskData::StateOfTesting::kFunc;
   functions_order_.clear();
@@ -17,24 +23,38 @@ ppc::core::TaskDataPtr ppc::core::Task::GetData() const { return task_data; }
 
 ppc::core::Task::Task(TaskDataPtr task_data) { SetData(std::move(task_data)); }
 
+const ppc::core::PhaseTimings& ppc::core::Task::GetPhaseTimings() const { return phase_timings_; }
+
+void ppc::core::Task::ResetPhaseTimings() { phase_timings_ = PhaseTimings(); }
+
+template <typename Impl>
+bool ppc::core::Task::TimePhase(double& phase_time, Impl impl) {
+  auto begin = std::chrono::high_resolution_clock::now();
+  bool result = impl();
+  auto end = std::chrono::high_resolution_clock::now();
+  auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count();
+  phase_time += static_cast<double>(duration) * 1e-9;
+  return result;
+}
+
 bool ppc::core::Task::Validation() {
   InternalOrderTest();
-  return ValidationImpl();
+  return TimePhase(phase_timings_.validation, [this] { return ValidationImpl(); });
 }
 
 bool ppc::core::Task::PreProcessing() {
   InternalOrderTest();
-  return PreProcessingImpl();
+  return TimePhase(phase_timings_.pre_processing, [this] { return PreProcessingImpl(); });
 }
 
 bool ppc::core::Task::Run() {
   InternalOrderTest();
-  return RunImpl();
+  return TimePhase(phase_timings_.run, [this] { return RunImpl(); });
 }
 
 bool ppc::core::Task::PostProcessing() {
   InternalOrderTest();
-  return PostProcessingImpl();
+  return TimePhase(phase_timings_.post_processing, [this] { return PostProcessingImpl(); });
 }
 
 void ppc::core::Task::InternalOrderTest(const std::string& str) {
@@ -0,0 +1,303 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <functional>
+#include <random>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "core/util/include/gemm.hpp"
+#include "core/util/include/simd.hpp"
+#include "core/util/include/thread_pool.hpp"
+
+namespace {
+
+std::vector<ppc::util::SimdLevel> GetTestedLevels() {
+  std::vector<ppc::util::SimdLevel> levels = {ppc::util::SimdLevel::kScalar};
+  for (auto level : {ppc::util::SimdLevel::kAvx2, ppc::util::SimdLevel::kAvx512}) {
+    if (level <= ppc::util::GetSimdLevel()) {
+      levels.push_back(level);
+    }
+  }
+  return levels;
+}
+
+template <typename T>
+T RandomValue(std::mt19937 &gen) {
+  std::uniform_real_distribution<double> dist(-1, 1);
+  if constexpr (std::is_same_v<T, std::complex<double>>) {
+    return {dist(gen), dist(gen)};
+  } else {
+    return static_cast<T>(dist(gen));
+  }
+}
+
+template <typename T>
+std::vector<T> RandomMatrix(size_t size, unsigned seed) {
+  std::mt19937 gen(seed);
+  std::vector<T> matrix(size);
+  for (auto &value : matrix) {
+    value = RandomValue<T>(gen);
+  }
+  return matrix;
+}
+
+// Triple loop reference of Gemm
+template <typename T>
+void NaiveGemm(size_t m, size_t n, size_t k, T alpha, const T *a, size_t lda, const T *b, size_t ldb, T beta, T *c,
+               size_t ldc) {
+  for (size_t i = 0; i < m; i++) {
+    for (size_t j = 0; j < n; j++) {
+      T sum{0};
+      for (size_t p = 0; p < k; p++) {
+        sum += a[(i * lda) + p] * b[(p * ldb) + j];
+      }
+      c[(i * ldc) + j] = (alpha * sum) + (beta * c[(i * ldc) + j]);
+    }
+  }
+}
+
+// Submatrices of larger arrays (leading dimensions above the width) with
+// sizes that leave partial register tiles and cache blocks on every side
+template <typename T>
+void CheckGemm(double tolerance, ppc::util::GemmBlocking blocking = {}) {
+  for (auto level : GetTestedLevels()) {
+    for (const auto [m, n, k] : {std::array<size_t, 3>{1, 1, 1}, {7, 5, 3}, {13, 37, 29}, {64, 64, 64},
+                                 {100, 17, 300}, {3, 129, 70}}) {
+      const size_t lda = k + 3;
+      const size_t ldb = n + 5;
+      const size_t ldc = n + 2;
+      const auto a = RandomMatrix<T>(m * lda, 1);
+      const auto b = RandomMatrix<T>(k * ldb, 2);
+      auto c = RandomMatrix<T>(m * ldc, 3);
+      auto expected = c;
+      std::mt19937 gen(static_cast<unsigned>(m + n + k));
+      const T alpha = RandomValue<T>(gen);
+      const T beta = RandomValue<T>(gen);
+
+      ppc::util::Gemm(m, n, k, alpha, a.data(), lda, b.data(), ldb, beta, c.data(), ldc,
+                      {.blocking = blocking, .level = level, .fused = true});
+      NaiveGemm(m, n, k, alpha, a.data(), lda, b.data(), ldb, beta, expected.data(), ldc);
+
+      for (size_t i = 0; i < c.size(); i++) {
+        ASSERT_LE(std::abs(c[i] - expected[i]), tolerance * static_cast<double>(k))
+            << "level " << static_cast<int>(level) << " size " << m << "x" << n << "x" << k << " at " << i;
+      }
+    }
+  }
+}
+
+// Rows x cols matrix stored transposed (cols x rows) with leading dimension ld
+std::vector<double> Transposed(const std::vector<double> &matrix, size_t rows, size_t cols, size_t ld) {
+  std::vector<double> result(cols * ld);
+  for (size_t i = 0; i < rows; i++) {
+    for (size_t j = 0; j < cols; j++) {
+      result[(j * ld) + i] = matrix[(i * cols) + j];
+    }
+  }
+  return result;
+}
+
+const ppc::util::GemmParallelFor kPoolFor = [](size_t count, const std::function<void(size_t)> &body) {
+  ppc::util::ParallelFor(0, count, body);
+};
+
+}  // namespace
+
+TEST(gemm, matches_triple_loop_double) { CheckGemm<double>(1e-14); }
+
+TEST(gemm, matches_triple_loop_float) { CheckGemm<float>(1e-5); }
+
+TEST(gemm, matches_triple_loop_complex) { CheckGemm<std::complex<double>>(1e-14); }
+
+TEST(gemm, small_blocks_match_triple_loop) {
+  CheckGemm<double>(1e-14, {.mc = 8, .nc = 16, .kc = 5});
+  CheckGemm<float>(1e-5, {.mc = 1, .nc = 1, .kc = 1});
+}
+
+TEST(gemm, zero_beta_ignores_c) {
+  const auto a = RandomMatrix<double>(6 * 4, 1);
+  const auto b = RandomMatrix<double>(4 * 9, 2);
+  std::vector<double> c(6 * 9, std::nan(""));
+  std::vector<double> expected(6 * 9, 0.0);
+  ppc::util::Gemm(6, 9, 4, 1.0, a.data(), 4, b.data(), 9, 0.0, c.data(), 9);
+  NaiveGemm(6, 9, 4, 1.0, a.data(), 4, b.data(), 9, 0.0, expected.data(), 9);
+  for (size_t i = 0; i < c.size(); i++) {
+    EXPECT_NEAR(c[i], expected[i], 1e-14);
+  }
+}
+
+TEST(gemm, unfused_matches_triple_loop_exactly) {
+  const auto a = RandomMatrix<double>(37 * 50, 1);
+  const auto b = RandomMatrix<double>(50 * 29, 2);
+  std::vector<double> expected(37 * 29);
+  NaiveGemm(37, 29, 50, 1.0, a.data(), 50, b.data(), 29, 0.0, expected.data(), 29);
+  for (auto level : GetTestedLevels()) {
+    std::vector<double> c(37 * 29);
+    ppc::util::Gemm(37, 29, 50, 1.0, a.data(), 50, b.data(), 29, 0.0, c.data(), 29,
+                    {.blocking = {}, .level = level, .fused = false});
+    EXPECT_EQ(c, expected) << "level " << static_cast<int>(level);
+  }
+}
+
+TEST(gemm, blocking_fits_the_caches) {
+  const auto blocking = ppc::util::GetGemmBlocking(sizeof(double), 6, 8);
+  EXPECT_GE(blocking.kc, 16U);
+  EXPECT_EQ(blocking.mc % 6, 0U);
+  EXPECT_EQ(blocking.nc % 8, 0U);
+  const auto requested = ppc::util::GetGemmBlocking(sizeof(double), 6, 8, {.mc = 0, .nc = 0, .kc = 100});
+  EXPECT_EQ(requested.kc, 100U);
+}
+
+TEST(gemm, transposed_operands_match_triple_loop) {
+  constexpr size_t kM = 23;
+  constexpr size_t kN = 31;
+  constexpr size_t kK = 45;
+  const auto a = RandomMatrix<double>(kM * kK, 1);
+  const auto b = RandomMatrix<double>(kK * kN, 2);
+  const auto a_t = Transposed(a, kM, kK, kM + 3);
+  const auto b_t = Transposed(b, kK, kN, kK + 1);
+  std::vector<double> expected(kM * kN);
+  NaiveGemm(kM, kN, kK, 1.0, a.data(), kK, b.data(), kN, 0.0, expected.data(), kN);
+
+  for (const bool transpose_a : {false, true}) {
+    for (const bool transpose_b : {false, true}) {
+      ppc::util::GemmProblem problem;
+      problem.m = kM;
+      problem.n = kN;
+      problem.k = kK;
+      problem.a = transpose_a ? a_t.data() : a.data();
+      problem.lda = transpose_a ? kM + 3 : kK;
+      problem.transpose_a = transpose_a;
+      problem.b = transpose_b ? b_t.data() : b.data();
+      problem.ldb = transpose_b ? kK + 1 : kN;
+      problem.transpose_b = transpose_b;
+      std::vector<double> c(kM * kN);
+      problem.c = c.data();
+      problem.ldc = kN;
+      // blocks smaller than the operands, so the packed offsets are tested too
+      ppc::util::Gemm(problem, {.blocking = {.mc = 8, .nc = 16, .kc = 10}, .level = ppc::util::GetSimdLevel(),
+                                .fused = true});
+      for (size_t i = 0; i < c.size(); i++) {
+        ASSERT_NEAR(c[i], expected[i], 1e-14 * kK) << "transpose_a " << transpose_a << " transpose_b " << transpose_b;
+      }
+    }
+  }
+}
+
+TEST(gemm, batched_products_match_single_calls) {
+  const std::vector<std::array<size_t, 3>> shapes = {{64, 64, 64}, {300, 200, 300}, {0, 5, 5}, {17, 1, 90}, {5, 70, 3}};
+  std::vector<std::vector<double>> a;
+  std::vector<std::vector<double>> b;
+  std::vector<std::vector<double>> c;
+  std::vector<ppc::util::GemmProblem> batch;
+  for (size_t i = 0; i < shapes.size(); i++) {
+    const auto [m, n, k] = shapes[i];
+    a.push_back(RandomMatrix<double>(m * k, static_cast<unsigned>(i)));
+    b.push_back(RandomMatrix<double>(k * n, static_cast<unsigned>(i + 100)));
+    c.emplace_back(m * n);
+  }
+  for (size_t i = 0; i < shapes.size(); i++) {
+    const auto [m, n, k] = shapes[i];
+    ppc::util::GemmProblem problem;
+    problem.m = m;
+    problem.n = n;
+    problem.k = k;
+    problem.a = a[i].data();
+    problem.lda = k;
+    problem.b = b[i].data();
+    problem.ldb = n;
+    problem.c = c[i].data();
+    problem.ldc = n;
+    batch.push_back(problem);
+  }
+  ppc::util::GemmBatched(batch, kPoolFor);
+
+  for (size_t i = 0; i < shapes.size(); i++) {
+    const auto [m, n, k] = shapes[i];
+    std::vector<double> expected(m * n);
+    ppc::util::Gemm(m, n, k, 1.0, a[i].data(), k, b[i].data(), n, 0.0, expected.data(), n);
+    EXPECT_EQ(c[i], expected) << "product " << i;
+  }
+}
+
+TEST(gemm, batched_splits_only_large_products) {
+  std::vector<double> a(512 * 512);
+  std::vector<double> c(512 * 512);
+  ppc::util::GemmProblem small;
+  small.m = small.n = small.k = 64;
+  small.a = small.b = a.data();
+  small.lda = small.ldb = small.ldc = 64;
+  ppc::util::GemmProblem large = small;
+  large.m = large.n = large.k = 512;
+  large.lda = large.ldb = large.ldc = 512;
+  large.c = c.data();
+  std::vector<double> c_small(3 * 64 * 64);
+  std::vector<ppc::util::GemmProblem> batch(3, small);
+  for (size_t i = 0; i < batch.size(); i++) {
+    batch[i].c = c_small.data() + (i * 64 * 64);
+  }
+  batch.push_back(large);
+
+  size_t tasks = 0;
+  ppc::util::GemmBatched(batch, [&tasks](size_t count, const std::function<void(size_t)> &body) {
+    tasks = count;
+    for (size_t i = 0; i < count; i++) {
+      body(i);
+    }
+  });
+  // one task per small product, bands of 64 rows of the large one
+  EXPECT_EQ(tasks, 3U + 8U);
+}
+
+TEST(gemm, batched_with_progress_polls_on_the_calling_thread) {
+  constexpr size_t kN = 512;
+  const auto a = RandomMatrix<double>(kN * kN, 3);
+  const auto b = RandomMatrix<double>(kN * kN, 4);
+  std::vector<double> c(kN * kN);
+  ppc::util::GemmProblem problem;
+  problem.m = problem.n = problem.k = kN;
+  problem.a = a.data();
+  problem.b = b.data();
+  problem.c = c.data();
+  problem.lda = problem.ldb = problem.ldc = kN;
+
+  const auto caller = std::this_thread::get_id();
+  size_t calls = 0;
+  bool other_thread = false;
+  ppc::util::GemmBatchedWithProgress({&problem, 1}, kPoolFor, [&] {
+    other_thread = other_thread || std::this_thread::get_id() != caller;
+    ++calls;
+  });
+  EXPECT_FALSE(other_thread);
+  // the calling thread runs at least one of the 64-row bands
+  EXPECT_GE(calls, 2U);
+
+  std::vector<double> expected(kN * kN);
+  ppc::util::Gemm(kN, kN, kN, 1.0, a.data(), kN, b.data(), kN, 0.0, expected.data(), kN);
+  EXPECT_EQ(c, expected);
+}
+
+TEST(gemm, block_stages_add_up_to_the_product) {
+  // 10 is cut into blocks of 4, 4 and 2
+  constexpr size_t kN = 10;
+  const auto a = RandomMatrix<double>(kN * kN, 1);
+  const auto b = RandomMatrix<double>(kN * kN, 2);
+  std::vector<double> expected(kN * kN);
+  NaiveGemm<double>(kN, kN, kN, 1.0, a.data(), kN, b.data(), kN, 0.0, expected.data(), kN);
+  for (auto schedule : {ppc::util::BlockSchedule::kCannon, ppc::util::BlockSchedule::kFox}) {
+    std::vector<double> c(kN * kN);
+    for (size_t stage = 0; stage < 3; stage++) {
+      const auto batch = ppc::util::BlockStageBatch(a.data(), b.data(), c.data(), kN, 4, stage, schedule);
+      ASSERT_EQ(batch.size(), 9U);
+      ppc::util::GemmBatched(batch, kPoolFor);
+    }
+    for (size_t i = 0; i < c.size(); i++) {
+      ASSERT_NEAR(c[i], expected[i], 1e-13) << "schedule " << static_cast<int>(schedule);
+    }
+  }
+}
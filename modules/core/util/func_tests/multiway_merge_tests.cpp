@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <random>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "core/util/include/multiway_merge.hpp"
+
+namespace {
+
+std::vector<std::vector<int>> MakeRuns(size_t num_runs, size_t max_size, int max_value) {
+  std::mt19937 gen(static_cast<unsigned>(num_runs * 31 + max_size));
+  std::uniform_int_distribution<size_t> size_dist(0, max_size);
+  std::uniform_int_distribution<int> value_dist(-max_value, max_value);
+  std::vector<std::vector<int>> runs(num_runs);
+  for (auto &run : runs) {
+    run.resize(size_dist(gen));
+    std::ranges::generate(run, [&] { return value_dist(gen); });
+    std::ranges::sort(run);
+  }
+  return runs;
+}
+
+template <typename T>
+std::vector<std::span<const T>> ToSpans(const std::vector<std::vector<T>> &runs) {
+  return {runs.begin(), runs.end()};
+}
+
+std::vector<int> Concatenated(const std::vector<std::vector<int>> &runs) {
+  std::vector<int> all;
+  for (const auto &run : runs) {
+    all.insert(all.end(), run.begin(), run.end());
+  }
+  return all;
+}
+
+}  // namespace
+
+TEST(multiway_merge_tests, check_merge) {
+  for (size_t num_runs : {0, 1, 2, 3, 5, 8, 13}) {
+    const auto runs = MakeRuns(num_runs, 500, 100);
+    auto expected = Concatenated(runs);
+    std::ranges::sort(expected);
+
+    std::vector<int> merged(expected.size());
+    auto *end = ppc::util::MultiwayMerge(ToSpans(runs), merged.data());
+
+    EXPECT_EQ(end, merged.data() + merged.size());
+    EXPECT_EQ(merged, expected) << num_runs << " runs";
+  }
+}
+
+TEST(multiway_merge_tests, check_merge_is_stable) {
+  using Item = std::pair<int, size_t>;
+  std::vector<std::vector<Item>> runs(6);
+  for (size_t i = 0; i < runs.size(); i++) {
+    for (int key = 0; key < 20; key++) {
+      runs[i].emplace_back(key / 3, i);
+    }
+  }
+  auto by_key = [](const Item &a, const Item &b) { return a.first < b.first; };
+
+  std::vector<Item> merged(120);
+  ppc::util::MultiwayMerge(ToSpans(runs), merged.data(), by_key);
+
+  EXPECT_TRUE(std::ranges::is_sorted(merged));
+}
+
+TEST(multiway_merge_tests, check_split) {
+  const auto runs = MakeRuns(7, 300, 20);
+  const auto spans = ToSpans(runs);
+  auto sorted = Concatenated(runs);
+  std::ranges::sort(sorted);
+
+  for (size_t rank = 0; rank <= sorted.size(); rank += 17) {
+    const auto split = ppc::util::MultiwaySplit(spans, rank);
+    size_t count = 0;
+    for (size_t i = 0; i < runs.size(); i++) {
+      count += split[i];
+      for (size_t j = 0; j < split[i]; j++) {
+        EXPECT_LE(runs[i][j], sorted[rank - 1]);
+      }
+      if (split[i] < runs[i].size() && rank < sorted.size()) {
+        EXPECT_GE(runs[i][split[i]], sorted[rank]);
+      }
+    }
+    EXPECT_EQ(count, rank);
+  }
+}
+
+TEST(multiway_merge_tests, check_merge_parts) {
+  const auto runs = MakeRuns(9, 1000, 50);
+  const auto spans = ToSpans(runs);
+  auto expected = Concatenated(runs);
+  std::ranges::sort(expected);
+
+  for (size_t num_parts : {1, 2, 3, 7, 16}) {
+    std::vector<int> merged(expected.size(), 0);
+    for (size_t part = 0; part < num_parts; part++) {
+      ppc::util::MultiwayMergePart(spans, merged.data(), part, num_parts);
+    }
+    EXPECT_EQ(merged, expected) << num_parts << " parts";
+  }
+}
+
+TEST(multiway_merge_tests, check_merge_parts_of_equal_elements) {
+  std::vector<std::vector<int>> runs(4, std::vector<int>(100, 7));
+  std::vector<int> merged(400, 0);
+
+  for (size_t part = 0; part < 5; part++) {
+    ppc::util::MultiwayMergePart(ToSpans(runs), merged.data(), part, 5);
+  }
+
+  EXPECT_EQ(merged, std::vector<int>(400, 7));
+}
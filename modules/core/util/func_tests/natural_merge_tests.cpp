@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "core/util/include/natural_merge.hpp"
+#include "core/util/include/sort_inputs.hpp"
+
+using ppc::util::SortDistribution;
+
+namespace {
+
+// Sorts with std::ranges::sort and records the sizes it was called with
+struct CountingFallback {
+  std::vector<size_t> *calls;
+  void operator()(std::span<int32_t> data) const {
+    calls->push_back(data.size());
+    std::ranges::sort(data);
+  }
+};
+
+}  // namespace
+
+TEST(natural_merge, finds_and_reverses_runs) {
+  std::vector<int> data = {1, 2, 2, 5, 4, 3, 3, 0, 7, 8};
+  const auto bounds = ppc::util::FindNaturalRuns(std::span<int>(data));
+  EXPECT_EQ(bounds, (std::vector<size_t>{0, 4, 6, 10}));
+  EXPECT_EQ(data, (std::vector<int>{1, 2, 2, 5, 3, 4, 0, 3, 7, 8}));
+
+  std::vector<int> zigzag = {1, 0, 1, 0, 1, 0, 1, 0};
+  EXPECT_TRUE(ppc::util::FindNaturalRuns(std::span<int>(zigzag), std::less<>(), 2).empty());
+}
+
+TEST(natural_merge, merge_of_runs_is_stable) {
+  // key, original position
+  std::vector<std::pair<int, int>> data;
+  for (int run = 0; run < 37; run++) {
+    for (int i = 0; i < 10 + (run * 7 % 23); i++) {
+      data.emplace_back(((i * 3) + run) % 50 + i, static_cast<int>(data.size()));
+    }
+  }
+  const auto by_key = [](const auto &a, const auto &b) { return a.first < b.first; };
+  auto expected = data;
+  std::ranges::stable_sort(expected, by_key);
+
+  std::span<std::pair<int, int>> span(data);
+  const auto bounds = ppc::util::FindNaturalRuns(span, by_key);
+  ppc::util::MergeNaturalRuns(span, bounds, by_key);
+
+  EXPECT_EQ(data, expected);
+}
+
+TEST(natural_merge, ordered_inputs_need_no_fallback) {
+  for (const auto distribution : {SortDistribution::kSorted, SortDistribution::kReverse, SortDistribution::kAllEqual,
+                                  SortDistribution::kOrganPipe}) {
+    auto data = ppc::util::GenerateSortData<int32_t>(distribution, 100000, 1);
+    auto expected = data;
+    std::ranges::sort(expected);
+    std::vector<size_t> calls;
+
+    ppc::util::AdaptiveSort(std::span<int32_t>(data), CountingFallback{&calls});
+
+    EXPECT_EQ(data, expected);
+    EXPECT_TRUE(calls.empty());
+  }
+}
+
+TEST(natural_merge, only_displaced_elements_go_to_the_fallback) {
+  auto data = ppc::util::GenerateSortData<int32_t>(SortDistribution::kNearlySorted, 100000, 2);
+  // late arrivals of an append-mostly log
+  std::ranges::sort(data);
+  for (size_t i = 1000; i < data.size(); i += 31) {
+    std::swap(data[i], data[i - 900]);
+  }
+  auto expected = data;
+  std::ranges::sort(expected);
+  std::vector<size_t> calls;
+
+  ppc::util::AdaptiveSort(std::span<int32_t>(data), CountingFallback{&calls});
+
+  EXPECT_EQ(data, expected);
+  ASSERT_EQ(calls.size(), 1U);
+  EXPECT_LT(calls[0], data.size() / 10);
+}
+
+TEST(natural_merge, neighbouring_spikes_are_displaced_together) {
+  std::vector<int32_t> data(100000);
+  for (size_t i = 0; i < data.size(); i++) {
+    data[i] = static_cast<int32_t>(i);
+  }
+  // too many runs to merge them
+  for (size_t i = 100; i < data.size(); i += 200) {
+    data[i] = data[i + 1] = data[i + 2] = static_cast<int32_t>(i + 5000);
+  }
+  std::vector<size_t> calls;
+
+  ppc::util::AdaptiveSort(std::span<int32_t>(data), CountingFallback{&calls});
+
+  EXPECT_TRUE(std::ranges::is_sorted(data));
+  EXPECT_EQ(calls, std::vector<size_t>{3 * data.size() / 200});
+}
+
+TEST(natural_merge, random_inputs_use_the_fallback) {
+  for (const auto distribution : {SortDistribution::kUniform, SortDistribution::kFewUnique, SortDistribution::kZipf}) {
+    auto data = ppc::util::GenerateSortData<int32_t>(distribution, 50000, 3);
+    auto expected = data;
+    std::ranges::sort(expected);
+    std::vector<size_t> calls;
+
+    ppc::util::AdaptiveSort(std::span<int32_t>(data), CountingFallback{&calls});
+
+    EXPECT_EQ(data, expected);
+    EXPECT_EQ(calls, std::vector<size_t>{data.size()});
+  }
+}
+
+TEST(natural_merge, handles_tiny_inputs) {
+  std::vector<size_t> calls;
+  for (size_t size = 0; size < 70; size++) {
+    auto data = ppc::util::GenerateSortData<int32_t>(SortDistribution::kUniform, size, size);
+    auto expected = data;
+    std::ranges::sort(expected);
+    ppc::util::AdaptiveSort(std::span<int32_t>(data), CountingFallback{&calls});
+    EXPECT_EQ(data, expected);
+  }
+}
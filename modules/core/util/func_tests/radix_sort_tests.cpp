@@ -0,0 +1,146 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include "core/util/include/radix_sort.hpp"
+#include "core/util/include/thread_pool.hpp"
+
+namespace {
+
+template <typename Key>
+std::vector<uint32_t> StableArgsort(const std::vector<Key> &keys) {
+  std::vector<uint32_t> permutation(keys.size());
+  std::iota(permutation.begin(), permutation.end(), 0U);
+  std::ranges::stable_sort(permutation, [&](uint32_t a, uint32_t b) { return keys[a] < keys[b]; });
+  return permutation;
+}
+
+struct Record {
+  int32_t id;
+  float weight;
+  char tag[6];
+};
+
+}  // namespace
+
+TEST(radix_sort, argsort_of_int_keys_is_stable) {
+  std::mt19937 gen(1);
+  std::uniform_int_distribution<int> dist(-50, 50);
+  std::vector<int> keys(100000);
+  std::ranges::generate(keys, [&] { return dist(gen); });
+  ppc::util::ThreadPool pool(4);
+
+  EXPECT_EQ(ppc::util::RadixArgsort(std::span<const int>(keys), pool), StableArgsort(keys));
+}
+
+TEST(radix_sort, argsort_of_doubles_orders_signs_and_infinities) {
+  std::mt19937 gen(2);
+  std::uniform_real_distribution<double> dist(-1e6, 1e6);
+  std::vector<double> keys(70000);
+  std::ranges::generate(keys, [&] { return dist(gen); });
+  keys[10] = std::numeric_limits<double>::infinity();
+  keys[20] = -std::numeric_limits<double>::infinity();
+  keys[30] = std::numeric_limits<double>::denorm_min();
+  keys[40] = keys[50] = 1.0;
+  ppc::util::ThreadPool pool(3);
+
+  EXPECT_EQ(ppc::util::RadixArgsort(std::span<const double>(keys), pool), StableArgsort(keys));
+}
+
+TEST(radix_sort, negative_zero_goes_before_zero) {
+  std::vector<double> keys = {0.0, -0.0, 1.0, -0.0, 0.0};
+  auto permutation = ppc::util::RadixArgsort(std::span<const double>(keys));
+  EXPECT_EQ(permutation, (std::vector<uint32_t>{1, 3, 0, 4, 2}));
+  EXPECT_TRUE(std::signbit(keys[permutation[0]]));
+}
+
+TEST(radix_sort, sorts_keys_with_struct_payloads) {
+  std::mt19937 gen(3);
+  std::uniform_int_distribution<int64_t> dist(std::numeric_limits<int64_t>::min(), std::numeric_limits<int64_t>::max());
+  std::vector<int64_t> keys(50000);
+  std::ranges::generate(keys, [&] { return dist(gen) / 1000; });
+  keys[7] = keys[8];
+  std::vector<Record> records(keys.size());
+  for (size_t i = 0; i < records.size(); i++) {
+    records[i] = {.id = static_cast<int32_t>(i), .weight = static_cast<float>(i) / 2, .tag = "rec"};
+  }
+  const auto expected = StableArgsort(keys);
+  auto sorted_keys = keys;
+  ppc::util::ThreadPool pool(2);
+
+  ppc::util::RadixSortPairs(std::span<int64_t>(sorted_keys), std::span<Record>(records), pool);
+
+  EXPECT_TRUE(std::ranges::is_sorted(sorted_keys));
+  for (size_t i = 0; i < records.size(); i++) {
+    ASSERT_EQ(records[i].id, static_cast<int32_t>(expected[i]));
+    ASSERT_EQ(sorted_keys[i], keys[expected[i]]);
+    ASSERT_EQ(records[i].weight, static_cast<float>(expected[i]) / 2);
+  }
+}
+
+TEST(radix_sort, sorts_unsigned_and_float_keys) {
+  std::vector<uint32_t> keys = {7, 0xFFFFFFFFU, 0, 7, 3};
+  std::vector<float> payloads = {0.5F, 1.5F, 2.5F, 3.5F, 4.5F};
+  ppc::util::RadixSortPairs(std::span<uint32_t>(keys), std::span<float>(payloads));
+  EXPECT_EQ(keys, (std::vector<uint32_t>{0, 3, 7, 7, 0xFFFFFFFFU}));
+  EXPECT_EQ(payloads, (std::vector<float>{2.5F, 4.5F, 0.5F, 3.5F, 1.5F}));
+
+  std::vector<float> float_keys = {2.0F, -1.0F, -3.5F, 0.0F};
+  std::vector<uint8_t> bytes = {0, 1, 2, 3};
+  ppc::util::RadixSortPairs(std::span<float>(float_keys), std::span<uint8_t>(bytes));
+  EXPECT_EQ(float_keys, (std::vector<float>{-3.5F, -1.0F, 0.0F, 2.0F}));
+  EXPECT_EQ(bytes, (std::vector<uint8_t>{2, 1, 3, 0}));
+}
+
+TEST(radix_sort, handles_empty_input) {
+  std::vector<int> keys;
+  std::vector<int> payloads;
+  ppc::util::RadixSortPairs(std::span<int>(keys), std::span<int>(payloads));
+  EXPECT_TRUE(ppc::util::RadixArgsort(std::span<const int>(keys)).empty());
+}
+
+TEST(radix_sort, throws_on_mismatched_sizes) {
+  std::vector<int> keys(3);
+  std::vector<int> payloads(2);
+  EXPECT_THROW(ppc::util::RadixSortPairs(std::span<int>(keys), std::span<int>(payloads)), std::invalid_argument);
+}
+
+TEST(radix_sort, throws_if_index_type_is_too_small) {
+  std::vector<int> keys(300);
+  EXPECT_THROW(ppc::util::RadixArgsort<uint8_t>(std::span<const int>(keys)), std::length_error);
+}
+
+TEST(radix_sort, narrow_key_range_with_skipped_passes) {
+  // doubles in [1, 2) share the sign and exponent bytes
+  std::mt19937 gen(4);
+  std::uniform_real_distribution<double> dist(1.0, 2.0);
+  std::vector<double> keys(80000);
+  std::ranges::generate(keys, [&] { return dist(gen); });
+  ppc::util::ThreadPool pool(4);
+
+  EXPECT_EQ(ppc::util::RadixArgsort(std::span<const double>(keys), pool), StableArgsort(keys));
+}
+
+TEST(radix_sort, wide_digits_for_large_inputs) {
+  EXPECT_EQ(ppc::util::RadixDigitBits(1000, 64), 8);
+  const size_t size = size_t{1} << 20;
+  const int digit_bits = ppc::util::RadixDigitBits(size, 32);
+  EXPECT_TRUE(digit_bits == 8 || digit_bits == 11 || digit_bits == 16);
+
+  std::mt19937 gen(5);
+  std::uniform_int_distribution<int> dist(std::numeric_limits<int>::min(), std::numeric_limits<int>::max());
+  std::vector<int> keys(size);
+  std::ranges::generate(keys, [&] { return dist(gen) / 4; });
+  ppc::util::ThreadPool pool(3);
+
+  EXPECT_EQ(ppc::util::RadixArgsort(std::span<const int>(keys), pool), StableArgsort(keys));
+}
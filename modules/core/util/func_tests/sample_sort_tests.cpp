@@ -0,0 +1,124 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <span>
+#include <vector>
+
+#include "core/util/include/sample_sort.hpp"
+#include "core/util/include/sort_inputs.hpp"
+#include "core/util/include/thread_pool.hpp"
+
+using ppc::util::SortDistribution;
+
+namespace {
+
+const auto kSequentialFor = [](size_t count, const auto &body) {
+  for (size_t i = 0; i < count; i++) {
+    body(i);
+  }
+};
+
+// Sorts with std::sort and counts the elements it was given
+template <typename T>
+struct CountingSort {
+  std::atomic<size_t> *sorted;
+  void operator()(std::span<T> bucket) const {
+    *sorted += bucket.size();
+    std::ranges::sort(bucket);
+  }
+};
+
+}  // namespace
+
+TEST(sample_sort, sorts_every_distribution) {
+  for (const auto distribution : ppc::util::GetSortDistributions()) {
+    auto data = ppc::util::GenerateSortData<int32_t>(distribution, 300000, 1);
+    auto expected = data;
+    std::ranges::sort(expected);
+    std::atomic<size_t> sorted = 0;
+
+    ppc::util::SampleSort(std::span<int32_t>(data), kSequentialFor, CountingSort<int32_t>{&sorted});
+
+    EXPECT_EQ(data, expected) << ppc::util::GetSortDistributionName(distribution);
+    EXPECT_LE(sorted, data.size());
+  }
+}
+
+TEST(sample_sort, runs_on_the_thread_pool_with_a_comparator) {
+  ppc::util::ThreadPool pool(4);
+  auto data = ppc::util::GenerateSortData<double>(SortDistribution::kUniform, 1000000, 2);
+  auto expected = data;
+  std::ranges::sort(expected, std::greater<>());
+
+  ppc::util::SampleSort(
+      std::span<double>(data),
+      [&](size_t count, const auto &body) { ppc::util::ParallelFor(0, count, body, 1, pool); },
+      [](std::span<double> bucket) { std::ranges::sort(bucket, std::greater<>()); }, std::greater<>());
+
+  EXPECT_EQ(data, expected);
+}
+
+TEST(sample_sort, duplicates_skip_the_bucket_sort) {
+  for (const auto distribution : {SortDistribution::kAllEqual, SortDistribution::kFewUnique}) {
+    auto data = ppc::util::GenerateSortData<int32_t>(distribution, 200000, 3);
+    auto expected = data;
+    std::ranges::sort(expected);
+    std::atomic<size_t> sorted = 0;
+
+    ppc::util::SampleSort(std::span<int32_t>(data), kSequentialFor, CountingSort<int32_t>{&sorted});
+
+    EXPECT_EQ(data, expected);
+    EXPECT_LT(sorted, data.size() / 100);
+  }
+}
+
+TEST(sample_sort, buckets_are_balanced) {
+  auto data = ppc::util::GenerateSortData<int32_t>(SortDistribution::kUniform, 1 << 20, 4);
+  std::atomic<size_t> largest = 0;
+
+  ppc::util::SampleSort(std::span<int32_t>(data), kSequentialFor, [&](std::span<int32_t> bucket) {
+    largest = std::max<size_t>(largest, bucket.size());
+    std::ranges::sort(bucket);
+  });
+
+  EXPECT_TRUE(std::ranges::is_sorted(data));
+  // 128 buckets of 8192 elements on average
+  EXPECT_LT(largest, 3 * 8192U);
+}
+
+TEST(sample_sort, keeps_nans) {
+  auto data = ppc::util::GenerateSortData<double>(SortDistribution::kSpecial, 100000, 5);
+  auto expected = data;
+  std::ranges::sort(expected, [](double a, double b) { return std::strong_order(a, b) < 0; });
+
+  ppc::util::SampleSort(std::span<double>(data), kSequentialFor, [](std::span<double> bucket) {
+    std::ranges::sort(bucket, [](double a, double b) { return std::strong_order(a, b) < 0; });
+  });
+
+  std::vector<double> numbers;
+  std::ranges::copy_if(data, std::back_inserter(numbers), [](double v) { return !std::isnan(v); });
+  EXPECT_TRUE(std::ranges::is_sorted(numbers));
+  std::ranges::sort(data, [](double a, double b) { return std::strong_order(a, b) < 0; });
+  EXPECT_TRUE(std::ranges::equal(data, expected, [](double a, double b) { return std::strong_order(a, b) == 0; }));
+
+  std::vector<double> all_nan(10000, std::numeric_limits<double>::quiet_NaN());
+  ppc::util::SampleSort(std::span<double>(all_nan), kSequentialFor, [](std::span<double>) {});
+  EXPECT_TRUE(std::ranges::all_of(all_nan, [](double v) { return std::isnan(v); }));
+}
+
+TEST(sample_sort, small_inputs_go_to_the_bucket_sort) {
+  for (size_t size : {0, 1, 2, 100, 4095}) {
+    auto data = ppc::util::GenerateSortData<int32_t>(SortDistribution::kUniform, size, size);
+    std::atomic<size_t> sorted = 0;
+    ppc::util::SampleSort(std::span<int32_t>(data), kSequentialFor, CountingSort<int32_t>{&sorted});
+    EXPECT_TRUE(std::ranges::is_sorted(data));
+    EXPECT_EQ(sorted, size > 1 ? size : 0);
+  }
+}
@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <set>
+#include <stdexcept>
+#include <vector>
+
+#include "core/util/include/sort_inputs.hpp"
+
+using ppc::util::GenerateSortData;
+using ppc::util::SortDistribution;
+
+TEST(sort_inputs, names_round_trip) {
+  EXPECT_EQ(ppc::util::GetSortDistributions().size(), 11U);
+  for (const auto distribution : ppc::util::GetSortDistributions()) {
+    EXPECT_EQ(ppc::util::ParseSortDistribution(ppc::util::GetSortDistributionName(distribution)), distribution);
+  }
+  EXPECT_THROW(ppc::util::ParseSortDistribution("gaussian"), std::invalid_argument);
+}
+
+TEST(sort_inputs, same_seed_gives_same_data) {
+  for (const auto distribution : ppc::util::GetSortDistributions()) {
+    const auto a = GenerateSortData<int32_t>(distribution, 1000, 7);
+    EXPECT_EQ(a, GenerateSortData<int32_t>(distribution, 1000, 7));
+    EXPECT_EQ(a.size(), 1000U);
+  }
+  EXPECT_NE(GenerateSortData<double>(SortDistribution::kUniform, 100, 1),
+            GenerateSortData<double>(SortDistribution::kUniform, 100, 2));
+}
+
+TEST(sort_inputs, shapes_of_ordered_distributions) {
+  EXPECT_TRUE(std::ranges::is_sorted(GenerateSortData<double>(SortDistribution::kSorted, 5000, 1)));
+  EXPECT_TRUE(std::ranges::is_sorted(GenerateSortData<int32_t>(SortDistribution::kReverse, 5000, 1), std::greater<>()));
+
+  const auto nearly = GenerateSortData<int32_t>(SortDistribution::kNearlySorted, 10000, 1);
+  size_t descents = 0;
+  for (size_t i = 1; i < nearly.size(); i++) {
+    descents += nearly[i] < nearly[i - 1] ? 1 : 0;
+  }
+  EXPECT_GT(descents, 0U);
+  EXPECT_LE(descents, 2 * nearly.size() / 100);
+
+  const auto pipe = GenerateSortData<int32_t>(SortDistribution::kOrganPipe, 1001, 1);
+  const auto peak = std::ranges::max_element(pipe);
+  EXPECT_TRUE(std::is_sorted(pipe.begin(), peak));
+  EXPECT_TRUE(std::is_sorted(peak, pipe.end(), std::greater<>()));
+}
+
+TEST(sort_inputs, duplicate_heavy_distributions) {
+  const auto few = GenerateSortData<double>(SortDistribution::kFewUnique, 10000, 1);
+  EXPECT_LE(std::set<double>(few.begin(), few.end()).size(), 16U);
+
+  const auto equal = GenerateSortData<int32_t>(SortDistribution::kAllEqual, 100, 1);
+  EXPECT_EQ(std::ranges::count(equal, equal.front()), 100);
+
+  // the most frequent Zipf value alone is about a tenth of the data
+  const auto zipf = GenerateSortData<int32_t>(SortDistribution::kZipf, 100000, 1);
+  auto sorted = zipf;
+  std::ranges::sort(sorted);
+  size_t longest = 0;
+  for (size_t i = 0, j = 0; i < sorted.size(); i = j) {
+    for (j = i; j < sorted.size() && sorted[j] == sorted[i]; j++) {
+    }
+    longest = std::max(longest, j - i);
+  }
+  EXPECT_GT(longest, zipf.size() / 20);
+}
+
+TEST(sort_inputs, special_doubles_contain_every_kind) {
+  const auto data = GenerateSortData<double>(SortDistribution::kSpecial, 10000, 1);
+  EXPECT_TRUE(std::ranges::any_of(data, [](double v) { return std::isnan(v) && !std::signbit(v); }));
+  EXPECT_TRUE(std::ranges::any_of(data, [](double v) { return std::isnan(v) && std::signbit(v); }));
+  EXPECT_TRUE(std::ranges::any_of(data, [](double v) { return std::isinf(v) && v < 0; }));
+  EXPECT_TRUE(std::ranges::any_of(data, [](double v) { return v == 0 && std::signbit(v); }));
+  EXPECT_TRUE(std::ranges::any_of(data, [](double v) { return std::fpclassify(v) == FP_SUBNORMAL; }));
+}
+
+TEST(sort_inputs, huge_range_spans_exponents) {
+  const auto data = GenerateSortData<double>(SortDistribution::kHugeRange, 10000, 1);
+  EXPECT_LT(std::ranges::min(data), -1e200);
+  EXPECT_GT(std::ranges::max(data), 1e200);
+  EXPECT_TRUE(std::ranges::any_of(data, [](double v) { return std::abs(v) < 1e-200; }));
+}
+
+TEST(sort_inputs, nan_heavy_mixes_signs_and_payloads) {
+  const auto data = GenerateSortData<double>(SortDistribution::kNaNHeavy, 10000, 1);
+  const auto nans = std::ranges::count_if(data, [](double v) { return std::isnan(v); });
+  EXPECT_GT(nans, 4000);
+  EXPECT_LT(nans, 6000);
+  const auto negative_nans = std::ranges::count_if(data, [](double v) { return std::isnan(v) && std::signbit(v); });
+  EXPECT_GT(negative_nans, nans / 4);
+  EXPECT_LT(negative_nans, nans * 3 / 4);
+  std::set<uint64_t> nan_bits;
+  for (double v : data) {
+    if (std::isnan(v)) {
+      nan_bits.insert(std::bit_cast<uint64_t>(v));
+    }
+  }
+  EXPECT_GT(nan_bits.size(), 2U);
+
+  const auto integers = GenerateSortData<int32_t>(SortDistribution::kNaNHeavy, 10000, 1);
+  EXPECT_GT(std::ranges::count(integers, std::numeric_limits<int32_t>::min()), 1000);
+  EXPECT_GT(std::ranges::count(integers, std::numeric_limits<int32_t>::max()), 1000);
+}
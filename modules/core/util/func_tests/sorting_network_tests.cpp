@@ -0,0 +1,150 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <span>
+#include <vector>
+
+#include "core/util/include/sorting_network.hpp"
+
+namespace {
+
+// Every level up to the one of the CPU, so the scalar kernels are tested everywhere
+std::vector<ppc::util::SimdLevel> GetTestedLevels() {
+  std::vector<ppc::util::SimdLevel> levels = {ppc::util::SimdLevel::kScalar};
+  for (auto level : {ppc::util::SimdLevel::kAvx2, ppc::util::SimdLevel::kAvx512}) {
+    if (level <= ppc::util::GetSimdLevel()) {
+      levels.push_back(level);
+    }
+  }
+  return levels;
+}
+
+template <typename T>
+std::vector<T> MakeSortedVector(size_t size, unsigned seed) {
+  std::mt19937 gen(seed);
+  std::uniform_int_distribution<int> dist(-50, 50);
+  std::vector<T> vec(size);
+  for (auto &value : vec) {
+    value = static_cast<T>(dist(gen)) / static_cast<T>(4);
+  }
+  return vec;
+}
+
+template <typename T>
+void CheckSort() {
+  for (auto level : GetTestedLevels()) {
+    for (size_t size : {0, 1, 3, 4, 8, 15, 16, 17, 31, 100, 257, 1000}) {
+      auto data = MakeSortedVector<T>(size, static_cast<unsigned>(size));
+      auto expected = data;
+      std::ranges::sort(expected);
+
+      ppc::util::NetworkSort(std::span<T>(data), level);
+
+      ASSERT_EQ(data, expected) << "size " << size << ", level " << static_cast<int>(level);
+    }
+  }
+}
+
+template <typename T>
+void CheckMerge() {
+  for (auto level : GetTestedLevels()) {
+    for (size_t a_size : {0, 5, 16, 33, 200}) {
+      for (size_t b_size : {0, 7, 16, 64, 301}) {
+        auto a = MakeSortedVector<T>(a_size, static_cast<unsigned>(a_size));
+        auto b = MakeSortedVector<T>(b_size, static_cast<unsigned>(b_size + 1000));
+        std::ranges::sort(a);
+        std::ranges::sort(b);
+        std::vector<T> expected(a_size + b_size);
+        std::ranges::merge(a, b, expected.begin());
+
+        std::vector<T> merged(a_size + b_size);
+        ppc::util::NetworkMerge(std::span<const T>(a), std::span<const T>(b), merged.data(), level);
+        ASSERT_EQ(merged, expected) << a_size << " + " << b_size << ", level " << static_cast<int>(level);
+
+        // in place: the left half is copied away and the output ends on the right half
+        std::vector<T> in_place = a;
+        in_place.insert(in_place.end(), b.begin(), b.end());
+        ppc::util::NetworkMerge(std::span<const T>(a), std::span<const T>(in_place).subspan(a_size), in_place.data(),
+                                level);
+        ASSERT_EQ(in_place, expected) << a_size << " + " << b_size << " in place";
+      }
+    }
+  }
+}
+
+}  // namespace
+
+TEST(sorting_network_tests, check_sort_int32) { CheckSort<int32_t>(); }
+
+TEST(sorting_network_tests, check_sort_float) { CheckSort<float>(); }
+
+TEST(sorting_network_tests, check_sort_double) { CheckSort<double>(); }
+
+TEST(sorting_network_tests, check_merge_int32) { CheckMerge<int32_t>(); }
+
+TEST(sorting_network_tests, check_merge_float) { CheckMerge<float>(); }
+
+TEST(sorting_network_tests, check_merge_double) { CheckMerge<double>(); }
+
+TEST(sorting_network_tests, check_signed_zeros_are_kept) {
+  for (auto level : GetTestedLevels()) {
+    std::vector<double> data(64);
+    for (size_t i = 0; i < data.size(); i++) {
+      data[i] = i % 2 == 0 ? -0.0 : 0.0;
+    }
+
+    ppc::util::NetworkSort(std::span<double>(data), level);
+
+    EXPECT_EQ(std::ranges::count_if(data, [](double value) { return std::signbit(value); }), 32);
+  }
+}
+
+TEST(sorting_network_tests, check_nans_go_to_the_ends) {
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  for (auto level : GetTestedLevels()) {
+    auto data = MakeSortedVector<double>(300, 5);
+    data[7] = nan;
+    data[100] = -nan;
+    data[299] = nan;
+
+    ppc::util::NetworkSort(std::span<double>(data), level);
+
+    EXPECT_TRUE(std::isnan(data.front()) && std::signbit(data.front()));
+    EXPECT_TRUE(std::isnan(data[298]) && std::isnan(data[299]));
+    EXPECT_TRUE(std::is_sorted(data.begin() + 1, data.end() - 2));
+  }
+}
+
+TEST(sorting_network_tests, check_merge_moves_nans_to_the_ends) {
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  for (auto level : GetTestedLevels()) {
+    // runs as NetworkSort leaves them: -NaN first, NaN last
+    auto a = MakeSortedVector<double>(100, 7);
+    auto b = MakeSortedVector<double>(150, 8);
+    a[0] = -nan;
+    a[50] = -nan;
+    b[3] = nan;
+    b[70] = -nan;
+    b[149] = nan;
+    ppc::util::NetworkSort(std::span<double>(a), level);
+    ppc::util::NetworkSort(std::span<double>(b), level);
+
+    // in place as in the merge sorts: the left run is copied away
+    std::vector<double> data = a;
+    data.insert(data.end(), b.begin(), b.end());
+    ppc::util::NetworkMerge(std::span<const double>(a), std::span<const double>(data).subspan(a.size()), data.data(),
+                            level);
+
+    for (size_t i = 0; i < 3; i++) {
+      EXPECT_TRUE(std::isnan(data[i]) && std::signbit(data[i])) << i;
+    }
+    EXPECT_TRUE(std::isnan(data[data.size() - 2]) && !std::signbit(data[data.size() - 2]));
+    EXPECT_TRUE(std::isnan(data.back()) && !std::signbit(data.back()));
+    EXPECT_TRUE(std::is_sorted(data.begin() + 3, data.end() - 2)) << "level " << static_cast<int>(level);
+  }
+}
@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "core/util/include/gemm.hpp"
+#include "core/util/include/strassen.hpp"
+#include "core/util/include/thread_pool.hpp"
+
+namespace {
+
+std::vector<double> RandomMatrix(size_t size, unsigned seed) {
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<double> dist(-1, 1);
+  std::vector<double> matrix(size);
+  for (auto &value : matrix) {
+    value = dist(gen);
+  }
+  return matrix;
+}
+
+const ppc::util::StrassenParallelFor kPoolFor = [](size_t count, const std::function<void(size_t)> &body) {
+  ppc::util::ParallelFor(0, count, body);
+};
+
+// Strassen against Gemm for submatrices of larger arrays, sequential without
+// parallel_for
+void CheckStrassen(size_t m, size_t n, size_t k, size_t crossover,
+                   const ppc::util::StrassenParallelFor &parallel_for = {}, size_t parallel_depth = 0) {
+  const size_t lda = k + 3;
+  const size_t ldb = n + 1;
+  const size_t ldc = n + 2;
+  const auto a = RandomMatrix(m * lda, 1);
+  const auto b = RandomMatrix(k * ldb, 2);
+  std::vector<double> c(m * ldc, -7.0);
+  std::vector<double> expected(m * ldc, -7.0);
+  std::vector<double> workspace(ppc::util::GetStrassenWorkspaceSize(m, n, k, crossover, parallel_depth));
+
+  if (parallel_for) {
+    ppc::util::Strassen(m, n, k, a.data(), lda, b.data(), ldb, c.data(), ldc, workspace, parallel_for, parallel_depth,
+                        crossover);
+  } else {
+    ppc::util::Strassen(m, n, k, a.data(), lda, b.data(), ldb, c.data(), ldc, workspace, crossover);
+  }
+  ppc::util::Gemm(m, n, k, 1.0, a.data(), lda, b.data(), ldb, 0.0, expected.data(), ldc);
+
+  for (size_t i = 0; i < c.size(); i++) {
+    ASSERT_NEAR(c[i], expected[i], 1e-12 * static_cast<double>(k)) << m << "x" << n << "x" << k << " at " << i;
+  }
+}
+
+}  // namespace
+
+TEST(strassen, matches_gemm_for_powers_of_two) {
+  CheckStrassen(64, 64, 64, 8);
+  CheckStrassen(128, 128, 128, 16);
+}
+
+TEST(strassen, peels_odd_dimensions) {
+  for (const auto [m, n, k] : {std::array<size_t, 3>{65, 64, 64}, {64, 65, 64}, {64, 64, 65}, {97, 83, 101},
+                               {127, 127, 127}, {33, 7, 50}}) {
+    CheckStrassen(m, n, k, 4);
+  }
+}
+
+TEST(strassen, matches_gemm_for_rectangular_operands) {
+  CheckStrassen(40, 200, 100, 8);
+  CheckStrassen(300, 20, 60, 8);
+}
+
+TEST(strassen, leaves_small_products_to_gemm) {
+  EXPECT_EQ(ppc::util::GetStrassenWorkspaceSize(256, 256, 256, 256), 0U);
+  EXPECT_EQ(ppc::util::GetStrassenWorkspaceSize(4096, 4096, 1, 8), 0U);
+  CheckStrassen(30, 30, 30, 30);
+}
+
+TEST(strassen, workspace_shrinks_by_level) {
+  // X (n/2 x n/2) and Y (n/2 x n/2) per level, one level of each size
+  EXPECT_EQ(ppc::util::GetStrassenWorkspaceSize(64, 64, 64, 16), (2U * 32 * 32) + (2U * 16 * 16));
+  EXPECT_EQ(ppc::util::GetStrassenWorkspaceSize(65, 65, 65, 16), (2U * 32 * 32) + (2U * 16 * 16));
+}
+
+TEST(strassen, parallel_levels_match_gemm) {
+  for (size_t depth : {1, 2, 3}) {
+    CheckStrassen(128, 128, 128, 16, kPoolFor, depth);
+    CheckStrassen(97, 83, 101, 8, kPoolFor, depth);
+  }
+}
+
+TEST(strassen, parallel_leaf_is_split_into_bands) {
+  std::vector<size_t> calls;
+  const ppc::util::StrassenParallelFor recording_for = [&calls](size_t count, const std::function<void(size_t)> &body) {
+    calls.push_back(count);
+    for (size_t i = 0; i < count; i++) {
+      body(i);
+    }
+  };
+  CheckStrassen(100, 60, 60, 64, recording_for, 2);
+  EXPECT_EQ(calls, std::vector<size_t>{49});
+  EXPECT_EQ(ppc::util::GetStrassenWorkspaceSize(100, 60, 60, 64, 2), 0U);
+}
+
+TEST(strassen, parallel_depth_grows_with_threads) {
+  EXPECT_EQ(ppc::util::GetStrassenParallelDepth(1), 0U);
+  EXPECT_EQ(ppc::util::GetStrassenParallelDepth(2), 1U);
+  EXPECT_EQ(ppc::util::GetStrassenParallelDepth(7), 1U);
+  EXPECT_EQ(ppc::util::GetStrassenParallelDepth(8), 2U);
+  EXPECT_EQ(ppc::util::GetStrassenParallelDepth(49), 2U);
+  EXPECT_EQ(ppc::util::GetStrassenParallelDepth(64), 3U);
+}
+
+TEST(strassen, rejects_small_workspace) {
+  const auto a = RandomMatrix(64 * 64, 1);
+  std::vector<double> c(64 * 64);
+  std::vector<double> workspace(ppc::util::GetStrassenWorkspaceSize(64, 64, 64, 8) - 1);
+  EXPECT_THROW(ppc::util::Strassen(64, 64, 64, a.data(), 64, a.data(), 64, c.data(), 64, workspace, 8),
+               std::invalid_argument);
+}
@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstddef>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+#include "core/util/include/thread_pool.hpp"
+
+TEST(thread_pool_tests, check_parallel_for) {
+  ppc::util::ThreadPool pool(4);
+  std::vector<int> data(10000, 0);
+
+  ppc::util::ParallelFor(0, data.size(), [&](size_t i) { data[i] = static_cast<int>(i); }, 1, pool);
+
+  for (size_t i = 0; i < data.size(); i++) {
+    ASSERT_EQ(data[i], static_cast<int>(i));
+  }
+}
+
+TEST(thread_pool_tests, check_parallel_for_range_grain) {
+  ppc::util::ThreadPool pool(3);
+  std::atomic<size_t> num_chunks = 0;
+  std::atomic<size_t> num_elements = 0;
+
+  ppc::util::ParallelForRange(
+      10, 1010,
+      [&](size_t begin, size_t end) {
+        EXPECT_TRUE(end - begin >= 300 || end == 1010);
+        num_chunks++;
+        num_elements += end - begin;
+      },
+      300, pool);
+
+  EXPECT_EQ(num_chunks.load(), 4U);
+  EXPECT_EQ(num_elements.load(), 1000U);
+}
+
+TEST(thread_pool_tests, check_parallel_reduce) {
+  ppc::util::ThreadPool pool(4);
+  std::vector<long long> data(100001);
+  std::iota(data.begin(), data.end(), 0);
+
+  auto sum = ppc::util::ParallelReduce(
+      0, data.size(), 0LL,
+      [&](size_t begin, size_t end, long long init) {
+        for (size_t i = begin; i < end; i++) {
+          init += data[i];
+        }
+        return init;
+      },
+      [](long long a, long long b) { return a + b; }, 1, pool);
+
+  EXPECT_EQ(sum, 100000LL * 100001LL / 2);
+}
+
+TEST(thread_pool_tests, check_nested_task_groups) {
+  ppc::util::ThreadPool pool(4);
+  std::atomic<int> counter = 0;
+
+  ppc::util::TaskGroup outer(pool);
+  for (int i = 0; i < 8; i++) {
+    outer.Run([&] {
+      ppc::util::TaskGroup inner(pool);
+      for (int j = 0; j < 8; j++) {
+        inner.Run([&] { counter++; });
+      }
+      inner.Wait();
+    });
+  }
+  outer.Wait();
+
+  EXPECT_EQ(counter.load(), 64);
+}
+
+TEST(thread_pool_tests, check_single_thread_pool) {
+  ppc::util::ThreadPool pool(1);
+  std::vector<int> data(100, 1);
+
+  ppc::util::ParallelFor(0, data.size(), [&](size_t i) { data[i] *= 2; }, 1, pool);
+
+  EXPECT_EQ(std::accumulate(data.begin(), data.end(), 0), 200);
+}
+
+TEST(thread_pool_tests, check_exception_propagation) {
+  ppc::util::ThreadPool pool(2);
+
+  ppc::util::TaskGroup group(pool);
+  group.Run([] { throw std::runtime_error("task failed"); });
+  group.Run([] {});
+
+  EXPECT_THROW(group.Wait(), std::runtime_error);
+}
+
+TEST(thread_pool_tests, check_pinned_pool) {
+  ppc::util::ThreadPool pool(2, ppc::util::Placement::kCompact);
+  std::atomic<int> counter = 0;
+
+  ppc::util::ParallelFor(0, 1000, [&](size_t) { counter++; }, 1, pool);
+
+  EXPECT_EQ(counter.load(), 1000);
+}
+
+TEST(thread_pool_tests, check_instance) {
+  auto &pool = ppc::util::ThreadPool::Instance();
+  EXPECT_GE(pool.GetNumThreads(), 1);
+  EXPECT_EQ(&pool, &ppc::util::ThreadPool::Instance());
+}
@@ -0,0 +1,69 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <set>
+#include <utility>
+
+#include "core/util/include/topology.hpp"
+
+TEST(topology_tests, check_topology) {
+  const auto &topology = ppc::util::GetTopology();
+
+  ASSERT_FALSE(topology.cpus.empty());
+  EXPECT_GE(topology.num_physical_cores, 1);
+  EXPECT_LE(topology.num_physical_cores, static_cast<int>(topology.cpus.size()));
+  EXPECT_GE(topology.num_packages, 1);
+  EXPECT_GE(topology.num_numa_nodes, 1);
+}
+
+TEST(topology_tests, check_parse_placement) {
+  EXPECT_EQ(ppc::util::ParsePlacement("compact"), ppc::util::Placement::kCompact);
+  EXPECT_EQ(ppc::util::ParsePlacement("scatter"), ppc::util::Placement::kScatter);
+  EXPECT_EQ(ppc::util::ParsePlacement("numa"), ppc::util::Placement::kNumaLocal);
+  EXPECT_EQ(ppc::util::ParsePlacement("none"), ppc::util::Placement::kNone);
+  EXPECT_EQ(ppc::util::ParsePlacement("unknown"), ppc::util::Placement::kNone);
+}
+
+TEST(topology_tests, check_placement_cpus) {
+  const auto &topology = ppc::util::GetTopology();
+  const int num_threads = static_cast<int>(topology.cpus.size()) + 2;
+
+  EXPECT_TRUE(ppc::util::GetPlacementCpus(num_threads, ppc::util::Placement::kNone).empty());
+  for (auto placement : {ppc::util::Placement::kCompact, ppc::util::Placement::kScatter,
+                         ppc::util::Placement::kNumaLocal}) {
+    auto cpus = ppc::util::GetPlacementCpus(num_threads, placement);
+    ASSERT_EQ(cpus.size(), static_cast<size_t>(num_threads));
+    for (int cpu : cpus) {
+      EXPECT_TRUE(std::ranges::any_of(topology.cpus, [cpu](const auto &c) { return c.id == cpu; }));
+    }
+  }
+}
+
+TEST(topology_tests, check_scatter_uses_distinct_cores) {
+  const auto &topology = ppc::util::GetTopology();
+
+  auto cpus = ppc::util::GetPlacementCpus(topology.num_physical_cores, ppc::util::Placement::kScatter);
+
+  std::set<std::pair<int, int>> cores;
+  for (int cpu : cpus) {
+    for (const auto &c : topology.cpus) {
+      if (c.id == cpu) {
+        cores.emplace(c.package_id, c.core_id);
+      }
+    }
+  }
+  EXPECT_EQ(cores.size(), static_cast<size_t>(topology.num_physical_cores));
+}
+
+TEST(topology_tests, check_pin_current_thread) {
+#ifdef __linux__
+  EXPECT_TRUE(ppc::util::PinCurrentThread(0, 1, ppc::util::Placement::kCompact));
+#endif
+  EXPECT_FALSE(ppc::util::PinCurrentThread(0, 1, ppc::util::Placement::kNone));
+}
+
+TEST(topology_tests, check_pin_worker_thread_keeps_master_affinity) {
+  EXPECT_FALSE(ppc::util::PinWorkerThread(0));
+  EXPECT_FALSE(ppc::util::PinWorkerThread(-1));
+}
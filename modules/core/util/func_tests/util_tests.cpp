@@ -1,20 +1,29 @@
 #include <gtest/gtest.h>
 
 #include <cstdlib>
+#include <memory>
 #include <string>
 #include <thread>
 
+#include "core/util/include/topology.hpp"
 #include "core/util/include/util.hpp"
 
 TEST(util_tests, check_unset_env) {
 #ifndef _WIN32
-  int save_var = ppc::util::GetPPCNumThreads();
+  const std::string save_omp = ppc::util::GetEnvVar("OMP_NUM_THREADS");
+  const std::string save_ppc = ppc::util::GetEnvVar("PPC_NUM_THREADS");
 
   unsetenv("OMP_NUM_THREADS");  // NOLINT(misc-include-cleaner)
+  unsetenv("PPC_NUM_THREADS");  // NOLINT(misc-include-cleaner)
 
-  EXPECT_EQ(ppc::util::GetPPCNumThreads(), 1);
+  EXPECT_EQ(ppc::util::GetPPCNumThreads(), ppc::util::GetTopology().num_physical_cores);
 
-  setenv("OMP_NUM_THREADS", std::to_string(save_var).c_str(), 1);  // NOLINT(misc-include-cleaner)
+  if (!save_omp.empty()) {
+    setenv("OMP_NUM_THREADS", save_omp.c_str(), 1);  // NOLINT(misc-include-cleaner)
+  }
+  if (!save_ppc.empty()) {
+    setenv("PPC_NUM_THREADS", save_ppc.c_str(), 1);  // NOLINT(misc-include-cleaner)
+  }
 #else
   GTEST_SKIP();
 #endif
@@ -23,6 +32,8 @@ TEST(util_tests, check_unset_env) {
 TEST(util_tests, check_set_env) {
 #ifndef _WIN32
   int save_var = ppc::util::GetPPCNumThreads();
+  const std::string save_ppc = ppc::util::GetEnvVar("PPC_NUM_THREADS");
+  unsetenv("PPC_NUM_THREADS");  // NOLINT(misc-include-cleaner)
 
   const int num_threads = static_cast<int>(std::thread::hardware_concurrency());
   setenv("OMP_NUM_THREADS", std::to_string(num_threads).c_str(), 1);  // NOLINT(misc-include-cleaner)
@@ -30,7 +41,48 @@ TEST(util_tests, check_set_env) {
   EXPECT_EQ(ppc::util::GetPPCNumThreads(), num_threads);
 
   setenv("OMP_NUM_THREADS", std::to_string(save_var).c_str(), 1);  // NOLINT(misc-include-cleaner)
+  if (!save_ppc.empty()) {
+    setenv("PPC_NUM_THREADS", save_ppc.c_str(), 1);  // NOLINT(misc-include-cleaner)
+  }
 #else
   GTEST_SKIP();
 #endif
 }
+
+TEST(util_tests, check_ppc_env_overrides_omp_env) {
+#ifndef _WIN32
+  const std::string save_omp = ppc::util::GetEnvVar("OMP_NUM_THREADS");
+  const std::string save_ppc = ppc::util::GetEnvVar("PPC_NUM_THREADS");
+
+  setenv("OMP_NUM_THREADS", "3", 1);  // NOLINT(misc-include-cleaner)
+  setenv("PPC_NUM_THREADS", "5", 1);  // NOLINT(misc-include-cleaner)
+
+  EXPECT_EQ(ppc::util::GetPPCNumThreads(), 5);
+
+  setenv("OMP_NUM_THREADS", save_omp.c_str(), 1);  // NOLINT(misc-include-cleaner)
+  if (save_ppc.empty()) {
+    unsetenv("PPC_NUM_THREADS");  // NOLINT(misc-include-cleaner)
+  } else {
+    setenv("PPC_NUM_THREADS", save_ppc.c_str(), 1);  // NOLINT(misc-include-cleaner)
+  }
+  if (save_omp.empty()) {
+    unsetenv("OMP_NUM_THREADS");  // NOLINT(misc-include-cleaner)
+  }
+#else
+  GTEST_SKIP();
+#endif
+}
+
+TEST(util_tests, check_set_ppc_num_threads_notifies_observers) {
+  const std::string save_ppc = ppc::util::GetEnvVar("PPC_NUM_THREADS");
+  // observers live until the end of the process
+  auto notified = std::make_shared<int>(0);
+  ppc::util::AddNumThreadsObserver([notified](int num_threads) { *notified = num_threads; });
+
+  ppc::util::SetPPCNumThreads(3);
+  EXPECT_EQ(ppc::util::GetPPCNumThreads(), 3);
+  EXPECT_EQ(*notified, 3);
+
+  ppc::util::SetPPCNumThreads(save_ppc.empty() ? 0 : std::stoi(save_ppc));
+  EXPECT_EQ(*notified, ppc::util::GetPPCNumThreads());
+}
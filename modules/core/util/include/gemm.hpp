@@ -0,0 +1,106 @@
+#pragma once
+
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <vector>
+
+#include "core/util/include/simd.hpp"
+
+namespace ppc::util {
+
+// Cache blocking of Gemm (GotoBLAS / BLIS loop order): a kc x nc panel of B is
+// packed for L3, an mc x kc block of A for L2, and the kc x nr sliver of B a
+// micro-kernel call streams stays in L1. Zero fields are derived from the
+// cache sizes of GetTopology().
+struct GemmBlocking {
+  size_t mc = 0;
+  size_t nc = 0;
+  size_t kc = 0;
+};
+
+// Tuning of a Gemm call
+struct GemmOptions {
+  GemmBlocking blocking;
+  // lowered to the CPU support, scalar if the CPU has no FMA
+  SimdLevel level = GetSimdLevel();
+  // Without fused multiply-add every product is rounded before it is added,
+  // as in a plain loop: for k <= kc and zero C the result is then bitwise
+  // that of the triple loop summing in k order
+  bool fused = true;
+};
+
+// Blocking Gemm uses for elements of element_size bytes and an mr x nr
+// micro-kernel, with the zero fields of requested filled in
+GemmBlocking GetGemmBlocking(size_t element_size, size_t mr, size_t nr, GemmBlocking requested = {});
+
+// C = alpha * A * B + beta * C for row-major A (m x k), B (k x n) and C
+// (m x n) with leading dimensions (row strides) lda, ldb and ldc. A and B are
+// packed into contiguous panels and multiplied by a register-tile FMA
+// micro-kernel. With beta == 0 C is not read. Not thread-parallel: callers
+// split C into tiles for their backend; concurrent calls are safe.
+void Gemm(size_t m, size_t n, size_t k, double alpha, const double *a, size_t lda, const double *b, size_t ldb,
+          double beta, double *c, size_t ldc, const GemmOptions &options = {});
+void Gemm(size_t m, size_t n, size_t k, float alpha, const float *a, size_t lda, const float *b, size_t ldb, float beta,
+          float *c, size_t ldc, const GemmOptions &options = {});
+// Complex products go through four real products of the split real and
+// imaginary parts (4M method), so they use the double micro-kernel
+void Gemm(size_t m, size_t n, size_t k, std::complex<double> alpha, const std::complex<double> *a, size_t lda,
+          const std::complex<double> *b, size_t ldb, std::complex<double> beta, std::complex<double> *c, size_t ldc,
+          const GemmOptions &options = {});
+
+// One product C = alpha * op(A) * op(B) + beta * C of a batch: op(A) is
+// m x k and op(B) k x n, read from the row-major a and b as stored or
+// transposed. A transposed A is stored k x m, so lda is at least m then.
+struct GemmProblem {
+  size_t m = 0;
+  size_t n = 0;
+  size_t k = 0;
+  double alpha = 1.0;
+  const double *a = nullptr;
+  size_t lda = 0;
+  bool transpose_a = false;
+  const double *b = nullptr;
+  size_t ldb = 0;
+  bool transpose_b = false;
+  double beta = 0.0;
+  double *c = nullptr;
+  size_t ldc = 0;
+};
+
+// Loop of the caller's backend: parallel_for(count, body) calls body(i) for
+// every i in [0, count) and returns when all calls are done
+using GemmParallelFor = std::function<void(size_t, const std::function<void(size_t)> &)>;
+
+// Rectangular product with transposed operands; the transposition is done
+// while A and B are packed, so it costs no extra pass
+void Gemm(const GemmProblem &problem, const GemmOptions &options = {});
+
+// Independent products of any shapes on the caller's backend. Small products
+// are one task each, large ones are split into bands of rows of C, so one
+// big product alone still uses all threads. The C blocks of the batch must
+// not overlap.
+void GemmBatched(std::span<const GemmProblem> batch, const GemmParallelFor &parallel_for,
+                 const GemmOptions &options = {});
+
+// GemmBatched whose calling thread also calls progress() before and after
+// every task it runs itself, e.g. to poll the MPI requests of transfers that
+// overlap the products. The tasks keep the size GemmBatched gives them.
+void GemmBatchedWithProgress(std::span<const GemmProblem> batch, const GemmParallelFor &parallel_for,
+                             const std::function<void()> &progress, const GemmOptions &options = {});
+
+// Which A block a block row multiplies in a stage of a block algorithm
+enum class BlockSchedule : uint8_t { kCannon, kFox };
+
+// Block products of one stage of Cannon's or Fox's algorithm in shared memory
+// on row-major n x n matrices cut into blocks of block_size (the last ones cut
+// at n), ready for GemmBatched: C (i, j) += A (i, k) * B (k, j) with
+// k = (i + j + stage) mod q for Cannon, the blocks its skew and shifts bring
+// together, or k = (i + stage) mod q for Fox, the A block broadcast along
+// block row i. Stages 0 to q - 1, q = ceil(n / block_size), add up to A * B.
+std::vector<GemmProblem> BlockStageBatch(const double *a, const double *b, double *c, size_t n, size_t block_size,
+                                         size_t stage, BlockSchedule schedule);
+
+}  // namespace ppc::util
@@ -0,0 +1,191 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <functional>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace ppc::util {
+
+// Tournament tree over k sorted runs: every node keeps the loser of the match
+// played there, so replacing the winner costs log2(k) comparisons along one
+// path. Equal elements are taken from the run with the lower index first.
+template <typename T, typename Compare = std::less<>>
+class LoserTree {
+ public:
+  explicit LoserTree(const std::vector<std::span<const T>> &runs, Compare comp = {})
+      : comp_(std::move(comp)), num_leaves_(std::bit_ceil(std::max<size_t>(runs.size(), 1))) {
+    heads_.resize(num_leaves_, nullptr);
+    ends_.resize(num_leaves_, nullptr);
+    for (size_t i = 0; i < runs.size(); i++) {
+      heads_[i] = runs[i].data();
+      ends_[i] = runs[i].data() + runs[i].size();
+    }
+    tree_.resize(num_leaves_);
+    tree_[0] = Build(1);
+  }
+
+  [[nodiscard]] bool Empty() const { return Exhausted(tree_[0]); }
+
+  // Smallest head element, the tree must not be empty
+  [[nodiscard]] const T &Top() const { return *heads_[tree_[0]]; }
+
+  // Index of the run Top() belongs to
+  [[nodiscard]] size_t TopRun() const { return tree_[0]; }
+
+  void Pop() {
+    size_t winner = tree_[0];
+    ++heads_[winner];
+    for (size_t node = (winner + num_leaves_) / 2; node >= 1; node /= 2) {
+      if (Less(tree_[node], winner)) {
+        std::swap(tree_[node], winner);
+      }
+    }
+    tree_[0] = winner;
+  }
+
+ private:
+  Compare comp_;
+  size_t num_leaves_;
+  std::vector<const T *> heads_;
+  std::vector<const T *> ends_;
+  // tree_[0] is the overall winner, tree_[1..num_leaves_) the losers of the inner nodes
+  std::vector<size_t> tree_;
+
+  [[nodiscard]] bool Exhausted(size_t run) const { return heads_[run] == ends_[run]; }
+
+  // Exhausted runs lose every match
+  [[nodiscard]] bool Less(size_t a, size_t b) const {
+    if (Exhausted(a)) {
+      return false;
+    }
+    if (Exhausted(b)) {
+      return true;
+    }
+    if (comp_(*heads_[a], *heads_[b])) {
+      return true;
+    }
+    if (comp_(*heads_[b], *heads_[a])) {
+      return false;
+    }
+    return a < b;
+  }
+
+  size_t Build(size_t node) {
+    if (node >= num_leaves_) {
+      return node - num_leaves_;
+    }
+    const size_t left = Build(2 * node);
+    const size_t right = Build((2 * node) + 1);
+    if (Less(right, left)) {
+      tree_[node] = left;
+      return right;
+    }
+    tree_[node] = right;
+    return left;
+  }
+};
+
+// Stable merge of all runs to out in one pass, returns the end of the output
+template <typename T, typename Compare = std::less<>>
+T *MultiwayMerge(const std::vector<std::span<const T>> &runs, T *out, Compare comp = {}) {
+  if (runs.empty()) {
+    return out;
+  }
+  if (runs.size() == 1) {
+    return std::ranges::copy(runs[0], out).out;
+  }
+  if (runs.size() == 2) {
+    return std::ranges::merge(runs[0], runs[1], out, comp).out;
+  }
+  LoserTree<T, Compare> tree(runs, comp);
+  while (!tree.Empty()) {
+    *out++ = tree.Top();
+    tree.Pop();
+  }
+  return out;
+}
+
+// Split positions of the runs such that runs[i][0, split[i]) together are the
+// first rank elements of the stable merge of the runs
+template <typename T, typename Compare = std::less<>>
+std::vector<size_t> MultiwaySplit(const std::vector<std::span<const T>> &runs, size_t rank, Compare comp = {}) {
+  std::vector<size_t> split(runs.size());
+  size_t total = 0;
+  for (size_t i = 0; i < runs.size(); i++) {
+    split[i] = runs[i].size();
+    total += runs[i].size();
+  }
+  if (rank >= total) {
+    return split;
+  }
+
+  // Position of x in run j of the stable merge order when x comes from run i
+  auto bound = [&](size_t j, size_t i, const T &x) {
+    const auto it = j < i ? std::upper_bound(runs[j].begin(), runs[j].end(), x, comp)
+                          : std::lower_bound(runs[j].begin(), runs[j].end(), x, comp);
+    return static_cast<size_t>(it - runs[j].begin());
+  };
+  // Number of elements before runs[i][p] in the merge
+  auto merge_rank = [&](size_t i, size_t p) {
+    size_t result = p;
+    for (size_t j = 0; j < runs.size(); j++) {
+      if (j != i) {
+        result += bound(j, i, runs[i][p]);
+      }
+    }
+    return result;
+  };
+
+  // Exactly one run holds the element of merge rank `rank`
+  for (size_t i = 0; i < runs.size(); i++) {
+    size_t low = 0;
+    size_t high = runs[i].size();
+    while (low < high) {
+      const size_t middle = low + ((high - low) / 2);
+      if (merge_rank(i, middle) < rank) {
+        low = middle + 1;
+      } else {
+        high = middle;
+      }
+    }
+    if (low < runs[i].size() && merge_rank(i, low) == rank) {
+      for (size_t j = 0; j < runs.size(); j++) {
+        split[j] = j == i ? low : bound(j, i, runs[i][low]);
+      }
+      return split;
+    }
+  }
+  return split;
+}
+
+// Part `part` of num_parts equal parts of the merged output: writes the
+// elements [total * part / num_parts, total * (part + 1) / num_parts) of the
+// stable merge to the same positions of out. Parts are independent, so
+// calling this for every part from different threads merges in parallel.
+template <typename T, typename Compare = std::less<>>
+void MultiwayMergePart(const std::vector<std::span<const T>> &runs, T *out, size_t part, size_t num_parts,
+                       Compare comp = {}) {
+  size_t total = 0;
+  for (const auto &run : runs) {
+    total += run.size();
+  }
+  const size_t begin = total * part / num_parts;
+  const size_t end = total * (part + 1) / num_parts;
+  if (begin == end) {
+    return;
+  }
+  const auto first = MultiwaySplit(runs, begin, comp);
+  const auto last = MultiwaySplit(runs, end, comp);
+  std::vector<std::span<const T>> parts;
+  parts.reserve(runs.size());
+  for (size_t i = 0; i < runs.size(); i++) {
+    parts.push_back(runs[i].subspan(first[i], last[i] - first[i]));
+  }
+  MultiwayMerge(parts, out + begin, comp);
+}
+
+}  // namespace ppc::util
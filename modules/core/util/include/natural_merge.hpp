@@ -0,0 +1,197 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <span>
+#include <vector>
+
+namespace ppc::util {
+
+// Natural runs need to be this long on average for AdaptiveSort to merge them
+// instead of calling the fallback sort
+constexpr size_t kMinAverageNaturalRun = 256;
+
+// AdaptiveSort sorts the elements out of order separately while they are at
+// most one in this many
+constexpr size_t kMaxDisplacedFraction = 8;
+
+// Longest run of too large elements AdaptiveSort takes out of the ordered
+// part to keep the element after them
+constexpr size_t kMaxDisplacedSpike = 8;
+
+// Boundaries of the maximal non-descending runs of data: run i is
+// [bounds[i], bounds[i + 1]). Strictly descending runs are reversed in place
+// first, so they count as one run. Returns an empty vector as soon as there
+// are more than max_runs runs.
+template <typename T, typename Compare = std::less<>>
+std::vector<size_t> FindNaturalRuns(std::span<T> data, Compare comp = {},
+                                    size_t max_runs = std::numeric_limits<size_t>::max()) {
+  std::vector<size_t> bounds = {0};
+  const size_t size = data.size();
+  size_t begin = 0;
+  while (begin < size) {
+    if (bounds.size() > max_runs) {
+      return {};
+    }
+    size_t end = begin + 1;
+    if (end < size && comp(data[end], data[end - 1])) {
+      while (end < size && comp(data[end], data[end - 1])) {
+        end++;
+      }
+      std::reverse(data.begin() + static_cast<std::ptrdiff_t>(begin), data.begin() + static_cast<std::ptrdiff_t>(end));
+    }
+    while (end < size && !comp(data[end], data[end - 1])) {
+      end++;
+    }
+    bounds.push_back(end);
+    begin = end;
+  }
+  return bounds;
+}
+
+namespace detail {
+
+// Stable merge of the sorted neighbours [begin, mid) and [mid, end). Elements
+// already in place at both ends are skipped, the shorter of the remaining
+// parts goes through the buffer.
+template <typename T, typename Compare>
+void MergeAdjacentRuns(T *data, size_t begin, size_t mid, size_t end, std::vector<T> &buffer, Compare &comp) {
+  if (begin == mid || mid == end || !comp(data[mid], data[mid - 1])) {
+    return;
+  }
+  begin = static_cast<size_t>(std::upper_bound(data + begin, data + mid, data[mid], comp) - data);
+  end = static_cast<size_t>(std::lower_bound(data + mid, data + end, data[mid - 1], comp) - data);
+  if (mid - begin <= end - mid) {
+    buffer.assign(data + begin, data + mid);
+    size_t i = 0;
+    size_t j = mid;
+    size_t out = begin;
+    while (i < buffer.size() && j < end) {
+      data[out++] = comp(data[j], buffer[i]) ? data[j++] : buffer[i++];
+    }
+    std::copy(buffer.begin() + static_cast<std::ptrdiff_t>(i), buffer.end(), data + out);
+  } else {
+    buffer.assign(data + mid, data + end);
+    size_t i = mid;
+    size_t j = buffer.size();
+    size_t out = end;
+    while (i > begin && j > 0) {
+      data[--out] = comp(buffer[j - 1], data[i - 1]) ? data[--i] : buffer[--j];
+    }
+    std::copy(buffer.begin(), buffer.begin() + static_cast<std::ptrdiff_t>(j), data + begin);
+  }
+}
+
+// Depth of the boundary between runs [begin1, begin2) and [begin2, end2) in
+// the perfectly balanced merge tree over size elements (Munro and Wild)
+inline int NodePower(size_t size, size_t begin1, size_t begin2, size_t end2) {
+  size_t a = begin1 + begin2;
+  size_t b = begin2 + end2;
+  int power = 0;
+  while (true) {
+    power++;
+    if (a >= size) {
+      a -= size;
+      b -= size;
+    } else if (b >= size) {
+      return power;
+    }
+    a <<= 1;
+    b <<= 1;
+  }
+}
+
+}  // namespace detail
+
+// Stable merge of the sorted runs given by bounds (as returned by
+// FindNaturalRuns) in powersort order: neighbouring runs are merged as soon as
+// their boundary is deeper than the next one, which keeps the merges balanced
+// by size and costs O(n (1 + H)) for run length entropy H
+template <typename T, typename Compare = std::less<>>
+void MergeNaturalRuns(std::span<T> data, const std::vector<size_t> &bounds, Compare comp = {}) {
+  struct Run {
+    size_t begin;
+    size_t end;
+    int power;
+  };
+  std::vector<Run> stack;
+  std::vector<T> buffer;
+  const auto merge_top = [&] {
+    const Run right = stack.back();
+    stack.pop_back();
+    detail::MergeAdjacentRuns(data.data(), stack.back().begin, right.begin, right.end, buffer, comp);
+    stack.back().end = right.end;
+  };
+  for (size_t i = 0; i + 1 < bounds.size(); i++) {
+    const Run run = {.begin = bounds[i], .end = bounds[i + 1], .power = 0};
+    if (!stack.empty()) {
+      const int power = detail::NodePower(data.size(), stack.back().begin, run.begin, run.end);
+      while (stack.size() > 1 && stack[stack.size() - 2].power > power) {
+        merge_top();
+      }
+      stack.back().power = power;
+    }
+    stack.push_back(run);
+  }
+  while (stack.size() > 1) {
+    merge_top();
+  }
+}
+
+// Sort with a fast path for partially ordered data. Inputs made of a few long
+// ascending or descending runs are merged (linear for sorted or reversed
+// data); inputs with few elements out of place (late arrivals, isolated
+// spikes) have those extracted, sorted by fallback and merged back. Anything
+// else is sorted by fallback(std::span<T>) as a whole. Not stable.
+template <typename T, typename Fallback, typename Compare = std::less<>>
+void AdaptiveSort(std::span<T> data, Fallback &&fallback, Compare comp = {}) {
+  const size_t size = data.size();
+  if (size < 2) {
+    return;
+  }
+  const auto bounds = FindNaturalRuns(data, comp, std::max<size_t>(size / kMinAverageNaturalRun, 2));
+  if (!bounds.empty()) {
+    MergeNaturalRuns(data, bounds, comp);
+    return;
+  }
+
+  // Greedy ascending subsequence compacted to the front: an element below the
+  // last kept ones is displaced, unless it only undercuts up to
+  // kMaxDisplacedSpike kept elements, which are then displaced instead
+  const size_t max_displaced = size / kMaxDisplacedFraction;
+  std::vector<T> displaced;
+  size_t kept = 0;
+  size_t next = 0;
+  for (; next < size && displaced.size() <= max_displaced; next++) {
+    const T value = data[next];
+    size_t fit = kept;
+    while (fit > 0 && kept - fit <= kMaxDisplacedSpike && comp(value, data[fit - 1])) {
+      fit--;
+    }
+    if (kept - fit <= kMaxDisplacedSpike) {
+      displaced.insert(displaced.end(), data.begin() + static_cast<std::ptrdiff_t>(fit),
+                       data.begin() + static_cast<std::ptrdiff_t>(kept));
+      data[fit] = value;
+      kept = fit + 1;
+    } else {
+      displaced.push_back(value);
+    }
+  }
+  if (next < size) {
+    std::copy(displaced.begin(), displaced.end(), data.begin() + static_cast<std::ptrdiff_t>(kept));
+    fallback(data);
+    return;
+  }
+
+  fallback(std::span<T>(displaced));
+  size_t i = kept;
+  size_t j = displaced.size();
+  size_t out = size;
+  while (j > 0) {
+    data[--out] = i > 0 && comp(displaced[j - 1], data[i - 1]) ? data[--i] : displaced[--j];
+  }
+}
+
+}  // namespace ppc::util
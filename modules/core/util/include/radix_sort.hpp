@@ -0,0 +1,267 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "core/util/include/thread_pool.hpp"
+
+namespace ppc::util {
+
+// Order-preserving map of 4- and 8-byte keys to unsigned integers: the sign bit
+// of signed integers is flipped, negative floating point values are inverted,
+// so -NaN < -inf < ... < -0.0 < 0.0 < ... < inf < NaN
+template <typename Key>
+  requires(std::is_arithmetic_v<Key> && (sizeof(Key) == 4 || sizeof(Key) == 8))
+struct RadixKeyTraits {
+  using Bits = std::conditional_t<sizeof(Key) == 4, uint32_t, uint64_t>;
+  static constexpr Bits kSignBit = Bits{1} << ((sizeof(Bits) * 8) - 1);
+
+  static Bits ToBits(Key key) {
+    const auto bits = std::bit_cast<Bits>(key);
+    if constexpr (std::is_floating_point_v<Key>) {
+      return (bits & kSignBit) != 0 ? ~bits : bits | kSignBit;
+    } else if constexpr (std::is_signed_v<Key>) {
+      return bits ^ kSignBit;
+    } else {
+      return bits;
+    }
+  }
+
+  static Key FromBits(Bits bits) {
+    if constexpr (std::is_floating_point_v<Key>) {
+      return std::bit_cast<Key>((bits & kSignBit) != 0 ? bits ^ kSignBit : ~bits);
+    } else if constexpr (std::is_signed_v<Key>) {
+      return std::bit_cast<Key>(bits ^ kSignBit);
+    } else {
+      return bits;
+    }
+  }
+};
+
+// Digit width of an LSD radix sort of size keys of key_bits bits: 8, 11 or 16.
+// Wider digits save passes once the input amortizes their histograms and the
+// scatter targets (a cache line per digit) still fit in L2 (11 bits) or L3
+// (16 bits) of the machine.
+int RadixDigitBits(size_t size, int key_bits);
+
+constexpr int RadixNumPasses(int key_bits, int digit_bits) { return (key_bits + digit_bits - 1) / digit_bits; }
+
+// Digit counts of bits[begin, end) for the digit at shift, counts must hold
+// 1 << digit_bits entries
+template <typename Bits>
+void RadixCount(const Bits *bits, size_t begin, size_t end, int shift, int digit_bits, size_t *counts) {
+  const Bits mask = (Bits{1} << digit_bits) - 1;
+  std::fill_n(counts, size_t{1} << digit_bits, 0);
+  for (size_t i = begin; i < end; i++) {
+    ++counts[(bits[i] >> shift) & mask];
+  }
+}
+
+// Digit counts of every pass over bits[begin, end) in a single sweep:
+// counts[(pass << digit_bits) + digit] is incremented, counts must hold
+// RadixNumPasses(...) << digit_bits entries
+template <typename Bits>
+void RadixCountAll(const Bits *bits, size_t begin, size_t end, int digit_bits, size_t *counts) {
+  constexpr int kKeyBits = sizeof(Bits) * 8;
+  const int num_passes = RadixNumPasses(kKeyBits, digit_bits);
+  const Bits mask = (Bits{1} << digit_bits) - 1;
+  for (size_t i = begin; i < end; i++) {
+    const Bits value = bits[i];
+    for (int pass = 0; pass < num_passes; pass++) {
+      ++counts[(static_cast<size_t>(pass) << digit_bits) + ((value >> (pass * digit_bits)) & mask)];
+    }
+  }
+}
+
+// True if one digit of the pass counts holds all size keys: the pass would
+// only copy the data
+inline bool RadixPassIsConstant(const size_t *pass_counts, int digit_bits, size_t size) {
+  const size_t *end = pass_counts + (size_t{1} << digit_bits);
+  return std::find(pass_counts, end, size) != end;
+}
+
+namespace detail {
+
+// Chunks smaller than this are not worth a task of their own
+constexpr size_t kRadixMinChunk = size_t{1} << 14;
+
+// Moves keys and payloads of [begin, end) to position index[digit] of the
+// destination. Up to 2048 digits a cache line of keys is staged per digit, so
+// every digit is written in full lines instead of one scattered store per
+// element; wider digits are scattered directly.
+template <typename Bits, typename Payload>
+void RadixScatter(const Bits *src_bits, const Payload *src_payloads, Bits *dst_bits, Payload *dst_payloads,
+                  size_t begin, size_t end, std::vector<size_t> index, int shift, int digit_bits) {
+  const size_t num_digits = size_t{1} << digit_bits;
+  const Bits mask = static_cast<Bits>(num_digits - 1);
+  const size_t stage = num_digits <= 2048 ? 64 / sizeof(Bits) : 1;
+  std::vector<Bits> staged_bits(num_digits * stage);
+  std::vector<Payload> staged_payloads(num_digits * stage);
+  std::vector<size_t> filled(num_digits);
+
+  const auto flush = [&](size_t digit, size_t count) {
+    std::copy_n(staged_bits.data() + (digit * stage), count, dst_bits + index[digit]);
+    std::copy_n(staged_payloads.data() + (digit * stage), count, dst_payloads + index[digit]);
+    index[digit] += count;
+  };
+  for (size_t i = begin; i < end; i++) {
+    const size_t digit = (src_bits[i] >> shift) & mask;
+    const size_t slot = (digit * stage) + filled[digit];
+    staged_bits[slot] = src_bits[i];
+    staged_payloads[slot] = src_payloads[i];
+    if (++filled[digit] == stage) {
+      flush(digit, stage);
+      filled[digit] = 0;
+    }
+  }
+  for (size_t digit = 0; digit < num_digits; digit++) {
+    flush(digit, filled[digit]);
+  }
+}
+
+// Stable LSD sort of bits with payloads moved along. The digit counts of all
+// passes are taken in one sweep and passes with a constant digit are skipped.
+// Every chunk of the pool keeps the same contiguous block in all passes; once
+// the data is permuted the chunks hold other keys, so with several chunks a
+// pass after the first executed one counts its own digit per chunk again.
+template <typename Bits, typename Payload>
+void RadixSortBits(std::vector<Bits> &bits, std::span<Payload> payloads, ThreadPool &pool) {
+  constexpr int kKeyBits = sizeof(Bits) * 8;
+  const size_t size = bits.size();
+  const int digit_bits = RadixDigitBits(size, kKeyBits);
+  const int num_passes = RadixNumPasses(kKeyBits, digit_bits);
+  const size_t num_digits = size_t{1} << digit_bits;
+  const size_t num_chunks =
+      std::clamp<size_t>(size / kRadixMinChunk, 1, static_cast<size_t>(std::max(pool.GetNumThreads(), 1)));
+  const auto chunk_begin = [&](size_t chunk) { return size * chunk / num_chunks; };
+
+  std::vector<std::vector<size_t>> counts(num_chunks, std::vector<size_t>(num_passes * num_digits));
+  ParallelFor(
+      0, num_chunks,
+      [&](size_t chunk) {
+        RadixCountAll(bits.data(), chunk_begin(chunk), chunk_begin(chunk + 1), digit_bits, counts[chunk].data());
+      },
+      1, pool);
+
+  std::vector<Bits> bits_buffer;
+  std::vector<Payload> payload_buffer;
+  Bits *src_bits = bits.data();
+  Payload *src_payloads = payloads.data();
+  std::vector<size_t> totals(num_digits);
+  std::vector<std::vector<size_t>> offsets(num_chunks, std::vector<size_t>(num_digits));
+  for (int pass = 0; pass < num_passes; pass++) {
+    const size_t pass_offset = static_cast<size_t>(pass) * num_digits;
+    std::ranges::fill(totals, 0);
+    for (const auto &chunk_counts : counts) {
+      for (size_t digit = 0; digit < num_digits; digit++) {
+        totals[digit] += chunk_counts[pass_offset + digit];
+      }
+    }
+    if (RadixPassIsConstant(totals.data(), digit_bits, size)) {
+      continue;
+    }
+    if (num_chunks > 1 && !bits_buffer.empty()) {
+      ParallelFor(
+          0, num_chunks,
+          [&](size_t chunk) {
+            RadixCount(src_bits, chunk_begin(chunk), chunk_begin(chunk + 1), pass * digit_bits, digit_bits,
+                       counts[chunk].data() + pass_offset);
+          },
+          1, pool);
+    }
+    // digits in order, chunks in order within a digit, so the scatter is stable
+    size_t sum = 0;
+    for (size_t digit = 0; digit < num_digits; digit++) {
+      for (size_t chunk = 0; chunk < num_chunks; chunk++) {
+        offsets[chunk][digit] = sum;
+        sum += counts[chunk][pass_offset + digit];
+      }
+    }
+    if (bits_buffer.empty()) {
+      bits_buffer.resize(size);
+      payload_buffer.resize(size);
+    }
+    Bits *dst_bits = src_bits == bits.data() ? bits_buffer.data() : bits.data();
+    Payload *dst_payloads = src_payloads == payloads.data() ? payload_buffer.data() : payloads.data();
+    ParallelFor(
+        0, num_chunks,
+        [&](size_t chunk) {
+          RadixScatter(src_bits, src_payloads, dst_bits, dst_payloads, chunk_begin(chunk), chunk_begin(chunk + 1),
+                       offsets[chunk], pass * digit_bits, digit_bits);
+        },
+        1, pool);
+    src_bits = dst_bits;
+    src_payloads = dst_payloads;
+  }
+
+  if (src_bits != bits.data()) {
+    ParallelForRange(
+        0, size,
+        [&](size_t begin, size_t end) {
+          std::copy(src_bits + begin, src_bits + end, bits.data() + begin);
+          std::copy(src_payloads + begin, src_payloads + end, payloads.data() + begin);
+        },
+        1, pool);
+  }
+}
+
+}  // namespace detail
+
+// Stable sort of keys with payloads[i] moved along with keys[i]. Parallel LSD
+// radix sort with the same per-chunk histogram and write-combining scatter as
+// the radix tasks; payloads of equal keys keep their order.
+template <typename Key, typename Payload>
+  requires std::is_trivially_copyable_v<Payload>
+void RadixSortPairs(std::span<Key> keys, std::span<Payload> payloads, ThreadPool &pool = ThreadPool::Instance()) {
+  using Traits = RadixKeyTraits<Key>;
+  if (keys.size() != payloads.size()) {
+    throw std::invalid_argument("RadixSortPairs: keys and payloads differ in size");
+  }
+  std::vector<typename Traits::Bits> bits(keys.size());
+  ParallelForRange(
+      0, keys.size(),
+      [&](size_t begin, size_t end) {
+        std::transform(keys.data() + begin, keys.data() + end, bits.data() + begin, Traits::ToBits);
+      },
+      1, pool);
+  detail::RadixSortBits(bits, payloads, pool);
+  ParallelForRange(
+      0, keys.size(),
+      [&](size_t begin, size_t end) {
+        std::transform(bits.data() + begin, bits.data() + end, keys.data() + begin, Traits::FromBits);
+      },
+      1, pool);
+}
+
+// Permutation p such that keys[p[0]], keys[p[1]], ... is stably sorted; keys
+// are not modified. Index must hold keys.size() - 1.
+template <typename Index = uint32_t, typename Key>
+  requires std::is_unsigned_v<Index>
+std::vector<Index> RadixArgsort(std::span<const Key> keys, ThreadPool &pool = ThreadPool::Instance()) {
+  using Traits = RadixKeyTraits<Key>;
+  if (keys.size() > static_cast<size_t>(std::numeric_limits<Index>::max())) {
+    throw std::length_error("RadixArgsort: too many keys for the index type");
+  }
+  std::vector<typename Traits::Bits> bits(keys.size());
+  std::vector<Index> permutation(keys.size());
+  ParallelForRange(
+      0, keys.size(),
+      [&](size_t begin, size_t end) {
+        std::transform(keys.data() + begin, keys.data() + end, bits.data() + begin, Traits::ToBits);
+        std::iota(permutation.data() + begin, permutation.data() + end, static_cast<Index>(begin));
+      },
+      1, pool);
+  detail::RadixSortBits(bits, std::span<Index>(permutation), pool);
+  return permutation;
+}
+
+}  // namespace ppc::util
@@ -0,0 +1,212 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ppc::util {
+
+// Inputs below this size are passed to the bucket sort as a whole
+constexpr size_t kSampleSortMinSize = size_t{1} << 12;
+
+// Most splitter tree leaves; with an equality bucket per splitter the bucket
+// index of an element still fits in a byte
+constexpr size_t kSampleSortMaxLeaves = 128;
+
+namespace detail {
+
+// Elements of data a classification or scatter part covers at least
+constexpr size_t kSampleSortMinPart = size_t{1} << 14;
+
+// Elements classified together, so the tree descents of neighbouring elements
+// overlap in the pipeline instead of waiting for each other
+constexpr size_t kSampleSortUnroll = 8;
+
+// Splitters in the implicit binary search tree layout (root at 1, children of
+// j at 2j and 2j + 1) plus in sorted order for the equality test. An element
+// lands in bucket 2b if exactly b splitters are smaller than it, or in the
+// equality bucket 2b + 1 if it equals splitter b; equality buckets are sorted
+// by construction.
+template <typename T, typename Compare>
+class SplitterTree {
+ public:
+  SplitterTree(std::vector<T> splitters, Compare comp)
+      : comp_(comp), num_leaves_(std::bit_ceil(splitters.size() + 1)), tree_(num_leaves_) {
+    // padding with the largest splitter leaves the buckets after it empty
+    splitters.resize(num_leaves_ - 1, splitters.back());
+    Build(splitters, 1, 0, splitters.size());
+    sorted_ = std::move(splitters);
+    log_leaves_ = std::countr_zero(num_leaves_);
+  }
+
+  [[nodiscard]] size_t NumBuckets() const { return 2 * num_leaves_; }
+
+  // Bucket indices of data[0, size) to buckets
+  void Classify(const T *data, size_t size, uint8_t *buckets) const {
+    size_t i = 0;
+    for (; i + kSampleSortUnroll <= size; i += kSampleSortUnroll) {
+      std::array<size_t, kSampleSortUnroll> node;
+      node.fill(1);
+      for (int level = 0; level < log_leaves_; level++) {
+        for (size_t u = 0; u < kSampleSortUnroll; u++) {
+          node[u] = (2 * node[u]) + static_cast<size_t>(comp_(tree_[node[u]], data[i + u]));
+        }
+      }
+      for (size_t u = 0; u < kSampleSortUnroll; u++) {
+        buckets[i + u] = ToBucket(node[u], data[i + u]);
+      }
+    }
+    for (; i < size; i++) {
+      size_t node = 1;
+      for (int level = 0; level < log_leaves_; level++) {
+        node = (2 * node) + static_cast<size_t>(comp_(tree_[node], data[i]));
+      }
+      buckets[i] = ToBucket(node, data[i]);
+    }
+  }
+
+ private:
+  Compare comp_;
+  size_t num_leaves_;
+  int log_leaves_ = 0;
+  std::vector<T> tree_;
+  std::vector<T> sorted_;
+
+  void Build(const std::vector<T> &splitters, size_t node, size_t begin, size_t end) {
+    if (begin >= end) {
+      return;
+    }
+    const size_t middle = begin + ((end - begin) / 2);
+    tree_[node] = splitters[middle];
+    Build(splitters, 2 * node, begin, middle);
+    Build(splitters, (2 * node) + 1, middle + 1, end);
+  }
+
+  [[nodiscard]] uint8_t ToBucket(size_t leaf, const T &value) const {
+    const size_t bucket = leaf - num_leaves_;
+    // the last leaf has no splitter above it, its padding copy is never equal
+    const bool equal = bucket + 1 < num_leaves_ && !comp_(value, sorted_[bucket]);
+    return static_cast<uint8_t>((2 * bucket) + static_cast<size_t>(equal));
+  }
+};
+
+// Distinct splitters from an oversampled random sample of data, empty if the
+// sample has no usable element (all NaN)
+template <typename T, typename Compare>
+std::vector<T> ChooseSplitters(std::span<const T> data, Compare &comp) {
+  const size_t size = data.size();
+  const size_t num_leaves = std::clamp<size_t>(std::bit_floor(size / kSampleSortMinSize), 2, kSampleSortMaxLeaves);
+  // log2(n) samples per bucket keep the largest bucket below about twice the
+  // average, the buckets are not split again
+  const auto oversampling = static_cast<size_t>(std::bit_width(size));
+  std::mt19937_64 gen(size);
+  std::uniform_int_distribution<size_t> index(0, size - 1);
+  std::vector<T> sample;
+  sample.reserve(num_leaves * oversampling);
+  for (size_t i = 0; i < num_leaves * oversampling; i++) {
+    const T &value = data[index(gen)];
+    if constexpr (std::is_floating_point_v<T>) {
+      if (std::isnan(value)) {
+        continue;
+      }
+    }
+    sample.push_back(value);
+  }
+  std::sort(sample.begin(), sample.end(), comp);
+
+  std::vector<T> splitters;
+  for (size_t i = 1; i < num_leaves; i++) {
+    const size_t pick = (sample.size() * i) / num_leaves;
+    if (pick < sample.size() && (splitters.empty() || comp(splitters.back(), sample[pick]))) {
+      splitters.push_back(sample[pick]);
+    }
+  }
+  return splitters;
+}
+
+}  // namespace detail
+
+// Parallel super-scalar sample sort (Sanders and Winkel): splitters from an
+// oversampled random sample form a search tree that classifies every element
+// without branches, one parallel scatter moves the elements to their buckets,
+// and the buckets are sorted independently. Elements equal to a splitter get
+// a bucket of their own that needs no sorting, so duplicates cost nothing.
+//
+// The caller provides the parallelism: parallel_for(count, body) must call
+// body(i) for every i in [0, count), e.g. with an OpenMP loop, tbb::parallel_for
+// or ppc::util::ParallelFor. bucket_sort(std::span<T>) sorts a bucket in place
+// and is also called on inputs too small to split. Not stable; NaNs are placed
+// next to an arbitrary splitter.
+template <typename T, typename ParallelFor, typename BucketSort, typename Compare = std::less<>>
+void SampleSort(std::span<T> data, ParallelFor &&parallel_for, BucketSort &&bucket_sort, Compare comp = {}) {
+  const size_t size = data.size();
+  if (size < kSampleSortMinSize) {
+    if (size > 1) {
+      bucket_sort(data);
+    }
+    return;
+  }
+  auto splitters = detail::ChooseSplitters(std::span<const T>(data), comp);
+  if (splitters.empty()) {
+    bucket_sort(data);
+    return;
+  }
+  const detail::SplitterTree<T, Compare> tree(std::move(splitters), comp);
+  const size_t num_buckets = tree.NumBuckets();
+  const size_t num_parts = std::max<size_t>(1, size / detail::kSampleSortMinPart);
+  const auto part_begin = [&](size_t part) { return size * part / num_parts; };
+
+  std::vector<uint8_t> bucket_of(size);
+  std::vector<std::vector<size_t>> counts(num_parts, std::vector<size_t>(num_buckets));
+  parallel_for(num_parts, [&](size_t part) {
+    const size_t begin = part_begin(part);
+    const size_t end = part_begin(part + 1);
+    tree.Classify(data.data() + begin, end - begin, bucket_of.data() + begin);
+    for (size_t i = begin; i < end; i++) {
+      ++counts[part][bucket_of[i]];
+    }
+  });
+
+  // buckets in order, parts in order within a bucket
+  std::vector<size_t> bucket_begin(num_buckets + 1);
+  size_t sum = 0;
+  for (size_t bucket = 0; bucket < num_buckets; bucket++) {
+    bucket_begin[bucket] = sum;
+    for (auto &part_counts : counts) {
+      const size_t count = part_counts[bucket];
+      part_counts[bucket] = sum;
+      sum += count;
+    }
+  }
+  bucket_begin[num_buckets] = sum;
+
+  std::vector<T> buffer(size);
+  parallel_for(num_parts, [&](size_t part) {
+    auto &offsets = counts[part];
+    for (size_t i = part_begin(part); i < part_begin(part + 1); i++) {
+      buffer[offsets[bucket_of[i]]++] = data[i];
+    }
+  });
+
+  // each bucket is copied back right before its sort, while it is in cache
+  parallel_for(num_buckets, [&](size_t bucket) {
+    const size_t begin = bucket_begin[bucket];
+    const size_t end = bucket_begin[bucket + 1];
+    std::copy(buffer.begin() + static_cast<std::ptrdiff_t>(begin), buffer.begin() + static_cast<std::ptrdiff_t>(end),
+              data.begin() + static_cast<std::ptrdiff_t>(begin));
+    if (bucket % 2 == 0 && end - begin > 1) {
+      bucket_sort(data.subspan(begin, end - begin));
+    }
+  });
+}
+
+}  // namespace ppc::util
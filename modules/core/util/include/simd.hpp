@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstdint>
+
+// x86-64 kernels are compiled with per-function target options, which only
+// GCC and Clang provide; other compilers use the scalar kernels
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+#define PPC_SIMD_X86 1
+#endif
+
+namespace ppc::util {
+
+enum class SimdLevel : uint8_t { kScalar, kAvx2, kAvx512 };
+
+// Best level supported by the CPU, lowered to PPC_SIMD (scalar, avx2 or
+// avx512) if it is set; detected once per process
+SimdLevel GetSimdLevel();
+
+// Best level the CPU supports, regardless of PPC_SIMD
+SimdLevel GetSupportedSimdLevel();
+
+}  // namespace ppc::util
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace ppc::util {
+
+// Inputs of sorting benchmarks:
+//   kUniform      - independent uniform values
+//   kSorted       - uniform values in ascending order
+//   kReverse      - uniform values in descending order
+//   kNearlySorted - ascending with 1% of the elements swapped with a random partner
+//   kFewUnique    - 16 distinct values
+//   kZipf         - ranks with probability ~ 1 / rank (skew 1.1), a few values dominate
+//   kAllEqual     - one value
+//   kOrganPipe    - ascending first half, descending second half
+//   kSpecial      - doubles: denormals, -0.0, 0.0, infinities and NaNs of both signs among
+//                   normal values; integers: the limits, 0 and -1 among uniform values
+//   kHugeRange    - doubles with exponents over the whole range, integers over the whole type
+//   kNaNHeavy     - doubles: half NaNs of both signs and different payloads, the rest uniform;
+//                   integers, which have no NaN: half the limits, the rest uniform
+enum class SortDistribution : uint8_t {
+  kUniform,
+  kSorted,
+  kReverse,
+  kNearlySorted,
+  kFewUnique,
+  kZipf,
+  kAllEqual,
+  kOrganPipe,
+  kSpecial,
+  kHugeRange,
+  kNaNHeavy
+};
+
+// every distribution in declaration order
+std::span<const SortDistribution> GetSortDistributions();
+
+// "uniform", "sorted", "reverse", "nearly_sorted", "few_unique", "zipf",
+// "all_equal", "organ_pipe", "special", "huge_range" or "nan_heavy"
+std::string GetSortDistributionName(SortDistribution distribution);
+
+// throws std::invalid_argument for an unknown name
+SortDistribution ParseSortDistribution(const std::string &name);
+
+// size values of the distribution, the same for the same seed; defined for
+// int32_t and double
+template <typename T>
+std::vector<T> GenerateSortData(SortDistribution distribution, size_t size, uint64_t seed);
+
+}  // namespace ppc::util
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+
+#include "core/util/include/simd.hpp"
+
+namespace ppc::util {
+
+// Merge of sorted a and b to out (a.size() + b.size() elements) with
+// branch-free bitonic merge networks over SIMD registers. out must not overlap
+// a, it may overlap b only if out + a.size() == b.data() (the left half of an
+// in-place merge copied away). A level above the CPU support is lowered.
+// Floating point runs may start with negative and end with positive NaNs, as
+// NetworkSort and the radix sorts leave them; the NaNs bypass the network and
+// go to the same ends of out. -0.0 and 0.0 keep no order.
+void NetworkMerge(std::span<const int32_t> a, std::span<const int32_t> b, int32_t *out,
+                  SimdLevel level = GetSimdLevel());
+void NetworkMerge(std::span<const float> a, std::span<const float> b, float *out, SimdLevel level = GetSimdLevel());
+void NetworkMerge(std::span<const double> a, std::span<const double> b, double *out,
+                  SimdLevel level = GetSimdLevel());
+
+// Sorts every register of data with an in-register sorting network and merges
+// the registers with NetworkMerge; meant for blocks that fit in cache. NaNs
+// go to the front (negative sign) or the back, the other values are sorted.
+void NetworkSort(std::span<int32_t> data, SimdLevel level = GetSimdLevel());
+void NetworkSort(std::span<float> data, SimdLevel level = GetSimdLevel());
+void NetworkSort(std::span<double> data, SimdLevel level = GetSimdLevel());
+
+}  // namespace ppc::util
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <span>
+
+namespace ppc::util {
+
+// Products whose smallest dimension is at most this many elements are passed
+// to Gemm instead of being split again
+constexpr size_t kStrassenCrossover = 512;
+
+// Loop of the caller's backend: parallel_for(count, body) calls body(i) for
+// every i in [0, count) and returns when all calls are done. Bodies call it
+// again, so it has to support nesting, e.g. tbb::parallel_for, an OpenMP
+// taskloop or ppc::util::ParallelFor.
+using StrassenParallelFor = std::function<void(size_t, const std::function<void(size_t)> &)>;
+
+// Levels the parallel Strassen splits into independent products for
+// num_threads threads: the fewest giving each thread one of the 7^depth.
+// Each parallel level holds its operand sums and products at once, so the
+// workspace grows by about 7/4 of the level above per level.
+size_t GetStrassenParallelDepth(int num_threads);
+
+// Doubles of workspace Strassen needs for an m x k by k x n product, with
+// parallel_depth parallel levels on top of the sequential ones
+size_t GetStrassenWorkspaceSize(size_t m, size_t n, size_t k, size_t crossover = kStrassenCrossover,
+                                size_t parallel_depth = 0);
+
+// C = A * B for row-major A (m x k), B (k x n) and C (m x n) with leading
+// dimensions lda, ldb and ldc, by Strassen-Winograd recursion (7 products and
+// 15 additions per level) down to Gemm. The blocks are strided views into the
+// operands, the temporaries of all levels are taken from workspace (at least
+// GetStrassenWorkspaceSize doubles), and odd dimensions are peeled: the even
+// part is recursed on and the last row, column or rank-1 term is added by
+// Gemm. C must not overlap A, B or workspace. Not thread-parallel.
+void Strassen(size_t m, size_t n, size_t k, const double *a, size_t lda, const double *b, size_t ldb, double *c,
+              size_t ldc, std::span<double> workspace, size_t crossover = kStrassenCrossover);
+
+// Strassen as a task graph on the caller's scheduler. On each of the top
+// parallel_depth levels the operand sums are formed in one parallel pass, the
+// 7 products run as parallel tasks, each with its own part of the workspace,
+// and one parallel pass combines them into C. Below them the products are
+// sequential Strassen; a product reaching the crossover on a parallel level
+// runs as parallel bands of rows of Gemm instead.
+void Strassen(size_t m, size_t n, size_t k, const double *a, size_t lda, const double *b, size_t ldb, double *c,
+              size_t ldc, std::span<double> workspace, const StrassenParallelFor &parallel_for, size_t parallel_depth,
+              size_t crossover = kStrassenCrossover);
+
+}  // namespace ppc::util
@@ -0,0 +1,176 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "core/util/include/topology.hpp"
+
+namespace ppc::util {
+
+// Pool of persistent threads with work stealing: every worker pops tasks from
+// the back of its own deque and steals from the front of the other deques.
+// A thread waiting for a TaskGroup executes pending tasks as well, so a pool
+// of n threads starts n - 1 workers and the waiting thread is the n-th one.
+class ThreadPool {
+ public:
+  // workers are pinned to the CPUs of thread slots 1..n-1 of the placement
+  explicit ThreadPool(int num_threads, Placement placement = Placement::kNone);
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+  ~ThreadPool();
+
+  // Process-wide pool of GetPPCNumThreads() threads placed by GetPPCPlacement().
+  // The pool is recreated when the configuration changes, so change it only
+  // while no tasks are running.
+  static ThreadPool &Instance();
+
+  [[nodiscard]] int GetNumThreads() const;
+
+  // Enqueue task without waiting, use TaskGroup to wait for completion
+  void Submit(std::function<void()> task);
+
+  // Execute one pending task on the calling thread, false if there was none
+  bool TryRunPendingTask();
+
+ private:
+  struct TaskQueue {
+    std::mutex mutex;
+    std::deque<std::function<void()>> tasks;
+  };
+
+  int num_threads_;
+  Placement placement_;
+  // queues_[0] is shared by external threads, queues_[i] belongs to worker i
+  std::vector<std::unique_ptr<TaskQueue>> queues_;
+  std::vector<std::thread> workers_;
+  std::atomic<size_t> num_pending_{0};
+  std::mutex sleep_mutex_;
+  std::condition_variable wake_up_;
+  bool stop_ = false;
+
+  void WorkerLoop(size_t index);
+  bool PopTask(size_t own_index, std::function<void()> &task);
+};
+
+// Set of tasks running on a pool, Wait() blocks until all of them finish and
+// rethrows the first exception thrown by a task
+class TaskGroup {
+ public:
+  explicit TaskGroup(ThreadPool &pool = ThreadPool::Instance()) : pool_(pool) {}
+  TaskGroup(const TaskGroup &) = delete;
+  TaskGroup &operator=(const TaskGroup &) = delete;
+  ~TaskGroup();
+
+  template <typename Func>
+  void Run(Func &&func);
+
+  void Wait();
+
+ private:
+  ThreadPool &pool_;
+  std::atomic<size_t> num_pending_{0};
+  std::mutex error_mutex_;
+  std::exception_ptr error_;
+
+  void WaitPending();
+};
+
+template <typename Func>
+void TaskGroup::Run(Func &&func) {
+  num_pending_.fetch_add(1, std::memory_order_relaxed);
+  pool_.Submit([this, func = std::forward<Func>(func)]() mutable {
+    try {
+      func();
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(error_mutex_);
+      if (!error_) {
+        error_ = std::current_exception();
+      }
+    }
+    num_pending_.fetch_sub(1, std::memory_order_release);
+  });
+}
+
+// Call func(chunk_begin, chunk_end) for chunks of [begin, end) of at least
+// grain elements, about four chunks per thread of the pool
+template <typename Func>
+void ParallelForRange(size_t begin, size_t end, Func &&func, size_t grain = 1,
+                      ThreadPool &pool = ThreadPool::Instance()) {
+  if (begin >= end) {
+    return;
+  }
+  const size_t size = end - begin;
+  const size_t max_chunks = static_cast<size_t>(pool.GetNumThreads()) * 4;
+  const size_t chunk = std::max({grain, size_t{1}, (size + max_chunks - 1) / max_chunks});
+  if (chunk >= size) {
+    func(begin, end);
+    return;
+  }
+  TaskGroup group(pool);
+  for (size_t chunk_begin = begin + chunk; chunk_begin < end; chunk_begin += chunk) {
+    const size_t chunk_end = std::min(chunk_begin + chunk, end);
+    group.Run([&func, chunk_begin, chunk_end] { func(chunk_begin, chunk_end); });
+  }
+  // the calling thread takes the first chunk
+  try {
+    func(begin, begin + chunk);
+  } catch (...) {
+    group.Wait();
+    throw;
+  }
+  group.Wait();
+}
+
+// Call func(i) for every i in [begin, end)
+template <typename Func>
+void ParallelFor(size_t begin, size_t end, Func &&func, size_t grain = 1, ThreadPool &pool = ThreadPool::Instance()) {
+  ParallelForRange(
+      begin, end,
+      [&func](size_t chunk_begin, size_t chunk_end) {
+        for (size_t i = chunk_begin; i < chunk_end; i++) {
+          func(i);
+        }
+      },
+      grain, pool);
+}
+
+// Reduce [begin, end): func(chunk_begin, chunk_end, identity) returns the
+// value of one chunk, values of chunks are combined by reduce in chunk order,
+// so the result does not depend on scheduling
+template <typename T, typename Func, typename Reduce>
+T ParallelReduce(size_t begin, size_t end, T identity, Func &&func, Reduce &&reduce, size_t grain = 1,
+                 ThreadPool &pool = ThreadPool::Instance()) {
+  if (begin >= end) {
+    return identity;
+  }
+  const size_t size = end - begin;
+  const size_t max_chunks = static_cast<size_t>(pool.GetNumThreads()) * 4;
+  const size_t chunk = std::max({grain, size_t{1}, (size + max_chunks - 1) / max_chunks});
+  const size_t num_chunks = (size + chunk - 1) / chunk;
+  std::vector<T> partial(num_chunks, identity);
+  ParallelFor(
+      0, num_chunks,
+      [&](size_t i) {
+        const size_t chunk_begin = begin + (i * chunk);
+        const size_t chunk_end = std::min(chunk_begin + chunk, end);
+        partial[i] = func(chunk_begin, chunk_end, identity);
+      },
+      1, pool);
+  T result = identity;
+  for (auto &value : partial) {
+    result = reduce(result, value);
+  }
+  return result;
+}
+
+}  // namespace ppc::util
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace ppc::util {
+
+struct LogicalCpu {
+  int id = 0;
+  int core_id = 0;
+  int package_id = 0;
+  int numa_node = 0;
+};
+
+// Processor topology of the logical CPUs available to the process
+struct Topology {
+  std::vector<LogicalCpu> cpus;
+  int num_physical_cores = 1;
+  int num_packages = 1;
+  int num_numa_nodes = 1;
+  // cache sizes (in bytes) seen by one core, 0 if unknown
+  size_t l1d_cache_size = 0;
+  size_t l2_cache_size = 0;
+  size_t l3_cache_size = 0;
+};
+
+// Topology read from sysfs on Linux once per process; other platforms report
+// every hardware thread as a separate core
+const Topology &GetTopology();
+
+// Order of CPUs given to threads:
+//   kNone      - threads are not pinned
+//   kCompact   - fill SMT siblings, then neighbour cores of the same package
+//   kScatter   - one thread per physical core round robin over packages, then SMT siblings
+//   kNumaLocal - compact order on the NUMA node of the calling thread only
+enum class Placement : uint8_t { kNone, kCompact, kScatter, kNumaLocal };
+
+// parse "none", "compact", "scatter" or "numa" (kNone for anything else)
+Placement ParsePlacement(const std::string &name);
+
+// Placement from PPC_PLACEMENT environment variable
+Placement GetPPCPlacement();
+
+// CPU ids of num_threads thread slots in the placement order, empty for kNone
+std::vector<int> GetPlacementCpus(int num_threads, Placement placement);
+
+// Pin the calling thread to the CPU of slot thread_index of the placement,
+// false if the thread was not pinned
+bool PinCurrentThread(int thread_index, int num_threads, Placement placement);
+
+// Same for the GetPPCNumThreads()/GetPPCPlacement() configuration, used by
+// OpenMP, TBB and std::thread backends alike
+bool PinCurrentThread(int thread_index);
+
+// PinCurrentThread() for the worker threads of a parallel region only: slot 0
+// is the thread that opened the region (e.g. the gtest thread), it keeps its
+// affinity so that threads it creates later do not inherit a single CPU
+bool PinWorkerThread(int thread_index);
+
+}  // namespace ppc::util
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <tbb/task_arena.h>
+#include <tbb/task_scheduler_observer.h>
+
+#include "core/util/include/topology.hpp"
+
+// Header only: the core library itself does not link TBB, the runners of the
+// TBB backends do
+namespace ppc::util {
+
+// Pins every TBB worker entering the arena to the CPU of its arena slot, the
+// threads that start the work keep their affinity (see PinWorkerThread())
+class PinningObserver : public tbb::task_scheduler_observer {
+ public:
+  PinningObserver() { observe(true); }
+  PinningObserver(const PinningObserver &) = delete;
+  PinningObserver &operator=(const PinningObserver &) = delete;
+  ~PinningObserver() override { observe(false); }
+
+  void on_scheduler_entry(bool is_worker) override {
+    if (is_worker) {
+      PinCurrentThread(tbb::this_task_arena::current_thread_index());
+    }
+  }
+};
+
+}  // namespace ppc::util
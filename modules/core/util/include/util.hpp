@@ -1,9 +1,18 @@
 #pragma once
+#include <functional>
 #include <string>
 
 namespace ppc::util {
 
 std::string GetAbsolutePath(const std::string &relative_path);
+// PPC_NUM_THREADS, OMP_NUM_THREADS or count of physical cores
 int GetPPCNumThreads();
+// Set PPC_NUM_THREADS for the rest of the process (0 unsets it) and notify
+// the observers with the resulting GetPPCNumThreads()
+void SetPPCNumThreads(int num_threads);
+// Observers let runners reconfigure OpenMP and TBB when the count changes
+void AddNumThreadsObserver(std::function<void(int)> observer);
+// value of the environment variable or empty string if it is not set
+std::string GetEnvVar(const std::string &name);
 
 }  // namespace ppc::util
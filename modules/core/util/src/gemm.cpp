@@ -0,0 +1,347 @@
+#include "core/util/include/gemm.hpp"
+
+#include <algorithm>
+#include <complex>
+#include <cstddef>
+#include <functional>
+#include <span>
+#include <thread>
+#include <vector>
+
+#include "core/util/include/simd.hpp"
+#include "core/util/include/topology.hpp"
+#include "core/util/src/gemm_kernels.hpp"
+
+namespace {
+
+// Cache sizes assumed when the topology does not report them
+constexpr size_t kDefaultL1Size = size_t{32} << 10;
+constexpr size_t kDefaultL2Size = size_t{256} << 10;
+constexpr size_t kDefaultL3Size = size_t{8} << 20;
+
+// Multiply-adds of a task of GemmBatched: bands of rows of a large product
+// get about this many, so B is packed again only once per 64 rows of a
+// 512 x 512 product
+constexpr size_t kBatchTaskWork = size_t{1} << 24;
+
+constexpr size_t kScalarMr = 4;
+constexpr size_t kScalarNrVectors = 4;
+
+template <typename T>
+struct Scalar {
+  using Value = T;
+  using Vec = T;
+  static constexpr int kLanes = 1;
+
+  static Vec Zero() { return T{0}; }
+  static Vec Load(const Value *p) { return *p; }
+  static void Store(Value *p, Vec v) { *p = v; }
+  static Vec Broadcast(const Value *p) { return *p; }
+  static Vec Mul(Vec a, Vec b) { return a * b; }
+  static Vec Add(Vec a, Vec b) { return a + b; }
+};
+
+template <typename T>
+using KernelFunction = void (*)(size_t, const T *, const T *, T *, size_t, size_t, size_t, bool);
+
+template <typename T>
+struct Kernel {
+  KernelFunction<T> function;
+  size_t mr;
+  size_t nr;
+};
+
+template <typename T>
+void ScalarKernel(size_t kc, const T *a, const T *b, T *c, size_t ldc, size_t mr, size_t nr, bool /*fused*/) {
+  ppc::util::detail::GemmMicroKernel<Scalar<T>, kScalarMr, kScalarNrVectors, false>(kc, a, b, c, ldc, mr, nr);
+}
+
+#ifdef PPC_SIMD_X86
+bool CpuHasFma() {
+  static const bool kHasFma = [] {
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("fma") != 0;
+  }();
+  return kHasFma;
+}
+#endif
+
+template <typename T>
+Kernel<T> SelectKernel([[maybe_unused]] ppc::util::SimdLevel level) {
+  namespace detail = ppc::util::detail;
+#ifdef PPC_SIMD_X86
+  const auto effective = std::min(level, ppc::util::GetSupportedSimdLevel());
+  if (effective == ppc::util::SimdLevel::kAvx512) {
+    return {.function = static_cast<KernelFunction<T>>(&detail::GemmKernelAvx512),
+            .mr = detail::kGemmMrAvx512,
+            .nr = detail::kGemmNrVectors * 64 / sizeof(T)};
+  }
+  if (effective == ppc::util::SimdLevel::kAvx2 && CpuHasFma()) {
+    return {.function = static_cast<KernelFunction<T>>(&detail::GemmKernelAvx2),
+            .mr = detail::kGemmMrAvx2,
+            .nr = detail::kGemmNrVectors * 32 / sizeof(T)};
+  }
+#endif
+  // the scalar products are never contracted, fused or not
+  return {.function = &ScalarKernel<T>,
+          .mr = kScalarMr,
+          .nr = kScalarNrVectors};
+}
+
+size_t RoundUp(size_t value, size_t step) { return (value + step - 1) / step * step; }
+
+// Element (row, col) of op(X) starts at x + Offset(...) in the stored X
+size_t Offset(size_t row, size_t col, size_t ld, bool transposed) {
+  return transposed ? (col * ld) + row : (row * ld) + col;
+}
+
+// alpha * op(A)[0, rows) x [0, depth) as panels of mr rows, each stored step
+// by step (mr values per step) and padded with zero rows
+template <typename T>
+void PackA(size_t rows, size_t depth, T alpha, const T *a, size_t lda, bool transposed, size_t mr, T *out) {
+  for (size_t panel = 0; panel < rows; panel += mr) {
+    const size_t height = std::min(mr, rows - panel);
+    for (size_t p = 0; p < depth; p++) {
+      for (size_t i = 0; i < height; i++) {
+        out[i] = alpha * a[Offset(panel + i, p, lda, transposed)];
+      }
+      std::fill(out + height, out + mr, T{0});
+      out += mr;
+    }
+  }
+}
+
+// op(B)[0, depth) x [0, cols) as panels of nr columns, each stored row by
+// row (nr values per step) and padded with zero columns
+template <typename T>
+void PackB(size_t depth, size_t cols, const T *b, size_t ldb, bool transposed, size_t nr, T *out) {
+  for (size_t panel = 0; panel < cols; panel += nr) {
+    const size_t width = std::min(nr, cols - panel);
+    for (size_t p = 0; p < depth; p++) {
+      if (transposed) {
+        for (size_t j = 0; j < width; j++) {
+          out[j] = b[((panel + j) * ldb) + p];
+        }
+      } else {
+        const T *row = b + (p * ldb) + panel;
+        std::copy(row, row + width, out);
+      }
+      std::fill(out + width, out + nr, T{0});
+      out += nr;
+    }
+  }
+}
+
+template <typename T>
+void ScaleC(size_t m, size_t n, T beta, T *c, size_t ldc) {
+  if (beta == T{1}) {
+    return;
+  }
+  for (size_t i = 0; i < m; i++) {
+    T *row = c + (i * ldc);
+    if (beta == T{0}) {
+      std::fill(row, row + n, T{0});
+    } else {
+      std::transform(row, row + n, row, [beta](T value) { return beta * value; });
+    }
+  }
+}
+
+template <typename T>
+void RealGemm(size_t m, size_t n, size_t k, T alpha, const T *a, size_t lda, bool transpose_a, const T *b, size_t ldb,
+              bool transpose_b, T beta, T *c, size_t ldc, const ppc::util::GemmOptions &options) {
+  if (m == 0 || n == 0) {
+    return;
+  }
+  ScaleC(m, n, beta, c, ldc);
+  if (k == 0 || alpha == T{0}) {
+    return;
+  }
+  const auto kernel = SelectKernel<T>(options.level);
+  const auto blocking = ppc::util::GetGemmBlocking(sizeof(T), kernel.mr, kernel.nr, options.blocking);
+  const size_t mc = RoundUp(std::min(blocking.mc, m), kernel.mr);
+  const size_t nc = RoundUp(std::min(blocking.nc, n), kernel.nr);
+  const size_t kc = std::min(blocking.kc, k);
+
+  // kept per thread, so repeated calls of a task reuse them
+  thread_local std::vector<T> a_packed;
+  thread_local std::vector<T> b_packed;
+  a_packed.resize(std::max(a_packed.size(), mc * kc));
+  b_packed.resize(std::max(b_packed.size(), kc * nc));
+
+  for (size_t jc = 0; jc < n; jc += nc) {
+    const size_t cols = std::min(nc, n - jc);
+    for (size_t pc = 0; pc < k; pc += kc) {
+      const size_t depth = std::min(kc, k - pc);
+      PackB(depth, cols, b + Offset(pc, jc, ldb, transpose_b), ldb, transpose_b, kernel.nr, b_packed.data());
+      for (size_t ic = 0; ic < m; ic += mc) {
+        const size_t rows = std::min(mc, m - ic);
+        PackA(rows, depth, alpha, a + Offset(ic, pc, lda, transpose_a), lda, transpose_a, kernel.mr, a_packed.data());
+        for (size_t jr = 0; jr < cols; jr += kernel.nr) {
+          for (size_t ir = 0; ir < rows; ir += kernel.mr) {
+            kernel.function(depth, a_packed.data() + (ir * depth), b_packed.data() + (jr * depth),
+                            c + ((ic + ir) * ldc) + jc + jr, ldc, std::min(kernel.mr, rows - ir),
+                            std::min(kernel.nr, cols - jr), options.fused);
+          }
+        }
+      }
+    }
+  }
+}
+
+}  // namespace
+
+ppc::util::GemmBlocking ppc::util::GetGemmBlocking(size_t element_size, size_t mr, size_t nr,
+                                                   GemmBlocking requested) {
+  const auto &topology = GetTopology();
+  const size_t l1 = topology.l1d_cache_size != 0 ? topology.l1d_cache_size : kDefaultL1Size;
+  const size_t l2 = topology.l2_cache_size != 0 ? topology.l2_cache_size : kDefaultL2Size;
+  const size_t l3 = topology.l3_cache_size != 0 ? topology.l3_cache_size : kDefaultL3Size;
+
+  GemmBlocking blocking = requested;
+  // the B sliver takes half of L1, the rest is for the A panel and C tile
+  if (blocking.kc == 0) {
+    blocking.kc = std::clamp<size_t>(l1 / 2 / (nr * element_size), 16, 1024);
+  }
+  // the A block takes half of L2, the B panel a quarter of the shared L3
+  if (blocking.mc == 0) {
+    blocking.mc = std::max(mr, l2 / 2 / (blocking.kc * element_size) / mr * mr);
+  }
+  if (blocking.nc == 0) {
+    blocking.nc = std::max(nr, l3 / 4 / (blocking.kc * element_size) / nr * nr);
+  }
+  return blocking;
+}
+
+void ppc::util::Gemm(size_t m, size_t n, size_t k, double alpha, const double *a, size_t lda, const double *b,
+                     size_t ldb, double beta, double *c, size_t ldc, const GemmOptions &options) {
+  RealGemm(m, n, k, alpha, a, lda, false, b, ldb, false, beta, c, ldc, options);
+}
+
+void ppc::util::Gemm(size_t m, size_t n, size_t k, float alpha, const float *a, size_t lda, const float *b, size_t ldb,
+                     float beta, float *c, size_t ldc, const GemmOptions &options) {
+  RealGemm(m, n, k, alpha, a, lda, false, b, ldb, false, beta, c, ldc, options);
+}
+
+void ppc::util::Gemm(size_t m, size_t n, size_t k, std::complex<double> alpha, const std::complex<double> *a,
+                     size_t lda, const std::complex<double> *b, size_t ldb, std::complex<double> beta,
+                     std::complex<double> *c, size_t ldc, const GemmOptions &options) {
+  if (m == 0 || n == 0) {
+    return;
+  }
+  ScaleC(m, n, beta, c, ldc);
+  if (k == 0 || alpha == 0.0) {
+    return;
+  }
+  // alpha is applied to A, so the real products only accumulate:
+  // Re C += Re A Re B - Im A Im B, Im C += Re A Im B + Im A Re B
+  std::vector<double> a_re(m * k);
+  std::vector<double> a_im(m * k);
+  std::vector<double> b_re(k * n);
+  std::vector<double> b_im(k * n);
+  std::vector<double> c_re(m * n);
+  std::vector<double> c_im(m * n);
+  for (size_t i = 0; i < m; i++) {
+    for (size_t p = 0; p < k; p++) {
+      const auto value = alpha * a[(i * lda) + p];
+      a_re[(i * k) + p] = value.real();
+      a_im[(i * k) + p] = value.imag();
+    }
+  }
+  for (size_t p = 0; p < k; p++) {
+    for (size_t j = 0; j < n; j++) {
+      b_re[(p * n) + j] = b[(p * ldb) + j].real();
+      b_im[(p * n) + j] = b[(p * ldb) + j].imag();
+    }
+  }
+  for (size_t i = 0; i < m; i++) {
+    for (size_t j = 0; j < n; j++) {
+      c_re[(i * n) + j] = c[(i * ldc) + j].real();
+      c_im[(i * n) + j] = c[(i * ldc) + j].imag();
+    }
+  }
+  RealGemm(m, n, k, 1.0, a_re.data(), k, false, b_re.data(), n, false, 1.0, c_re.data(), n, options);
+  RealGemm(m, n, k, -1.0, a_im.data(), k, false, b_im.data(), n, false, 1.0, c_re.data(), n, options);
+  RealGemm(m, n, k, 1.0, a_re.data(), k, false, b_im.data(), n, false, 1.0, c_im.data(), n, options);
+  RealGemm(m, n, k, 1.0, a_im.data(), k, false, b_re.data(), n, false, 1.0, c_im.data(), n, options);
+  for (size_t i = 0; i < m; i++) {
+    for (size_t j = 0; j < n; j++) {
+      c[(i * ldc) + j] = {c_re[(i * n) + j], c_im[(i * n) + j]};
+    }
+  }
+}
+
+void ppc::util::Gemm(const GemmProblem &problem, const GemmOptions &options) {
+  RealGemm(problem.m, problem.n, problem.k, problem.alpha, problem.a, problem.lda, problem.transpose_a, problem.b,
+           problem.ldb, problem.transpose_b, problem.beta, problem.c, problem.ldc, options);
+}
+
+void ppc::util::GemmBatched(std::span<const GemmProblem> batch, const GemmParallelFor &parallel_for,
+                            const GemmOptions &options) {
+  // first task and rows per task of every product
+  std::vector<size_t> first_task(batch.size() + 1, 0);
+  std::vector<size_t> band_rows(batch.size());
+  for (size_t i = 0; i < batch.size(); i++) {
+    const auto &problem = batch[i];
+    const size_t row_work = std::max<size_t>(1, problem.n * problem.k);
+    band_rows[i] = std::max<size_t>(1, kBatchTaskWork / row_work);
+    const size_t bands = problem.m == 0 ? 0 : (problem.m + band_rows[i] - 1) / band_rows[i];
+    first_task[i + 1] = first_task[i] + bands;
+  }
+  parallel_for(first_task.back(), [&](size_t task) {
+    const auto index = static_cast<size_t>(std::ranges::upper_bound(first_task, task) - first_task.begin() - 1);
+    GemmProblem band = batch[index];
+    const size_t row = (task - first_task[index]) * band_rows[index];
+    band.m = std::min(band_rows[index], band.m - row);
+    band.a += Offset(row, 0, band.lda, band.transpose_a);
+    band.c += row * band.ldc;
+    Gemm(band, options);
+  });
+}
+
+void ppc::util::GemmBatchedWithProgress(std::span<const GemmProblem> batch, const GemmParallelFor &parallel_for,
+                                       const std::function<void()> &progress, const GemmOptions &options) {
+  const auto caller = std::this_thread::get_id();
+  const GemmParallelFor polling_for = [&](size_t count, const std::function<void(size_t)> &body) {
+    parallel_for(count, [&](size_t task) {
+      const bool on_caller = std::this_thread::get_id() == caller;
+      if (on_caller) {
+        progress();
+      }
+      body(task);
+      if (on_caller) {
+        progress();
+      }
+    });
+  };
+  GemmBatched(batch, polling_for, options);
+}
+
+std::vector<ppc::util::GemmProblem> ppc::util::BlockStageBatch(const double *a, const double *b, double *c, size_t n,
+                                                               size_t block_size, size_t stage,
+                                                               BlockSchedule schedule) {
+  const size_t num_blocks = (n + block_size - 1) / block_size;
+  std::vector<GemmProblem> batch;
+  batch.reserve(num_blocks * num_blocks);
+  for (size_t bi = 0; bi < num_blocks; bi++) {
+    for (size_t bj = 0; bj < num_blocks; bj++) {
+      const size_t skew = schedule == BlockSchedule::kCannon ? bi + bj : bi;
+      const size_t row = bi * block_size;
+      const size_t col = bj * block_size;
+      const size_t mid = ((skew + stage) % num_blocks) * block_size;
+      GemmProblem problem;
+      problem.m = std::min(block_size, n - row);
+      problem.n = std::min(block_size, n - col);
+      problem.k = std::min(block_size, n - mid);
+      problem.a = a + (row * n) + mid;
+      problem.lda = n;
+      problem.b = b + (mid * n) + col;
+      problem.ldb = n;
+      problem.beta = 1.0;
+      problem.c = c + (row * n) + col;
+      problem.ldc = n;
+      batch.push_back(problem);
+    }
+  }
+  return batch;
+}
@@ -0,0 +1,77 @@
+#include <cstddef>
+
+#include "core/util/include/simd.hpp"
+
+#ifdef PPC_SIMD_X86
+
+#if defined(__clang__)
+#pragma clang attribute push(__attribute__((target("avx2,fma"))), apply_to = function)
+#else
+#pragma GCC target("avx2,fma")
+// the unfused kernels must keep their separate multiply and add; the fused
+// ones use the FMA intrinsics directly
+#pragma GCC optimize("fp-contract=off")
+#endif
+
+#include <immintrin.h>
+
+#include "core/util/src/gemm_kernels.hpp"
+
+namespace {
+
+struct Float64x4 {
+  using Value = double;
+  using Vec = __m256d;
+  static constexpr int kLanes = 4;
+
+  static Vec Zero() { return _mm256_setzero_pd(); }
+  static Vec Load(const Value *p) { return _mm256_loadu_pd(p); }
+  static void Store(Value *p, Vec v) { _mm256_storeu_pd(p, v); }
+  static Vec Broadcast(const Value *p) { return _mm256_broadcast_sd(p); }
+  static Vec Fma(Vec a, Vec b, Vec acc) { return _mm256_fmadd_pd(a, b, acc); }
+  static Vec Mul(Vec a, Vec b) { return _mm256_mul_pd(a, b); }
+  static Vec Add(Vec a, Vec b) { return _mm256_add_pd(a, b); }
+};
+
+struct Float32x8 {
+  using Value = float;
+  using Vec = __m256;
+  static constexpr int kLanes = 8;
+
+  static Vec Zero() { return _mm256_setzero_ps(); }
+  static Vec Load(const Value *p) { return _mm256_loadu_ps(p); }
+  static void Store(Value *p, Vec v) { _mm256_storeu_ps(p, v); }
+  static Vec Broadcast(const Value *p) { return _mm256_broadcast_ss(p); }
+  static Vec Fma(Vec a, Vec b, Vec acc) { return _mm256_fmadd_ps(a, b, acc); }
+  static Vec Mul(Vec a, Vec b) { return _mm256_mul_ps(a, b); }
+  static Vec Add(Vec a, Vec b) { return _mm256_add_ps(a, b); }
+};
+
+}  // namespace
+
+namespace ppc::util::detail {
+
+void GemmKernelAvx2(size_t kc, const double *a, const double *b, double *c, size_t ldc, size_t mr, size_t nr,
+                    bool fused) {
+  if (fused) {
+    GemmMicroKernel<Float64x4, kGemmMrAvx2, kGemmNrVectors, true>(kc, a, b, c, ldc, mr, nr);
+  } else {
+    GemmMicroKernel<Float64x4, kGemmMrAvx2, kGemmNrVectors, false>(kc, a, b, c, ldc, mr, nr);
+  }
+}
+void GemmKernelAvx2(size_t kc, const float *a, const float *b, float *c, size_t ldc, size_t mr, size_t nr,
+                    bool fused) {
+  if (fused) {
+    GemmMicroKernel<Float32x8, kGemmMrAvx2, kGemmNrVectors, true>(kc, a, b, c, ldc, mr, nr);
+  } else {
+    GemmMicroKernel<Float32x8, kGemmMrAvx2, kGemmNrVectors, false>(kc, a, b, c, ldc, mr, nr);
+  }
+}
+
+}  // namespace ppc::util::detail
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#endif
+
+#endif  // PPC_SIMD_X86
@@ -0,0 +1,100 @@
+#pragma once
+
+// Micro-kernel entry points of the instruction set specific units and the
+// generic register-tile kernel they are built from. gemm_avx2.cpp and
+// gemm_avx512.cpp include this after their target pragma, like the sorting
+// network kernels: the template is instantiated for register types S of that
+// unit only and uses no standard library templates.
+//
+// S provides Value, Vec, kLanes, Zero(), Load, Store, Broadcast(const Value *),
+// Fma(a, b, acc) returning a * b + acc with one rounding, Mul and Add.
+
+#include <cstddef>
+
+namespace ppc::util::detail {
+
+// Rows of the register tile and vectors per row of it: 6 x 2 accumulators
+// plus two B vectors and a broadcast A value fill the 16 AVX2 registers,
+// 12 x 2 of them leave room for the same in the 32 AVX-512 registers
+constexpr size_t kGemmMrAvx2 = 6;
+constexpr size_t kGemmMrAvx512 = 12;
+constexpr size_t kGemmNrVectors = 2;
+
+// C[0, mr) x [0, nr) += A * B over kc steps: a is a packed mr x kc panel
+// (kMr values per step), b a packed kc x nr panel (kNr values per step), both
+// padded with zeros to the full tile. Without fused the products are rounded
+// before they are added.
+void GemmKernelAvx2(size_t kc, const double *a, const double *b, double *c, size_t ldc, size_t mr, size_t nr,
+                    bool fused);
+void GemmKernelAvx2(size_t kc, const float *a, const float *b, float *c, size_t ldc, size_t mr, size_t nr, bool fused);
+void GemmKernelAvx512(size_t kc, const double *a, const double *b, double *c, size_t ldc, size_t mr, size_t nr,
+                      bool fused);
+void GemmKernelAvx512(size_t kc, const float *a, const float *b, float *c, size_t ldc, size_t mr, size_t nr,
+                      bool fused);
+
+// The accumulators stay in registers for the whole kc loop; edge tiles are
+// computed in full and only their valid part is added to C
+template <typename S, int kMr, int kNrVecs, bool kFused>
+void GemmMicroKernel(size_t kc, const typename S::Value *a, const typename S::Value *b, typename S::Value *c,
+                     size_t ldc, size_t mr, size_t nr) {
+  using Value = typename S::Value;
+  using Vec = typename S::Vec;
+  constexpr int kNr = kNrVecs * S::kLanes;
+
+  Vec acc[kMr][kNrVecs];
+#pragma GCC unroll 16
+  for (int i = 0; i < kMr; i++) {
+#pragma GCC unroll 4
+    for (int j = 0; j < kNrVecs; j++) {
+      acc[i][j] = S::Zero();
+    }
+  }
+  for (size_t p = 0; p < kc; p++) {
+    Vec b_vec[kNrVecs];
+#pragma GCC unroll 4
+    for (int j = 0; j < kNrVecs; j++) {
+      b_vec[j] = S::Load(b + (j * S::kLanes));
+    }
+#pragma GCC unroll 16
+    for (int i = 0; i < kMr; i++) {
+      const Vec a_vec = S::Broadcast(a + i);
+#pragma GCC unroll 4
+      for (int j = 0; j < kNrVecs; j++) {
+        if constexpr (kFused) {
+          acc[i][j] = S::Fma(a_vec, b_vec[j], acc[i][j]);
+        } else {
+          acc[i][j] = S::Add(acc[i][j], S::Mul(a_vec, b_vec[j]));
+        }
+      }
+    }
+    a += kMr;
+    b += kNr;
+  }
+
+  if (mr == static_cast<size_t>(kMr) && nr == static_cast<size_t>(kNr)) {
+#pragma GCC unroll 16
+    for (int i = 0; i < kMr; i++) {
+#pragma GCC unroll 4
+      for (int j = 0; j < kNrVecs; j++) {
+        Value *row = c + (i * ldc) + (j * S::kLanes);
+        S::Store(row, S::Add(S::Load(row), acc[i][j]));
+      }
+    }
+    return;
+  }
+  Value tile[kMr * kNr];
+#pragma GCC unroll 16
+  for (int i = 0; i < kMr; i++) {
+#pragma GCC unroll 4
+    for (int j = 0; j < kNrVecs; j++) {
+      S::Store(tile + (i * kNr) + (j * S::kLanes), acc[i][j]);
+    }
+  }
+  for (size_t i = 0; i < mr; i++) {
+    for (size_t j = 0; j < nr; j++) {
+      c[(i * ldc) + j] += tile[(i * kNr) + j];
+    }
+  }
+}
+
+}  // namespace ppc::util::detail
@@ -0,0 +1,32 @@
+#include "core/util/include/radix_sort.hpp"
+
+#include <cstddef>
+
+#include "core/util/include/topology.hpp"
+
+namespace {
+
+// Assumed when sysfs does not report the cache sizes
+constexpr size_t kDefaultL2Size = size_t{256} << 10;
+constexpr size_t kDefaultL3Size = size_t{8} << 20;
+
+// One write-combining cache line per digit
+constexpr size_t ScatterFootprint(int digit_bits) { return (size_t{1} << digit_bits) * 64; }
+
+}  // namespace
+
+int ppc::util::RadixDigitBits(size_t size, int key_bits) {
+  const auto &topology = GetTopology();
+  const size_t l2 = topology.l2_cache_size != 0 ? topology.l2_cache_size : kDefaultL2Size;
+  const size_t l3 = topology.l3_cache_size != 0 ? topology.l3_cache_size : kDefaultL3Size;
+  // a digit width pays off once every digit gets a few hundred keys per pass
+  // and it saves at least one pass
+  for (const int digit_bits : {16, 11}) {
+    const size_t cache = digit_bits == 16 ? l3 : l2;
+    if (size >= (size_t{256} << digit_bits) && ScatterFootprint(digit_bits) <= cache &&
+        RadixNumPasses(key_bits, digit_bits) < RadixNumPasses(key_bits, digit_bits == 16 ? 11 : 8)) {
+      return digit_bits;
+    }
+  }
+  return 8;
+}
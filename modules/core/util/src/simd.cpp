@@ -0,0 +1,42 @@
+#include "core/util/include/simd.hpp"
+
+#include <algorithm>
+#include <string>
+
+#include "core/util/include/util.hpp"
+
+namespace {
+
+ppc::util::SimdLevel DetectSimdLevel() {
+#ifdef PPC_SIMD_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f")) {
+    return ppc::util::SimdLevel::kAvx512;
+  }
+  if (__builtin_cpu_supports("avx2")) {
+    return ppc::util::SimdLevel::kAvx2;
+  }
+#endif
+  return ppc::util::SimdLevel::kScalar;
+}
+
+}  // namespace
+
+ppc::util::SimdLevel ppc::util::GetSupportedSimdLevel() {
+  static const SimdLevel kSupported = DetectSimdLevel();
+  return kSupported;
+}
+
+ppc::util::SimdLevel ppc::util::GetSimdLevel() {
+  static const SimdLevel kLevel = [] {
+    const std::string requested = GetEnvVar("PPC_SIMD");
+    SimdLevel level = GetSupportedSimdLevel();
+    if (requested == "scalar") {
+      level = SimdLevel::kScalar;
+    } else if (requested == "avx2") {
+      level = std::min(level, SimdLevel::kAvx2);
+    }
+    return level;
+  }();
+  return kLevel;
+}
@@ -0,0 +1,182 @@
+#include "core/util/include/sort_inputs.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace {
+
+using ppc::util::SortDistribution;
+
+constexpr std::array kDistributions = {
+    SortDistribution::kUniform,
+    SortDistribution::kSorted,
+    SortDistribution::kReverse,
+    SortDistribution::kNearlySorted,
+    SortDistribution::kFewUnique,
+    SortDistribution::kZipf,
+    SortDistribution::kAllEqual,
+    SortDistribution::kOrganPipe,
+    SortDistribution::kSpecial,
+    SortDistribution::kHugeRange,
+    SortDistribution::kNaNHeavy,
+};
+
+constexpr std::array<const char *, kDistributions.size()> kNames = {
+    "uniform", "sorted", "reverse", "nearly_sorted", "few_unique", "zipf", "all_equal", "organ_pipe", "special",
+    "huge_range", "nan_heavy"};
+
+// Ranks the Zipf distribution draws from, enough for every rank beyond to be rare
+constexpr size_t kZipfRanks = size_t{1} << 16;
+constexpr double kZipfSkew = 1.1;
+
+template <typename T>
+T UniformValue(std::mt19937_64 &gen) {
+  if constexpr (std::is_floating_point_v<T>) {
+    return std::uniform_real_distribution<T>(-1e6, 1e6)(gen);
+  } else {
+    return std::uniform_int_distribution<T>(-1000000000, 1000000000)(gen);
+  }
+}
+
+template <typename T>
+T HugeRangeValue(std::mt19937_64 &gen) {
+  if constexpr (std::is_floating_point_v<T>) {
+    const T mantissa = std::uniform_real_distribution<T>(1, 2)(gen);
+    const int exponent = std::uniform_int_distribution<int>(-1000, 1000)(gen);
+    return (gen() % 2 == 0 ? 1 : -1) * std::ldexp(mantissa, exponent);
+  } else {
+    return std::uniform_int_distribution<T>(std::numeric_limits<T>::min(), std::numeric_limits<T>::max())(gen);
+  }
+}
+
+template <typename T>
+std::vector<T> SpecialValues() {
+  using Limits = std::numeric_limits<T>;
+  if constexpr (std::is_floating_point_v<T>) {
+    // x86 arithmetic produces negative NaNs, so both signs are sorted inputs
+    return {
+        Limits::denorm_min(), -Limits::denorm_min(), Limits::min() / 3,  -T{0},
+        T{0},                 Limits::infinity(),    -Limits::infinity(), Limits::quiet_NaN(),
+        -Limits::quiet_NaN(),
+    };
+  } else {
+    return {Limits::min(), Limits::max(), T{0}, T{-1}};
+  }
+}
+
+// NaN of either sign with one of a few payloads, so equal NaNs are not all alike
+template <typename T>
+T NaNHeavyValue(std::mt19937_64 &gen) {
+  using Limits = std::numeric_limits<T>;
+  if constexpr (std::is_floating_point_v<T>) {
+    constexpr std::array<const char *, 4> kPayloads = {"", "1", "7", "4095"};
+    const T nan = std::nan(kPayloads.at(gen() % kPayloads.size()));
+    return gen() % 2 == 0 ? nan : -nan;
+  } else {
+    return gen() % 2 == 0 ? Limits::min() : Limits::max();
+  }
+}
+
+// Zipf rank of a uniform draw, mapped to a scattered value so that the
+// frequent values are not the smallest ones
+template <typename T>
+T ZipfValue(const std::vector<double> &cumulative, std::mt19937_64 &gen) {
+  const double draw = std::uniform_real_distribution<double>(0, cumulative.back())(gen);
+  const auto rank = static_cast<uint64_t>(std::ranges::upper_bound(cumulative, draw) - cumulative.begin());
+  const auto value = static_cast<int64_t>((rank * 2654435761ULL) % 2000000000ULL) - 1000000000;
+  if constexpr (std::is_floating_point_v<T>) {
+    return static_cast<T>(value) / 1000;
+  } else {
+    return static_cast<T>(value);
+  }
+}
+
+template <typename T>
+std::vector<T> Generate(SortDistribution distribution, size_t size, uint64_t seed) {
+  std::mt19937_64 gen(seed);
+  std::vector<T> data(size);
+  const auto fill = [&](auto &&value) { std::ranges::generate(data, value); };
+
+  if (distribution == SortDistribution::kUniform) {
+    fill([&] { return UniformValue<T>(gen); });
+  } else if (distribution == SortDistribution::kSorted || distribution == SortDistribution::kNearlySorted) {
+    fill([&] { return UniformValue<T>(gen); });
+    std::ranges::sort(data);
+    if (distribution == SortDistribution::kNearlySorted && size > 1) {
+      std::uniform_int_distribution<size_t> index(0, size - 1);
+      for (size_t swap = 0; swap < size / 100; swap++) {
+        std::swap(data[index(gen)], data[index(gen)]);
+      }
+    }
+  } else if (distribution == SortDistribution::kReverse) {
+    fill([&] { return UniformValue<T>(gen); });
+    std::ranges::sort(data, std::greater<>());
+  } else if (distribution == SortDistribution::kFewUnique) {
+    std::array<T, 16> values{};
+    std::ranges::generate(values, [&] { return UniformValue<T>(gen); });
+    std::uniform_int_distribution<size_t> index(0, values.size() - 1);
+    fill([&] { return values[index(gen)]; });
+  } else if (distribution == SortDistribution::kZipf) {
+    std::vector<double> cumulative(std::min(std::max<size_t>(size, 1), kZipfRanks));
+    double sum = 0;
+    for (size_t rank = 0; rank < cumulative.size(); rank++) {
+      sum += 1 / std::pow(static_cast<double>(rank + 1), kZipfSkew);
+      cumulative[rank] = sum;
+    }
+    fill([&] { return ZipfValue<T>(cumulative, gen); });
+  } else if (distribution == SortDistribution::kAllEqual) {
+    fill([] { return T{42}; });
+  } else if (distribution == SortDistribution::kOrganPipe) {
+    for (size_t i = 0; i < size; i++) {
+      data[i] = static_cast<T>(std::min(i, size - 1 - i));
+    }
+  } else if (distribution == SortDistribution::kSpecial) {
+    const auto special = SpecialValues<T>();
+    std::uniform_int_distribution<size_t> index(0, (special.size() * 4) - 1);
+    fill([&] {
+      const size_t pick = index(gen);
+      return pick < special.size() ? special[pick] : UniformValue<T>(gen);
+    });
+  } else if (distribution == SortDistribution::kHugeRange) {
+    fill([&] { return HugeRangeValue<T>(gen); });
+  } else {
+    fill([&] { return gen() % 2 == 0 ? NaNHeavyValue<T>(gen) : UniformValue<T>(gen); });
+  }
+  return data;
+}
+
+}  // namespace
+
+std::span<const ppc::util::SortDistribution> ppc::util::GetSortDistributions() { return kDistributions; }
+
+std::string ppc::util::GetSortDistributionName(SortDistribution distribution) {
+  return kNames.at(static_cast<size_t>(distribution));
+}
+
+ppc::util::SortDistribution ppc::util::ParseSortDistribution(const std::string &name) {
+  const auto *it = std::ranges::find(kNames, name);
+  if (it == kNames.end()) {
+    throw std::invalid_argument("Unknown sort distribution: " + name);
+  }
+  return kDistributions.at(static_cast<size_t>(it - kNames.begin()));
+}
+
+template <typename T>
+std::vector<T> ppc::util::GenerateSortData(SortDistribution distribution, size_t size, uint64_t seed) {
+  return Generate<T>(distribution, size, seed);
+}
+
+template std::vector<int32_t> ppc::util::GenerateSortData<int32_t>(SortDistribution, size_t, uint64_t);
+template std::vector<double> ppc::util::GenerateSortData<double>(SortDistribution, size_t, uint64_t);
@@ -0,0 +1,147 @@
+#include "core/util/include/sorting_network.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include "core/util/include/simd.hpp"
+#include "core/util/src/sorting_network_kernels.hpp"
+
+namespace {
+
+// Branch-free on the comparison: the select compiles to a conditional move
+template <typename T>
+void ScalarMerge(std::span<const T> a, std::span<const T> b, T *out) {
+  size_t i = 0;
+  size_t j = 0;
+  while (i < a.size() && j < b.size()) {
+    const bool take_b = b[j] < a[i];
+    *out++ = take_b ? b[j] : a[i];
+    j += take_b ? 1 : 0;
+    i += take_b ? 0 : 1;
+  }
+  // b may start right after the output, so copy element by element
+  while (i < a.size()) {
+    *out++ = a[i++];
+  }
+  while (j < b.size()) {
+    *out++ = b[j++];
+  }
+}
+
+// Runs sorted by Sort() or a radix sort: negative NaNs first, positive NaNs last
+template <typename T>
+bool HasNaNEnds(std::span<const T> run) {
+  return !run.empty() && (std::isnan(run.front()) || std::isnan(run.back()));
+}
+
+template <typename T>
+std::span<const T> NegativeNaNs(std::span<const T> run) {
+  const auto end = std::ranges::find_if(run, [](T value) { return !std::isnan(value) || !std::signbit(value); });
+  return run.first(static_cast<size_t>(end - run.begin()));
+}
+
+template <typename T>
+std::span<const T> PositiveNaNs(std::span<const T> run) {
+  size_t count = 0;
+  while (count < run.size() && std::isnan(run[run.size() - 1 - count]) && !std::signbit(run[run.size() - 1 - count])) {
+    count++;
+  }
+  return run.last(count);
+}
+
+template <typename T>
+void MergeNetwork(std::span<const T> a, std::span<const T> b, T *out, [[maybe_unused]] ppc::util::SimdLevel level) {
+#ifdef PPC_SIMD_X86
+  const auto effective = std::min(level, ppc::util::GetSupportedSimdLevel());
+  if (effective == ppc::util::SimdLevel::kAvx512) {
+    ppc::util::detail::NetworkMergeAvx512(a.data(), a.size(), b.data(), b.size(), out);
+    return;
+  }
+  if (effective == ppc::util::SimdLevel::kAvx2) {
+    ppc::util::detail::NetworkMergeAvx2(a.data(), a.size(), b.data(), b.size(), out);
+    return;
+  }
+#endif
+  ScalarMerge(a, b, out);
+}
+
+template <typename T>
+void Merge(std::span<const T> a, std::span<const T> b, T *out, ppc::util::SimdLevel level) {
+  // a NaN in the network blocks the values compared with it: the NaN ends of
+  // the runs are moved around the merge, b is copied as it may overlap out
+  if constexpr (std::is_floating_point_v<T>) {
+    if (HasNaNEnds(a) || HasNaNEnds(b)) {
+      const std::vector<T> b_copy(b.begin(), b.end());
+      const std::span<const T> b_run(b_copy);
+      const auto a_negative = NegativeNaNs(a);
+      const auto b_negative = NegativeNaNs(b_run);
+      const auto a_positive = PositiveNaNs(a.subspan(a_negative.size()));
+      const auto b_positive = PositiveNaNs(b_run.subspan(b_negative.size()));
+      out = std::ranges::copy(a_negative, out).out;
+      out = std::ranges::copy(b_negative, out).out;
+      const auto a_values = a.subspan(a_negative.size(), a.size() - a_negative.size() - a_positive.size());
+      const auto b_values = b_run.subspan(b_negative.size(), b_run.size() - b_negative.size() - b_positive.size());
+      MergeNetwork(a_values, b_values, out, level);
+      out += a_values.size() + b_values.size();
+      out = std::ranges::copy(a_positive, out).out;
+      std::ranges::copy(b_positive, out);
+      return;
+    }
+  }
+  MergeNetwork(a, b, out, level);
+}
+
+template <typename T>
+void Sort(std::span<T> data, [[maybe_unused]] ppc::util::SimdLevel level) {
+  if (data.size() <= 1) {
+    return;
+  }
+  // a NaN in a network blocks the values compared with it, so NaNs are moved
+  // out first to where the radix sorts put them: -NaN first, NaN last
+  if constexpr (std::is_floating_point_v<T>) {
+    if (std::ranges::any_of(data, [](T value) { return std::isnan(value); })) {
+      auto rest = std::ranges::partition(data, [](T value) { return std::isnan(value) && std::signbit(value); });
+      auto positive_nans = std::ranges::partition(rest, [](T value) { return !std::isnan(value); });
+      Sort(std::span<T>(rest.begin(), positive_nans.begin()), level);
+      return;
+    }
+  }
+#ifdef PPC_SIMD_X86
+  const auto effective = std::min(level, ppc::util::GetSupportedSimdLevel());
+  if (effective != ppc::util::SimdLevel::kScalar) {
+    std::vector<T> buffer(data.size());
+    if (effective == ppc::util::SimdLevel::kAvx512) {
+      ppc::util::detail::NetworkSortAvx512(data.data(), buffer.data(), data.size());
+    } else {
+      ppc::util::detail::NetworkSortAvx2(data.data(), buffer.data(), data.size());
+    }
+    return;
+  }
+#endif
+  std::ranges::sort(data);
+}
+
+}  // namespace
+
+void ppc::util::NetworkMerge(std::span<const int32_t> a, std::span<const int32_t> b, int32_t *out, SimdLevel level) {
+  Merge(a, b, out, level);
+}
+
+void ppc::util::NetworkMerge(std::span<const float> a, std::span<const float> b, float *out, SimdLevel level) {
+  Merge(a, b, out, level);
+}
+
+void ppc::util::NetworkMerge(std::span<const double> a, std::span<const double> b, double *out, SimdLevel level) {
+  Merge(a, b, out, level);
+}
+
+void ppc::util::NetworkSort(std::span<int32_t> data, SimdLevel level) { Sort(data, level); }
+
+void ppc::util::NetworkSort(std::span<float> data, SimdLevel level) { Sort(data, level); }
+
+void ppc::util::NetworkSort(std::span<double> data, SimdLevel level) { Sort(data, level); }
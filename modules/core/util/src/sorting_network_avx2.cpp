@@ -0,0 +1,130 @@
+#include <cstddef>
+#include <cstdint>
+
+#include "core/util/include/sorting_network.hpp"
+
+#ifdef PPC_SIMD_X86
+
+#if defined(__clang__)
+#pragma clang attribute push(__attribute__((target("avx2"))), apply_to = function)
+#else
+#pragma GCC target("avx2")
+#endif
+
+#include <immintrin.h>
+
+#include "core/util/src/sorting_network_kernels.hpp"
+
+namespace {
+
+using ppc::util::detail::kLaneTable;
+using ppc::util::detail::LaneOp;
+using ppc::util::detail::LaneTable;
+
+__m256i LoadTable(const LaneTable &table) { return _mm256_load_si256(reinterpret_cast<const __m256i *>(table.words)); }
+
+struct Int32x8 {
+  using Value = int32_t;
+  using Vec = __m256i;
+  static constexpr int kLanes = 8;
+  static constexpr int kWords = 1;
+
+  static Vec Load(const Value *p) { return _mm256_loadu_si256(reinterpret_cast<const __m256i *>(p)); }
+  static void Store(Value *p, Vec v) { _mm256_storeu_si256(reinterpret_cast<__m256i *>(p), v); }
+  static void MinMax(Vec a, Vec b, Vec &lo, Vec &hi) {
+    lo = _mm256_min_epi32(a, b);
+    hi = _mm256_max_epi32(a, b);
+  }
+  static void KeepMinMax(Vec v, Vec t, Vec &lo, Vec &hi) { MinMax(v, t, lo, hi); }
+  template <LaneOp kOp, int kArg>
+  static Vec Permute(Vec v) {
+    return _mm256_permutevar8x32_epi32(v, LoadTable(kLaneTable<kLanes, kWords, kOp, kArg>));
+  }
+  template <int kDist>
+  static Vec Blend(Vec lo, Vec hi) {
+    return _mm256_blendv_epi8(lo, hi, LoadTable(kLaneTable<kLanes, kWords, LaneOp::kMask, kDist>));
+  }
+};
+
+// Floating point min/max select by comparison instead of vminps/vmaxps, so the
+// outputs are a permutation of the inputs even for -0.0 and 0.0
+struct Float32x8 {
+  using Value = float;
+  using Vec = __m256;
+  static constexpr int kLanes = 8;
+  static constexpr int kWords = 1;
+
+  static Vec Load(const Value *p) { return _mm256_loadu_ps(p); }
+  static void Store(Value *p, Vec v) { _mm256_storeu_ps(p, v); }
+  static void MinMax(Vec a, Vec b, Vec &lo, Vec &hi) {
+    const Vec less = _mm256_cmp_ps(a, b, _CMP_LT_OQ);
+    lo = _mm256_blendv_ps(b, a, less);
+    hi = _mm256_blendv_ps(a, b, less);
+  }
+  static void KeepMinMax(Vec v, Vec t, Vec &lo, Vec &hi) {
+    lo = _mm256_blendv_ps(v, t, _mm256_cmp_ps(t, v, _CMP_LT_OQ));
+    hi = _mm256_blendv_ps(v, t, _mm256_cmp_ps(v, t, _CMP_LT_OQ));
+  }
+  template <LaneOp kOp, int kArg>
+  static Vec Permute(Vec v) {
+    return _mm256_permutevar8x32_ps(v, LoadTable(kLaneTable<kLanes, kWords, kOp, kArg>));
+  }
+  template <int kDist>
+  static Vec Blend(Vec lo, Vec hi) {
+    return _mm256_blendv_ps(lo, hi, _mm256_castsi256_ps(LoadTable(kLaneTable<kLanes, kWords, LaneOp::kMask, kDist>)));
+  }
+};
+
+struct Float64x4 {
+  using Value = double;
+  using Vec = __m256d;
+  static constexpr int kLanes = 4;
+  static constexpr int kWords = 2;
+
+  static Vec Load(const Value *p) { return _mm256_loadu_pd(p); }
+  static void Store(Value *p, Vec v) { _mm256_storeu_pd(p, v); }
+  static void MinMax(Vec a, Vec b, Vec &lo, Vec &hi) {
+    const Vec less = _mm256_cmp_pd(a, b, _CMP_LT_OQ);
+    lo = _mm256_blendv_pd(b, a, less);
+    hi = _mm256_blendv_pd(a, b, less);
+  }
+  static void KeepMinMax(Vec v, Vec t, Vec &lo, Vec &hi) {
+    lo = _mm256_blendv_pd(v, t, _mm256_cmp_pd(t, v, _CMP_LT_OQ));
+    hi = _mm256_blendv_pd(v, t, _mm256_cmp_pd(v, t, _CMP_LT_OQ));
+  }
+  template <LaneOp kOp, int kArg>
+  static Vec Permute(Vec v) {
+    const __m256i index = LoadTable(kLaneTable<kLanes, kWords, kOp, kArg>);
+    return _mm256_castps_pd(_mm256_permutevar8x32_ps(_mm256_castpd_ps(v), index));
+  }
+  template <int kDist>
+  static Vec Blend(Vec lo, Vec hi) {
+    return _mm256_blendv_pd(lo, hi, _mm256_castsi256_pd(LoadTable(kLaneTable<kLanes, kWords, LaneOp::kMask, kDist>)));
+  }
+};
+
+}  // namespace
+
+namespace ppc::util::detail {
+
+void NetworkMergeAvx2(const int32_t *a, size_t a_size, const int32_t *b, size_t b_size, int32_t *out) {
+  MergeRuns<Int32x8>(a, a_size, b, b_size, out);
+}
+void NetworkMergeAvx2(const float *a, size_t a_size, const float *b, size_t b_size, float *out) {
+  MergeRuns<Float32x8>(a, a_size, b, b_size, out);
+}
+void NetworkMergeAvx2(const double *a, size_t a_size, const double *b, size_t b_size, double *out) {
+  MergeRuns<Float64x4>(a, a_size, b, b_size, out);
+}
+
+void NetworkSortAvx2(int32_t *data, int32_t *buffer, size_t size) { SortRuns<Int32x8>(data, buffer, size); }
+void NetworkSortAvx2(float *data, float *buffer, size_t size) { SortRuns<Float32x8>(data, buffer, size); }
+void NetworkSortAvx2(double *data, double *buffer, size_t size) { SortRuns<Float64x4>(data, buffer, size); }
+
+}  // namespace ppc::util::detail
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#endif
+
+#endif  // PPC_SIMD_X86
@@ -0,0 +1,145 @@
+#include <cstddef>
+#include <cstdint>
+
+#include "core/util/include/sorting_network.hpp"
+
+#ifdef PPC_SIMD_X86
+
+#if defined(__clang__)
+#pragma clang attribute push(__attribute__((target("avx512f"))), apply_to = function)
+#else
+#pragma GCC target("avx512f")
+// GCC 12 intrinsics pass _mm512_undefined_* values as the unused merge source
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+#include <immintrin.h>
+
+#include "core/util/src/sorting_network_kernels.hpp"
+
+namespace {
+
+using ppc::util::detail::kLaneTable;
+using ppc::util::detail::LaneOp;
+using ppc::util::detail::LaneTable;
+
+__m512i LoadTable(const LaneTable &table) { return _mm512_load_si512(table.words); }
+
+// Lanes with bit kDist set
+template <int kLanes, int kDist>
+constexpr unsigned MakeBlendMask() {
+  unsigned mask = 0;
+  for (int lane = 0; lane < kLanes; lane++) {
+    if ((lane & kDist) != 0) {
+      mask |= 1U << lane;
+    }
+  }
+  return mask;
+}
+
+struct Int32x16 {
+  using Value = int32_t;
+  using Vec = __m512i;
+  static constexpr int kLanes = 16;
+  static constexpr int kWords = 1;
+
+  static Vec Load(const Value *p) { return _mm512_loadu_si512(p); }
+  static void Store(Value *p, Vec v) { _mm512_storeu_si512(p, v); }
+  static void MinMax(Vec a, Vec b, Vec &lo, Vec &hi) {
+    lo = _mm512_min_epi32(a, b);
+    hi = _mm512_max_epi32(a, b);
+  }
+  static void KeepMinMax(Vec v, Vec t, Vec &lo, Vec &hi) { MinMax(v, t, lo, hi); }
+  template <LaneOp kOp, int kArg>
+  static Vec Permute(Vec v) {
+    return _mm512_permutexvar_epi32(LoadTable(kLaneTable<kLanes, kWords, kOp, kArg>), v);
+  }
+  template <int kDist>
+  static Vec Blend(Vec lo, Vec hi) {
+    return _mm512_mask_blend_epi32(static_cast<__mmask16>(MakeBlendMask<kLanes, kDist>()), lo, hi);
+  }
+};
+
+// Floating point min/max select by comparison instead of vminps/vmaxps, so the
+// outputs are a permutation of the inputs even for -0.0 and 0.0
+struct Float32x16 {
+  using Value = float;
+  using Vec = __m512;
+  static constexpr int kLanes = 16;
+  static constexpr int kWords = 1;
+
+  static Vec Load(const Value *p) { return _mm512_loadu_ps(p); }
+  static void Store(Value *p, Vec v) { _mm512_storeu_ps(p, v); }
+  static void MinMax(Vec a, Vec b, Vec &lo, Vec &hi) {
+    const __mmask16 less = _mm512_cmp_ps_mask(a, b, _CMP_LT_OQ);
+    lo = _mm512_mask_blend_ps(less, b, a);
+    hi = _mm512_mask_blend_ps(less, a, b);
+  }
+  static void KeepMinMax(Vec v, Vec t, Vec &lo, Vec &hi) {
+    lo = _mm512_mask_blend_ps(_mm512_cmp_ps_mask(t, v, _CMP_LT_OQ), v, t);
+    hi = _mm512_mask_blend_ps(_mm512_cmp_ps_mask(v, t, _CMP_LT_OQ), v, t);
+  }
+  template <LaneOp kOp, int kArg>
+  static Vec Permute(Vec v) {
+    return _mm512_permutexvar_ps(LoadTable(kLaneTable<kLanes, kWords, kOp, kArg>), v);
+  }
+  template <int kDist>
+  static Vec Blend(Vec lo, Vec hi) {
+    return _mm512_mask_blend_ps(static_cast<__mmask16>(MakeBlendMask<kLanes, kDist>()), lo, hi);
+  }
+};
+
+struct Float64x8 {
+  using Value = double;
+  using Vec = __m512d;
+  static constexpr int kLanes = 8;
+  static constexpr int kWords = 2;
+
+  static Vec Load(const Value *p) { return _mm512_loadu_pd(p); }
+  static void Store(Value *p, Vec v) { _mm512_storeu_pd(p, v); }
+  static void MinMax(Vec a, Vec b, Vec &lo, Vec &hi) {
+    const __mmask8 less = _mm512_cmp_pd_mask(a, b, _CMP_LT_OQ);
+    lo = _mm512_mask_blend_pd(less, b, a);
+    hi = _mm512_mask_blend_pd(less, a, b);
+  }
+  static void KeepMinMax(Vec v, Vec t, Vec &lo, Vec &hi) {
+    lo = _mm512_mask_blend_pd(_mm512_cmp_pd_mask(t, v, _CMP_LT_OQ), v, t);
+    hi = _mm512_mask_blend_pd(_mm512_cmp_pd_mask(v, t, _CMP_LT_OQ), v, t);
+  }
+  template <LaneOp kOp, int kArg>
+  static Vec Permute(Vec v) {
+    const __m512i index = LoadTable(kLaneTable<kLanes, kWords, kOp, kArg>);
+    return _mm512_castsi512_pd(_mm512_permutexvar_epi32(index, _mm512_castpd_si512(v)));
+  }
+  template <int kDist>
+  static Vec Blend(Vec lo, Vec hi) {
+    return _mm512_mask_blend_pd(static_cast<__mmask8>(MakeBlendMask<kLanes, kDist>()), lo, hi);
+  }
+};
+
+}  // namespace
+
+namespace ppc::util::detail {
+
+void NetworkMergeAvx512(const int32_t *a, size_t a_size, const int32_t *b, size_t b_size, int32_t *out) {
+  MergeRuns<Int32x16>(a, a_size, b, b_size, out);
+}
+void NetworkMergeAvx512(const float *a, size_t a_size, const float *b, size_t b_size, float *out) {
+  MergeRuns<Float32x16>(a, a_size, b, b_size, out);
+}
+void NetworkMergeAvx512(const double *a, size_t a_size, const double *b, size_t b_size, double *out) {
+  MergeRuns<Float64x8>(a, a_size, b, b_size, out);
+}
+
+void NetworkSortAvx512(int32_t *data, int32_t *buffer, size_t size) { SortRuns<Int32x16>(data, buffer, size); }
+void NetworkSortAvx512(float *data, float *buffer, size_t size) { SortRuns<Float32x16>(data, buffer, size); }
+void NetworkSortAvx512(double *data, double *buffer, size_t size) { SortRuns<Float64x8>(data, buffer, size); }
+
+}  // namespace ppc::util::detail
+
+#if defined(__clang__)
+#pragma clang attribute pop
+#endif
+
+#endif  // PPC_SIMD_X86
@@ -0,0 +1,216 @@
+#pragma once
+
+// Entry points of the instruction set specific kernels and the generic bitonic
+// kernels they are built from. sorting_network_avx2.cpp and
+// sorting_network_avx512.cpp include this after their target pragma: the
+// kernels are instantiated for register types S defined in that unit only and
+// use no standard library templates, so the linker cannot pick code compiled
+// for one instruction set in place of another.
+//
+// S provides Value, Vec, kLanes, kWords (32-bit words per lane), Load, Store,
+// MinMax(a, b, lo, hi) taking a on ties for lo and b for hi, KeepMinMax(v, t,
+// lo, hi) taking v on ties for both, Permute<LaneOp, arg>(v) and
+// Blend<dist>(lo, hi) taking hi in the lanes with bit dist set.
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ppc::util::detail {
+
+// Merge of sorted a and b to out, see NetworkMerge
+void NetworkMergeAvx2(const int32_t *a, size_t a_size, const int32_t *b, size_t b_size, int32_t *out);
+void NetworkMergeAvx2(const float *a, size_t a_size, const float *b, size_t b_size, float *out);
+void NetworkMergeAvx2(const double *a, size_t a_size, const double *b, size_t b_size, double *out);
+void NetworkMergeAvx512(const int32_t *a, size_t a_size, const int32_t *b, size_t b_size, int32_t *out);
+void NetworkMergeAvx512(const float *a, size_t a_size, const float *b, size_t b_size, float *out);
+void NetworkMergeAvx512(const double *a, size_t a_size, const double *b, size_t b_size, double *out);
+
+// Sort of data using buffer of the same size
+void NetworkSortAvx2(int32_t *data, int32_t *buffer, size_t size);
+void NetworkSortAvx2(float *data, float *buffer, size_t size);
+void NetworkSortAvx2(double *data, double *buffer, size_t size);
+void NetworkSortAvx512(int32_t *data, int32_t *buffer, size_t size);
+void NetworkSortAvx512(float *data, float *buffer, size_t size);
+void NetworkSortAvx512(double *data, double *buffer, size_t size);
+
+enum class LaneOp : uint8_t { kSwap, kReverse, kReverseUpper, kMask };
+
+// Permutation indices (or blend masks) of one register in 32-bit words
+struct LaneTable {
+  alignas(64) int32_t words[16];
+};
+
+// kSwap: lane i takes lane i ^ arg; kReverse: lanes in reverse order;
+// kReverseUpper: the upper half of every block of arg lanes is reversed;
+// kMask: all bits set in the lanes with bit arg set
+template <int kLanes, int kWords, LaneOp kOp, int kArg>
+constexpr LaneTable MakeLaneTable() {
+  LaneTable table{};
+  for (int lane = 0; lane < kLanes; lane++) {
+    int source = lane;
+    if (kOp == LaneOp::kSwap) {
+      source = lane ^ kArg;
+    } else if (kOp == LaneOp::kReverse) {
+      source = kLanes - 1 - lane;
+    } else if (kOp == LaneOp::kReverseUpper && (lane & (kArg / 2)) != 0) {
+      source = lane ^ ((kArg / 2) - 1);
+    }
+    for (int word = 0; word < kWords; word++) {
+      if (kOp == LaneOp::kMask) {
+        table.words[(lane * kWords) + word] = (lane & kArg) != 0 ? -1 : 0;
+      } else {
+        table.words[(lane * kWords) + word] = (source * kWords) + word;
+      }
+    }
+  }
+  return table;
+}
+
+template <int kLanes, int kWords, LaneOp kOp, int kArg>
+inline constexpr LaneTable kLaneTable = MakeLaneTable<kLanes, kWords, kOp, kArg>();
+
+// Bitonic register to sorted: compare-exchange at distances kDist, kDist / 2, ..., 1
+template <typename S, int kDist>
+typename S::Vec BitonicClean(typename S::Vec v) {
+  if constexpr (kDist >= 1) {
+    typename S::Vec lo;
+    typename S::Vec hi;
+    // both lanes of a pair keep their own value on ties, so equal floating point
+    // values that differ in bits (-0.0 and 0.0) are not duplicated
+    S::KeepMinMax(v, S::template Permute<LaneOp::kSwap, kDist>(v), lo, hi);
+    return BitonicClean<S, kDist / 2>(S::template Blend<kDist>(lo, hi));
+  } else {
+    return v;
+  }
+}
+
+// Bitonic sort of one register: blocks of kBlock lanes are merged from sorted halves
+template <typename S, int kBlock = 2>
+typename S::Vec SortRegister(typename S::Vec v) {
+  if constexpr (kBlock <= S::kLanes) {
+    if constexpr (kBlock > 2) {
+      v = S::template Permute<LaneOp::kReverseUpper, kBlock>(v);
+    }
+    return SortRegister<S, kBlock * 2>(BitonicClean<S, kBlock / 2>(v));
+  } else {
+    return v;
+  }
+}
+
+// Two sorted registers to the lower and the upper half of their merge
+template <typename S>
+void MergeRegisters(typename S::Vec &a, typename S::Vec &b) {
+  typename S::Vec lo;
+  typename S::Vec hi;
+  S::MinMax(a, S::template Permute<LaneOp::kReverse, 0>(b), lo, hi);
+  a = BitonicClean<S, S::kLanes / 2>(lo);
+  b = BitonicClean<S, S::kLanes / 2>(hi);
+}
+
+template <typename S>
+void ScalarMerge(const typename S::Value *a, size_t a_size, const typename S::Value *b, size_t b_size,
+                 typename S::Value *out) {
+  size_t i = 0;
+  size_t j = 0;
+  while (i < a_size && j < b_size) {
+    const bool take_b = b[j] < a[i];
+    *out++ = take_b ? b[j] : a[i];
+    j += take_b ? 1 : 0;
+    i += take_b ? 0 : 1;
+  }
+  while (i < a_size) {
+    *out++ = a[i++];
+  }
+  while (j < b_size) {
+    *out++ = b[j++];
+  }
+}
+
+template <typename S>
+void InsertionSort(typename S::Value *data, size_t size) {
+  for (size_t i = 1; i < size; i++) {
+    const auto value = data[i];
+    size_t j = i;
+    for (; j > 0 && value < data[j - 1]; j--) {
+      data[j] = data[j - 1];
+    }
+    data[j] = value;
+  }
+}
+
+// Merge of two sorted runs one register at a time: the register with the
+// smaller head is loaded next, so the only branch is one per register
+template <typename S>
+void MergeRuns(const typename S::Value *a, size_t a_size, const typename S::Value *b, size_t b_size,
+               typename S::Value *out) {
+  constexpr auto kLanes = static_cast<size_t>(S::kLanes);
+  if (a_size < kLanes || b_size < kLanes) {
+    ScalarMerge<S>(a, a_size, b, b_size, out);
+    return;
+  }
+  typename S::Vec low = S::Load(a);
+  typename S::Vec high = S::Load(b);
+  size_t i = kLanes;
+  size_t j = kLanes;
+  bool take_a = false;
+  while (true) {
+    MergeRegisters<S>(low, high);
+    S::Store(out, low);
+    out += kLanes;
+    take_a = j >= b_size || (i < a_size && a[i] <= b[j]);
+    if (take_a ? a_size - i < kLanes : b_size - j < kLanes) {
+      break;
+    }
+    if (take_a) {
+      low = S::Load(a + i);
+      i += kLanes;
+    } else {
+      low = S::Load(b + j);
+      j += kLanes;
+    }
+  }
+
+  // high and the short rest of the run chosen last go to a small buffer that is
+  // merged with the rest of the other run
+  typename S::Value held[S::kLanes];
+  typename S::Value tail[2 * S::kLanes];
+  S::Store(held, high);
+  const auto *short_rest = take_a ? a + i : b + j;
+  const size_t short_size = take_a ? a_size - i : b_size - j;
+  const auto *long_rest = take_a ? b + j : a + i;
+  const size_t long_size = take_a ? b_size - j : a_size - i;
+  ScalarMerge<S>(held, kLanes, short_rest, short_size, tail);
+  ScalarMerge<S>(tail, kLanes + short_size, long_rest, long_size, out);
+}
+
+// Sorts every full register of data, then merges runs bottom-up between data
+// and buffer (size elements each)
+template <typename S>
+void SortRuns(typename S::Value *data, typename S::Value *buffer, size_t size) {
+  constexpr auto kLanes = static_cast<size_t>(S::kLanes);
+  const size_t full = size - (size % kLanes);
+  for (size_t i = 0; i < full; i += kLanes) {
+    S::Store(data + i, SortRegister<S>(S::Load(data + i)));
+  }
+  InsertionSort<S>(data + full, size - full);
+
+  auto *src = data;
+  auto *dst = buffer;
+  for (size_t width = kLanes; width < size; width *= 2) {
+    for (size_t start = 0; start < size; start += 2 * width) {
+      const size_t mid = size - start > width ? start + width : size;
+      const size_t end = size - start > 2 * width ? start + (2 * width) : size;
+      MergeRuns<S>(src + start, mid - start, src + mid, end - mid, dst + start);
+    }
+    auto *swap = src;
+    src = dst;
+    dst = swap;
+  }
+  if (src != data) {
+    for (size_t i = 0; i < size; i++) {
+      data[i] = src[i];
+    }
+  }
+}
+
+}  // namespace ppc::util::detail
@@ -0,0 +1,365 @@
+#include "core/util/include/strassen.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+
+#include "core/util/include/gemm.hpp"
+
+namespace {
+
+// Elements a task of a parallel addition pass covers at least
+constexpr size_t kMinAddChunk = size_t{1} << 14;
+
+// Row-major view into a larger matrix
+struct Block {
+  double *data;
+  size_t ld;
+
+  [[nodiscard]] Block At(size_t row, size_t col) const { return {.data = data + (row * ld) + col, .ld = ld}; }
+};
+
+struct ConstBlock {
+  const double *data;
+  size_t ld;
+
+  ConstBlock(const double *values, size_t stride) : data(values), ld(stride) {}
+  ConstBlock(Block block) : data(block.data), ld(block.ld) {}
+
+  [[nodiscard]] ConstBlock At(size_t row, size_t col) const { return {data + (row * ld) + col, ld}; }
+};
+
+bool IsLeaf(size_t m, size_t n, size_t k, size_t crossover) {
+  const size_t smallest = std::min({m, n, k});
+  return smallest < 2 || smallest <= crossover;
+}
+
+// out = x - y over rows x cols, out may be x or y
+void Subtract(size_t rows, size_t cols, ConstBlock x, ConstBlock y, Block out) {
+  for (size_t i = 0; i < rows; i++) {
+    const double *x_row = x.data + (i * x.ld);
+    const double *y_row = y.data + (i * y.ld);
+    double *out_row = out.data + (i * out.ld);
+    for (size_t j = 0; j < cols; j++) {
+      out_row[j] = x_row[j] - y_row[j];
+    }
+  }
+}
+
+// out = x + y over rows x cols, out may be x or y
+void Add(size_t rows, size_t cols, ConstBlock x, ConstBlock y, Block out) {
+  for (size_t i = 0; i < rows; i++) {
+    const double *x_row = x.data + (i * x.ld);
+    const double *y_row = y.data + (i * y.ld);
+    double *out_row = out.data + (i * out.ld);
+    for (size_t j = 0; j < cols; j++) {
+      out_row[j] = x_row[j] + y_row[j];
+    }
+  }
+}
+
+void Multiply(size_t m, size_t n, size_t k, ConstBlock a, ConstBlock b, Block c, double *workspace, size_t crossover);
+
+// Products of the even part of the operands, in the two-temporary schedule
+// of Boyer, Dumas, Pernet and Zhou: X (m/2 x max(k/2, n/2)) holds the A
+// sums and P1, Y (k/2 x n/2) the B sums, the quadrants of C the other
+// products until they are combined
+void MultiplyEven(size_t m, size_t n, size_t k, ConstBlock a, ConstBlock b, Block c, double *workspace,
+                  size_t crossover) {
+  const size_t m2 = m / 2;
+  const size_t n2 = n / 2;
+  const size_t k2 = k / 2;
+  const ConstBlock a11 = a;
+  const ConstBlock a12 = a.At(0, k2);
+  const ConstBlock a21 = a.At(m2, 0);
+  const ConstBlock a22 = a.At(m2, k2);
+  const ConstBlock b11 = b;
+  const ConstBlock b12 = b.At(0, n2);
+  const ConstBlock b21 = b.At(k2, 0);
+  const ConstBlock b22 = b.At(k2, n2);
+  const Block c11 = c;
+  const Block c12 = c.At(0, n2);
+  const Block c21 = c.At(m2, 0);
+  const Block c22 = c.At(m2, n2);
+
+  const Block x = {.data = workspace, .ld = std::max(k2, n2)};
+  const Block y = {.data = x.data + (m2 * x.ld), .ld = n2};
+  double *next = y.data + (k2 * y.ld);
+  const auto product = [&](ConstBlock lhs, ConstBlock rhs, Block out) {
+    Multiply(m2, n2, k2, lhs, rhs, out, next, crossover);
+  };
+
+  Subtract(m2, k2, a11, a21, x);  // S3
+  Subtract(k2, n2, b22, b12, y);  // T3
+  product(x, y, c21);             // P7
+  Add(m2, k2, a21, a22, x);       // S1
+  Subtract(k2, n2, b12, b11, y);  // T1
+  product(x, y, c22);             // P5
+  Subtract(m2, k2, x, a11, x);    // S2
+  Subtract(k2, n2, b22, y, y);    // T2
+  product(x, y, c12);             // P6
+  Subtract(m2, k2, a12, x, x);    // S4
+  product(x, b22, c11);           // P3
+  product(a11, b11, x);           // P1
+
+  // U2 = P1 + P6, U3 = U2 + P7, U4 = U2 + P5, C22 = U3 + P5, C12 = U4 + P3
+  for (size_t i = 0; i < m2; i++) {
+    const double *p1 = x.data + (i * x.ld);
+    const double *p3 = c11.data + (i * c.ld);
+    double *c12_row = c12.data + (i * c.ld);
+    double *c21_row = c21.data + (i * c.ld);
+    double *c22_row = c22.data + (i * c.ld);
+    for (size_t j = 0; j < n2; j++) {
+      const double u2 = p1[j] + c12_row[j];
+      const double u3 = u2 + c21_row[j];
+      const double u4 = u2 + c22_row[j];
+      c22_row[j] += u3;
+      c12_row[j] = u4 + p3[j];
+      c21_row[j] = u3;
+    }
+  }
+
+  Subtract(k2, n2, y, b21, y);      // T4
+  product(a22, y, c11);             // P4
+  Subtract(m2, n2, c21, c11, c21);  // C21 = U3 - P4
+  product(a12, b21, c11);           // P2
+  Add(m2, n2, c11, x, c11);         // C11 = P1 + P2
+}
+
+// Dynamic peeling after the product of the even part: the rank-1 term of an
+// odd k, then the last column and row
+void AddPeeled(size_t m, size_t n, size_t k, ConstBlock a, ConstBlock b, Block c) {
+  const size_t m_even = m & ~size_t{1};
+  const size_t n_even = n & ~size_t{1};
+  const size_t k_even = k & ~size_t{1};
+  if (k_even != k) {
+    ppc::util::Gemm(m_even, n_even, 1, 1.0, a.data + k_even, a.ld, b.data + (k_even * b.ld), b.ld, 1.0, c.data, c.ld);
+  }
+  if (n_even != n) {
+    ppc::util::Gemm(m, 1, k, 1.0, a.data, a.ld, b.data + n_even, b.ld, 0.0, c.data + n_even, c.ld);
+  }
+  if (m_even != m) {
+    ppc::util::Gemm(1, n_even, k, 1.0, a.data + (m_even * a.ld), a.ld, b.data, b.ld, 0.0, c.data + (m_even * c.ld),
+                    c.ld);
+  }
+}
+
+void Multiply(size_t m, size_t n, size_t k, ConstBlock a, ConstBlock b, Block c, double *workspace, size_t crossover) {
+  if (IsLeaf(m, n, k, crossover)) {
+    ppc::util::Gemm(m, n, k, 1.0, a.data, a.ld, b.data, b.ld, 0.0, c.data, c.ld);
+    return;
+  }
+  MultiplyEven(m & ~size_t{1}, n & ~size_t{1}, k & ~size_t{1}, a, b, c, workspace, crossover);
+  AddPeeled(m, n, k, a, b, c);
+}
+
+size_t WorkspaceSize(size_t m, size_t n, size_t k, size_t crossover, size_t depth) {
+  if (IsLeaf(m, n, k, crossover)) {
+    return 0;
+  }
+  const size_t m2 = m / 2;
+  const size_t n2 = n / 2;
+  const size_t k2 = k / 2;
+  if (depth == 0) {
+    return (m2 * std::max(k2, n2)) + (k2 * n2) + WorkspaceSize(m2, n2, k2, crossover, 0);
+  }
+  return (4 * m2 * k2) + (4 * k2 * n2) + (3 * m2 * n2) + (7 * WorkspaceSize(m2, n2, k2, crossover, depth - 1));
+}
+
+size_t PowerOfSeven(size_t exponent) {
+  size_t power = 1;
+  for (size_t i = 0; i < exponent; i++) {
+    power *= 7;
+  }
+  return power;
+}
+
+// Rows of cols elements a task of a parallel addition pass covers
+size_t RowChunk(size_t cols) { return std::max<size_t>(1, kMinAddChunk / std::max<size_t>(cols, 1)); }
+
+size_t NumChunks(size_t rows, size_t chunk) { return (rows + chunk - 1) / chunk; }
+
+// S1 = A21 + A22, S2 = S1 - A11, S3 = A11 - A21, S4 = A12 - S2 over rows
+// [begin, end) of the quadrants 11, 12, 21, 22 of A
+void FormASums(size_t begin, size_t end, size_t cols, const std::array<ConstBlock, 4> &a,
+               const std::array<Block, 4> &s) {
+  for (size_t i = begin; i < end; i++) {
+    const double *a11 = a[0].At(i, 0).data;
+    const double *a12 = a[1].At(i, 0).data;
+    const double *a21 = a[2].At(i, 0).data;
+    const double *a22 = a[3].At(i, 0).data;
+    double *s1 = s[0].At(i, 0).data;
+    double *s2 = s[1].At(i, 0).data;
+    double *s3 = s[2].At(i, 0).data;
+    double *s4 = s[3].At(i, 0).data;
+    for (size_t j = 0; j < cols; j++) {
+      s1[j] = a21[j] + a22[j];
+      s2[j] = s1[j] - a11[j];
+      s3[j] = a11[j] - a21[j];
+      s4[j] = a12[j] - s2[j];
+    }
+  }
+}
+
+// T1 = B12 - B11, T2 = B22 - T1, T3 = B22 - B12, T4 = T2 - B21 likewise
+void FormBSums(size_t begin, size_t end, size_t cols, const std::array<ConstBlock, 4> &b,
+               const std::array<Block, 4> &t) {
+  for (size_t i = begin; i < end; i++) {
+    const double *b11 = b[0].At(i, 0).data;
+    const double *b12 = b[1].At(i, 0).data;
+    const double *b21 = b[2].At(i, 0).data;
+    const double *b22 = b[3].At(i, 0).data;
+    double *t1 = t[0].At(i, 0).data;
+    double *t2 = t[1].At(i, 0).data;
+    double *t3 = t[2].At(i, 0).data;
+    double *t4 = t[3].At(i, 0).data;
+    for (size_t j = 0; j < cols; j++) {
+      t1[j] = b12[j] - b11[j];
+      t2[j] = b22[j] - t1[j];
+      t3[j] = b22[j] - b12[j];
+      t4[j] = t2[j] - b21[j];
+    }
+  }
+}
+
+void ParallelMultiply(size_t m, size_t n, size_t k, ConstBlock a, ConstBlock b, Block c, double *workspace,
+                      const ppc::util::StrassenParallelFor &parallel_for, size_t depth, size_t crossover);
+
+// One parallel level: all operand sums in one pass, the 7 products as tasks
+// with separate outputs (P2, P3, P4 and P7 in the quadrants of C, the others
+// in the workspace), and one pass combining them in place
+void ParallelMultiplyEven(size_t m, size_t n, size_t k, ConstBlock a, ConstBlock b, Block c, double *workspace,
+                          const ppc::util::StrassenParallelFor &parallel_for, size_t depth, size_t crossover) {
+  const size_t m2 = m / 2;
+  const size_t n2 = n / 2;
+  const size_t k2 = k / 2;
+  const std::array<ConstBlock, 4> a_quadrants = {a, a.At(0, k2), a.At(m2, 0), a.At(m2, k2)};
+  const std::array<ConstBlock, 4> b_quadrants = {b, b.At(0, n2), b.At(k2, 0), b.At(k2, n2)};
+  const std::array<Block, 4> c_quadrants = {c, c.At(0, n2), c.At(m2, 0), c.At(m2, n2)};
+
+  double *next = workspace;
+  const auto take = [&next](size_t rows, size_t cols) {
+    const Block block = {.data = next, .ld = cols};
+    next += rows * cols;
+    return block;
+  };
+  const std::array<Block, 4> s = {take(m2, k2), take(m2, k2), take(m2, k2), take(m2, k2)};
+  const std::array<Block, 4> t = {take(k2, n2), take(k2, n2), take(k2, n2), take(k2, n2)};
+  const Block p1 = take(m2, n2);
+  const Block p5 = take(m2, n2);
+  const Block p6 = take(m2, n2);
+  const size_t child_size = WorkspaceSize(m2, n2, k2, crossover, depth - 1);
+
+  const size_t a_chunk = RowChunk(k2);
+  const size_t b_chunk = RowChunk(n2);
+  const size_t a_chunks = NumChunks(m2, a_chunk);
+  parallel_for(a_chunks + NumChunks(k2, b_chunk), [&](size_t chunk) {
+    if (chunk < a_chunks) {
+      FormASums(chunk * a_chunk, std::min(m2, (chunk + 1) * a_chunk), k2, a_quadrants, s);
+    } else {
+      chunk -= a_chunks;
+      FormBSums(chunk * b_chunk, std::min(k2, (chunk + 1) * b_chunk), n2, b_quadrants, t);
+    }
+  });
+
+  struct Product {
+    ConstBlock lhs;
+    ConstBlock rhs;
+    Block out;
+  };
+  const std::array<Product, 7> products = {{
+      {.lhs = a_quadrants[0], .rhs = b_quadrants[0], .out = p1},
+      {.lhs = a_quadrants[1], .rhs = b_quadrants[2], .out = c_quadrants[0]},
+      {.lhs = s[3], .rhs = b_quadrants[3], .out = c_quadrants[1]},
+      {.lhs = a_quadrants[3], .rhs = t[3], .out = c_quadrants[2]},
+      {.lhs = s[0], .rhs = t[0], .out = p5},
+      {.lhs = s[1], .rhs = t[1], .out = p6},
+      {.lhs = s[2], .rhs = t[2], .out = c_quadrants[3]},
+  }};
+  parallel_for(products.size(), [&](size_t i) {
+    ParallelMultiply(m2, n2, k2, products[i].lhs, products[i].rhs, products[i].out, next + (i * child_size),
+                     parallel_for, depth - 1, crossover);
+  });
+
+  // C11 = P1 + P2, C12 = U2 + P5 + P3, C21 = U3 - P4, C22 = U3 + P5 for
+  // U2 = P1 + P6 and U3 = U2 + P7
+  const size_t c_chunk = RowChunk(n2);
+  parallel_for(NumChunks(m2, c_chunk), [&](size_t chunk) {
+    for (size_t i = chunk * c_chunk; i < std::min(m2, (chunk + 1) * c_chunk); i++) {
+      const double *p1_row = p1.At(i, 0).data;
+      const double *p5_row = p5.At(i, 0).data;
+      const double *p6_row = p6.At(i, 0).data;
+      double *c11 = c_quadrants[0].At(i, 0).data;
+      double *c12 = c_quadrants[1].At(i, 0).data;
+      double *c21 = c_quadrants[2].At(i, 0).data;
+      double *c22 = c_quadrants[3].At(i, 0).data;
+      for (size_t j = 0; j < n2; j++) {
+        const double u2 = p1_row[j] + p6_row[j];
+        const double u3 = u2 + c22[j];
+        c11[j] += p1_row[j];
+        c12[j] += u2 + p5_row[j];
+        c21[j] = u3 - c21[j];
+        c22[j] = u3 + p5_row[j];
+      }
+    }
+  });
+}
+
+void ParallelMultiply(size_t m, size_t n, size_t k, ConstBlock a, ConstBlock b, Block c, double *workspace,
+                      const ppc::util::StrassenParallelFor &parallel_for, size_t depth, size_t crossover) {
+  if (depth == 0) {
+    Multiply(m, n, k, a, b, c, workspace, crossover);
+    return;
+  }
+  if (IsLeaf(m, n, k, crossover)) {
+    // as many bands of rows as the remaining levels would have products
+    const size_t num_bands = std::min(m, PowerOfSeven(depth));
+    parallel_for(num_bands, [&](size_t band) {
+      const size_t begin = m * band / num_bands;
+      const size_t end = m * (band + 1) / num_bands;
+      ppc::util::Gemm(end - begin, n, k, 1.0, a.At(begin, 0).data, a.ld, b.data, b.ld, 0.0, c.At(begin, 0).data,
+                      c.ld);
+    });
+    return;
+  }
+  ParallelMultiplyEven(m & ~size_t{1}, n & ~size_t{1}, k & ~size_t{1}, a, b, c, workspace, parallel_for, depth,
+                       crossover);
+  AddPeeled(m, n, k, a, b, c);
+}
+
+}  // namespace
+
+size_t ppc::util::GetStrassenParallelDepth(int num_threads) {
+  if (num_threads <= 1) {
+    return 0;
+  }
+  size_t depth = 0;
+  while (PowerOfSeven(depth) < static_cast<size_t>(num_threads)) {
+    depth++;
+  }
+  return depth;
+}
+
+size_t ppc::util::GetStrassenWorkspaceSize(size_t m, size_t n, size_t k, size_t crossover, size_t parallel_depth) {
+  return WorkspaceSize(m, n, k, crossover, parallel_depth);
+}
+
+void ppc::util::Strassen(size_t m, size_t n, size_t k, const double *a, size_t lda, const double *b, size_t ldb,
+                         double *c, size_t ldc, std::span<double> workspace, size_t crossover) {
+  if (workspace.size() < GetStrassenWorkspaceSize(m, n, k, crossover)) {
+    throw std::invalid_argument("Strassen workspace is too small");
+  }
+  Multiply(m, n, k, {a, lda}, {b, ldb}, {.data = c, .ld = ldc}, workspace.data(), crossover);
+}
+
+void ppc::util::Strassen(size_t m, size_t n, size_t k, const double *a, size_t lda, const double *b, size_t ldb,
+                         double *c, size_t ldc, std::span<double> workspace, const StrassenParallelFor &parallel_for,
+                         size_t parallel_depth, size_t crossover) {
+  if (workspace.size() < GetStrassenWorkspaceSize(m, n, k, crossover, parallel_depth)) {
+    throw std::invalid_argument("Strassen workspace is too small");
+  }
+  ParallelMultiply(m, n, k, {a, lda}, {b, ldb}, {.data = c, .ld = ldc}, workspace.data(), parallel_for,
+                   parallel_depth, crossover);
+}
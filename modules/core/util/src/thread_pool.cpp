@@ -0,0 +1,161 @@
+#include "core/util/include/thread_pool.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include "core/util/include/topology.hpp"
+#include "core/util/include/util.hpp"
+
+namespace {
+
+// pool and queue index of the current worker thread
+thread_local ppc::util::ThreadPool *current_pool = nullptr;
+thread_local size_t current_queue = 0;
+
+}  // namespace
+
+ppc::util::ThreadPool::ThreadPool(int num_threads, Placement placement)
+    : num_threads_(std::max(1, num_threads)), placement_(placement) {
+  const auto num_workers = static_cast<size_t>(num_threads_ - 1);
+  for (size_t i = 0; i <= num_workers; i++) {
+    queues_.emplace_back(std::make_unique<TaskQueue>());
+  }
+  workers_.reserve(num_workers);
+  for (size_t i = 1; i <= num_workers; i++) {
+    workers_.emplace_back([this, i] { WorkerLoop(i); });
+  }
+}
+
+ppc::util::ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(sleep_mutex_);
+    stop_ = true;
+  }
+  wake_up_.notify_all();
+  for (auto &worker : workers_) {
+    worker.join();
+  }
+}
+
+ppc::util::ThreadPool &ppc::util::ThreadPool::Instance() {
+  if (current_pool != nullptr) {
+    return *current_pool;
+  }
+  static std::mutex instance_mutex;
+  static std::unique_ptr<ThreadPool> instance;
+  std::lock_guard<std::mutex> lock(instance_mutex);
+  const int num_threads = std::max(1, GetPPCNumThreads());
+  const Placement placement = GetPPCPlacement();
+  if (!instance || instance->GetNumThreads() != num_threads || instance->placement_ != placement) {
+    instance.reset();
+    instance = std::make_unique<ThreadPool>(num_threads, placement);
+  }
+  return *instance;
+}
+
+int ppc::util::ThreadPool::GetNumThreads() const { return num_threads_; }
+
+void ppc::util::ThreadPool::Submit(std::function<void()> task) {
+  // counted before push: a worker may see the counter early and spin shortly, but never sleeps past a task
+  num_pending_.fetch_add(1, std::memory_order_acq_rel);
+  const size_t index = current_pool == this ? current_queue : 0;
+  {
+    std::lock_guard<std::mutex> lock(queues_[index]->mutex);
+    queues_[index]->tasks.push_back(std::move(task));
+  }
+  if (!workers_.empty()) {
+    // a worker is either before its wake-up check and sees the task or already waits for the notification
+    std::unique_lock<std::mutex> lock(sleep_mutex_);
+    lock.unlock();
+    wake_up_.notify_one();
+  }
+}
+
+bool ppc::util::ThreadPool::TryRunPendingTask() {
+  std::function<void()> task;
+  if (!PopTask(current_pool == this ? current_queue : 0, task)) {
+    return false;
+  }
+  task();
+  return true;
+}
+
+bool ppc::util::ThreadPool::PopTask(size_t own_index, std::function<void()> &task) {
+  if (num_pending_.load(std::memory_order_acquire) == 0) {
+    return false;
+  }
+  // own tasks are taken LIFO for locality
+  if (own_index != 0) {
+    auto &own = *queues_[own_index];
+    std::lock_guard<std::mutex> lock(own.mutex);
+    if (!own.tasks.empty()) {
+      task = std::move(own.tasks.back());
+      own.tasks.pop_back();
+      num_pending_.fetch_sub(1, std::memory_order_acq_rel);
+      return true;
+    }
+  }
+  // shared queue and other workers' queues are taken FIFO
+  for (size_t offset = 0; offset < queues_.size(); offset++) {
+    const size_t index = (own_index + offset) % queues_.size();
+    if (index == own_index && own_index != 0) {
+      continue;
+    }
+    auto &victim = *queues_[index];
+    std::lock_guard<std::mutex> lock(victim.mutex);
+    if (!victim.tasks.empty()) {
+      task = std::move(victim.tasks.front());
+      victim.tasks.pop_front();
+      num_pending_.fetch_sub(1, std::memory_order_acq_rel);
+      return true;
+    }
+  }
+  return false;
+}
+
+void ppc::util::ThreadPool::WorkerLoop(size_t index) {
+  current_pool = this;
+  current_queue = index;
+  PinCurrentThread(static_cast<int>(index), num_threads_, placement_);
+  std::function<void()> task;
+  while (true) {
+    if (PopTask(index, task)) {
+      task();
+      task = nullptr;
+      continue;
+    }
+    std::unique_lock<std::mutex> lock(sleep_mutex_);
+    wake_up_.wait(lock, [this] { return stop_ || num_pending_.load(std::memory_order_acquire) > 0; });
+    if (stop_ && num_pending_.load(std::memory_order_acquire) == 0) {
+      return;
+    }
+  }
+}
+
+ppc::util::TaskGroup::~TaskGroup() { WaitPending(); }
+
+void ppc::util::TaskGroup::WaitPending() {
+  while (num_pending_.load(std::memory_order_acquire) > 0) {
+    if (!pool_.TryRunPendingTask()) {
+      std::this_thread::yield();
+    }
+  }
+}
+
+void ppc::util::TaskGroup::Wait() {
+  WaitPending();
+  std::exception_ptr error;
+  {
+    std::lock_guard<std::mutex> lock(error_mutex_);
+    std::swap(error, error_);
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
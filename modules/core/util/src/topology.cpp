@@ -0,0 +1,288 @@
+#include "core/util/include/topology.hpp"
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include <algorithm>
+#include <cctype>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <set>
+#include <sstream>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "core/util/include/util.hpp"
+
+namespace {
+
+std::string ReadFirstLine(const std::filesystem::path &path) {
+  std::ifstream file(path);
+  std::string line;
+  std::getline(file, line);
+  return line;
+}
+
+int ReadInt(const std::filesystem::path &path, int default_value) {
+  const std::string line = ReadFirstLine(path);
+  if (line.empty()) {
+    return default_value;
+  }
+  return std::stoi(line);
+}
+
+// "0-3,8,10-11" -> {0, 1, 2, 3, 8, 10, 11}
+std::vector<int> ParseCpuList(const std::string &list) {
+  std::vector<int> cpus;
+  std::stringstream stream(list);
+  std::string range;
+  while (std::getline(stream, range, ',')) {
+    if (range.empty()) {
+      continue;
+    }
+    const auto dash = range.find('-');
+    const int first = std::stoi(range.substr(0, dash));
+    const int last = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+    for (int cpu = first; cpu <= last; cpu++) {
+      cpus.push_back(cpu);
+    }
+  }
+  return cpus;
+}
+
+// "48K" -> 49152
+size_t ParseCacheSize(const std::string &size) {
+  if (size.empty()) {
+    return 0;
+  }
+  size_t value = std::stoul(size);
+  switch (size.back()) {
+    case 'K':
+      value <<= 10;
+      break;
+    case 'M':
+      value <<= 20;
+      break;
+    case 'G':
+      value <<= 30;
+      break;
+    default:
+      break;
+  }
+  return value;
+}
+
+std::vector<int> GetAvailableCpus() {
+  std::vector<int> cpus;
+#ifdef __linux__
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  if (sched_getaffinity(0, sizeof(cpu_set), &cpu_set) == 0) {
+    for (int cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+      if (CPU_ISSET(cpu, &cpu_set)) {
+        cpus.push_back(cpu);
+      }
+    }
+  }
+#endif
+  if (cpus.empty()) {
+    const int num_cpus = static_cast<int>(std::max(1U, std::thread::hardware_concurrency()));
+    for (int cpu = 0; cpu < num_cpus; cpu++) {
+      cpus.push_back(cpu);
+    }
+  }
+  return cpus;
+}
+
+void ReadCacheSizes(int cpu, ppc::util::Topology &topology) {
+  const std::filesystem::path cache_dir = "/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/cache";
+  std::error_code error;
+  for (const auto &entry : std::filesystem::directory_iterator(cache_dir, error)) {
+    if (entry.path().filename().string().rfind("index", 0) != 0) {
+      continue;
+    }
+    const int level = ReadInt(entry.path() / "level", 0);
+    const std::string type = ReadFirstLine(entry.path() / "type");
+    const size_t size = ParseCacheSize(ReadFirstLine(entry.path() / "size"));
+    if (level == 1 && type == "Data") {
+      topology.l1d_cache_size = size;
+    } else if (level == 2 && type != "Instruction") {
+      topology.l2_cache_size = size;
+    } else if (level == 3 && type != "Instruction") {
+      topology.l3_cache_size = size;
+    }
+  }
+}
+
+ppc::util::Topology DetectTopology() {
+  ppc::util::Topology topology;
+  const std::filesystem::path cpu_dir = "/sys/devices/system/cpu";
+  std::map<int, int> numa_nodes;
+  std::error_code error;
+  for (const auto &entry : std::filesystem::directory_iterator("/sys/devices/system/node", error)) {
+    const std::string name = entry.path().filename().string();
+    if (name.rfind("node", 0) != 0 || name.size() == 4 || !std::isdigit(static_cast<unsigned char>(name[4]))) {
+      continue;
+    }
+    const int node = std::stoi(name.substr(4));
+    for (int cpu : ParseCpuList(ReadFirstLine(entry.path() / "cpulist"))) {
+      numa_nodes[cpu] = node;
+    }
+  }
+
+  for (int id : GetAvailableCpus()) {
+    const auto topology_dir = cpu_dir / ("cpu" + std::to_string(id)) / "topology";
+    ppc::util::LogicalCpu cpu;
+    cpu.id = id;
+    cpu.core_id = ReadInt(topology_dir / "core_id", id);
+    cpu.package_id = ReadInt(topology_dir / "physical_package_id", 0);
+    cpu.numa_node = numa_nodes.contains(id) ? numa_nodes[id] : 0;
+    topology.cpus.push_back(cpu);
+  }
+
+  std::set<std::pair<int, int>> cores;
+  std::set<int> packages;
+  std::set<int> nodes;
+  for (const auto &cpu : topology.cpus) {
+    cores.emplace(cpu.package_id, cpu.core_id);
+    packages.insert(cpu.package_id);
+    nodes.insert(cpu.numa_node);
+  }
+  topology.num_physical_cores = static_cast<int>(cores.size());
+  topology.num_packages = static_cast<int>(packages.size());
+  topology.num_numa_nodes = static_cast<int>(nodes.size());
+  ReadCacheSizes(topology.cpus.front().id, topology);
+  return topology;
+}
+
+std::vector<ppc::util::LogicalCpu> CompactOrder(std::vector<ppc::util::LogicalCpu> cpus) {
+  std::ranges::sort(cpus, [](const auto &a, const auto &b) {
+    return std::tie(a.numa_node, a.package_id, a.core_id, a.id) < std::tie(b.numa_node, b.package_id, b.core_id, b.id);
+  });
+  return cpus;
+}
+
+std::vector<ppc::util::LogicalCpu> ScatterOrder(const std::vector<ppc::util::LogicalCpu> &cpus) {
+  // SMT siblings of every core, cores of every package
+  std::map<int, std::map<int, std::vector<ppc::util::LogicalCpu>>> packages;
+  for (const auto &cpu : CompactOrder(cpus)) {
+    packages[cpu.package_id][cpu.core_id].push_back(cpu);
+  }
+  std::vector<std::vector<ppc::util::LogicalCpu>> cores_round_robin;
+  for (size_t round = 0; cores_round_robin.size() < cpus.size(); round++) {
+    bool added = false;
+    for (auto &[package_id, cores] : packages) {
+      if (round < cores.size()) {
+        cores_round_robin.push_back(std::next(cores.begin(), static_cast<std::ptrdiff_t>(round))->second);
+        added = true;
+      }
+    }
+    if (!added) {
+      break;
+    }
+  }
+  std::vector<ppc::util::LogicalCpu> order;
+  for (size_t sibling = 0; order.size() < cpus.size(); sibling++) {
+    for (const auto &core : cores_round_robin) {
+      if (sibling < core.size()) {
+        order.push_back(core[sibling]);
+      }
+    }
+  }
+  return order;
+}
+
+int CurrentNumaNode(const ppc::util::Topology &topology) {
+#ifdef __linux__
+  const int current_cpu = sched_getcpu();
+  for (const auto &cpu : topology.cpus) {
+    if (cpu.id == current_cpu) {
+      return cpu.numa_node;
+    }
+  }
+#endif
+  return topology.cpus.front().numa_node;
+}
+
+}  // namespace
+
+const ppc::util::Topology &ppc::util::GetTopology() {
+  static const Topology kTopology = DetectTopology();
+  return kTopology;
+}
+
+ppc::util::Placement ppc::util::ParsePlacement(const std::string &name) {
+  if (name == "compact") {
+    return Placement::kCompact;
+  }
+  if (name == "scatter") {
+    return Placement::kScatter;
+  }
+  if (name == "numa") {
+    return Placement::kNumaLocal;
+  }
+  return Placement::kNone;
+}
+
+ppc::util::Placement ppc::util::GetPPCPlacement() { return ParsePlacement(GetEnvVar("PPC_PLACEMENT")); }
+
+std::vector<int> ppc::util::GetPlacementCpus(int num_threads, Placement placement) {
+  const auto &topology = GetTopology();
+  std::vector<LogicalCpu> order;
+  switch (placement) {
+    case Placement::kNone:
+      return {};
+    case Placement::kCompact:
+      order = CompactOrder(topology.cpus);
+      break;
+    case Placement::kScatter:
+      order = ScatterOrder(topology.cpus);
+      break;
+    case Placement::kNumaLocal: {
+      const int node = CurrentNumaNode(topology);
+      std::vector<LogicalCpu> local;
+      std::ranges::copy_if(topology.cpus, std::back_inserter(local),
+                           [node](const auto &cpu) { return cpu.numa_node == node; });
+      order = CompactOrder(local);
+      break;
+    }
+  }
+  std::vector<int> cpus(std::max(0, num_threads));
+  for (size_t i = 0; i < cpus.size(); i++) {
+    cpus[i] = order[i % order.size()].id;
+  }
+  return cpus;
+}
+
+bool ppc::util::PinCurrentThread(int thread_index, int num_threads, Placement placement) {
+  if (thread_index < 0) {
+    return false;
+  }
+  const auto cpus = GetPlacementCpus(std::max(num_threads, thread_index + 1), placement);
+  if (cpus.empty()) {
+    return false;
+  }
+#ifdef __linux__
+  cpu_set_t cpu_set;
+  CPU_ZERO(&cpu_set);
+  CPU_SET(cpus[thread_index], &cpu_set);
+  return pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set) == 0;
+#else
+  return false;
+#endif
+}
+
+bool ppc::util::PinCurrentThread(int thread_index) {
+  return PinCurrentThread(thread_index, GetPPCNumThreads(), GetPPCPlacement());
+}
+
+bool ppc::util::PinWorkerThread(int thread_index) { return thread_index > 0 && PinCurrentThread(thread_index); }
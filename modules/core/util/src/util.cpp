@@ -9,7 +9,14 @@
 #endif
 
 #include <filesystem>
+#include <functional>
+#include <initializer_list>
+#include <mutex>
 #include <string>
+#include <utility>
+#include <vector>
+
+#include "core/util/include/topology.hpp"
 
 std::string ppc::util::GetAbsolutePath(const std::string &relative_path) {
   const std::filesystem::path path = std::string(PPC_PATH_TO_PROJECT) + "/tasks/" + relative_path;
@@ -17,16 +24,63 @@ std::string ppc::util::GetAbsolutePath(const std::string &relative_path) {
 }
 
 int ppc::util::GetPPCNumThreads() {
+  // PPC_NUM_THREADS overrides OMP_NUM_THREADS, without both use physical cores
+  for (const char *name : {"PPC_NUM_THREADS", "OMP_NUM_THREADS"}) {
+    const std::string env = GetEnvVar(name);
+    const int num_threads = env.empty() ? 0 : std::atoi(env.c_str());
+    if (num_threads > 0) {
+      return num_threads;
+    }
+  }
+  return GetTopology().num_physical_cores;
+}
+
+namespace {
+
+std::mutex &GetObserversMutex() {
+  static std::mutex mutex;
+  return mutex;
+}
+
+std::vector<std::function<void(int)>> &GetNumThreadsObservers() {
+  static std::vector<std::function<void(int)>> observers;
+  return observers;
+}
+
+}  // namespace
+
+void ppc::util::SetPPCNumThreads(int num_threads) {
+#ifdef _WIN32
+  _putenv_s("PPC_NUM_THREADS", num_threads > 0 ? std::to_string(num_threads).c_str() : "");
+#else
+  if (num_threads > 0) {
+    setenv("PPC_NUM_THREADS", std::to_string(num_threads).c_str(), 1);  // NOLINT(misc-include-cleaner)
+  } else {
+    unsetenv("PPC_NUM_THREADS");  // NOLINT(misc-include-cleaner)
+  }
+#endif
+  const int current = GetPPCNumThreads();
+  std::lock_guard<std::mutex> lock(GetObserversMutex());
+  for (const auto &observer : GetNumThreadsObservers()) {
+    observer(current);
+  }
+}
+
+void ppc::util::AddNumThreadsObserver(std::function<void(int)> observer) {
+  std::lock_guard<std::mutex> lock(GetObserversMutex());
+  GetNumThreadsObservers().emplace_back(std::move(observer));
+}
+
+std::string ppc::util::GetEnvVar(const std::string &name) {
 #ifdef _WIN32
   size_t len;
-  char omp_env[100];
-  errno_t err = getenv_s(&len, omp_env, sizeof(omp_env), "OMP_NUM_THREADS");
+  char env[256];
+  errno_t err = getenv_s(&len, env, sizeof(env), name.c_str());
   if (err != 0 || len == 0) {
-    omp_env[0] = '\0';
+    env[0] = '\0';
   }
 #else
-  const char *omp_env = std::getenv("OMP_NUM_THREADS");
+  const char *env = std::getenv(name.c_str());
 #endif
-  int num_threads = (omp_env != nullptr) ? std::atoi(omp_env) : 1;
-  return num_threads;
+  return (env != nullptr) ? std::string(env) : std::string();
 }
@@ -0,0 +1,152 @@
+import argparse
+import csv
+import json
+import math
+import os
+import sys
+
+# Compare two perf result files written with PPC_PERF_OUTPUT (JSON lines or CSV)
+# and report measurements that became significantly slower or faster.
+#
+# Measurements are matched by (backend, task_id, type_of_running, num_elements, num_threads).
+# With per-iteration samples on both sides Welch's t-test decides the significance,
+# without them only the relative change of the time is checked against --threshold.
+
+parser = argparse.ArgumentParser()
+parser.add_argument('baseline', help='Baseline results file (.jsonl or .csv)')
+parser.add_argument('candidate', help='Candidate results file (.jsonl or .csv)')
+parser.add_argument('--alpha', type=float, default=0.01, help='Significance level of the t-test')
+parser.add_argument('--threshold', type=float, default=0.05,
+                    help='Minimal relative change of the mean time to report')
+parser.add_argument('--all', action='store_true', help='Print unchanged measurements as well')
+args = parser.parse_args()
+
+
+def load_results(path):
+    records = []
+    with open(path, newline='') as results_file:
+        if os.path.splitext(path)[1] == '.csv':
+            for row in csv.DictReader(results_file):
+                samples = [float(x) for x in row['samples'].split(';') if x]
+                records.append({
+                    'task_id': row['task_id'],
+                    'backend': row['backend'],
+                    'type_of_running': row['type_of_running'],
+                    'num_elements': int(row['num_elements'] or 0),
+                    'num_threads': int(row['num_threads'] or 0),
+                    'num_runs': int(row['num_runs'] or 0),
+                    'time_sec': float(row['time_sec'] or 0.0),
+                    'samples': samples,
+                })
+        else:
+            for line in results_file:
+                if line.strip():
+                    records.append(json.loads(line))
+
+    # the last record of repeated measurements wins
+    results = {}
+    for record in records:
+        key = (record['backend'], record['task_id'], record['type_of_running'],
+               record['num_elements'], record['num_threads'])
+        results[key] = record
+    return results
+
+
+def log_beta(a, b):
+    return math.lgamma(a) + math.lgamma(b) - math.lgamma(a + b)
+
+
+def incomplete_beta_fraction(a, b, x):
+    # continued fraction of the regularized incomplete beta function (modified Lentz's method)
+    tiny = 1e-300
+    c = 1.0
+    d = 1.0 - (a + b) * x / (a + 1.0)
+    d = 1.0 / (d if abs(d) > tiny else tiny)
+    result = d
+    for m in range(1, 300):
+        for numerator in (m * (b - m) * x / ((a + 2 * m - 1) * (a + 2 * m)),
+                          -(a + m) * (a + b + m) * x / ((a + 2 * m) * (a + 2 * m + 1))):
+            d = 1.0 + numerator * d
+            d = 1.0 / (d if abs(d) > tiny else tiny)
+            c = 1.0 + numerator / c
+            c = c if abs(c) > tiny else tiny
+            result *= c * d
+        if abs(c * d - 1.0) < 1e-12:
+            break
+    return result
+
+
+def regularized_incomplete_beta(a, b, x):
+    if x <= 0.0:
+        return 0.0
+    if x >= 1.0:
+        return 1.0
+    front = math.exp(a * math.log(x) + b * math.log(1.0 - x) - log_beta(a, b))
+    if x < (a + 1.0) / (a + b + 2.0):
+        return front * incomplete_beta_fraction(a, b, x) / a
+    return 1.0 - front * incomplete_beta_fraction(b, a, 1.0 - x) / b
+
+
+def student_two_sided_p_value(t, df):
+    return regularized_incomplete_beta(df / 2.0, 0.5, df / (df + t * t))
+
+
+def mean_and_variance(samples):
+    mean = sum(samples) / len(samples)
+    variance = sum((x - mean) ** 2 for x in samples) / (len(samples) - 1)
+    return mean, variance
+
+
+def welch_t_test(baseline, candidate):
+    mean_a, var_a = mean_and_variance(baseline)
+    mean_b, var_b = mean_and_variance(candidate)
+    se_a = var_a / len(baseline)
+    se_b = var_b / len(candidate)
+    if se_a + se_b == 0.0:
+        return mean_a, mean_b, 1.0 if mean_a == mean_b else 0.0
+    t = (mean_b - mean_a) / math.sqrt(se_a + se_b)
+    df = (se_a + se_b) ** 2 / (se_a ** 2 / (len(baseline) - 1) + se_b ** 2 / (len(candidate) - 1))
+    return mean_a, mean_b, student_two_sided_p_value(t, df)
+
+
+def mean_time(record):
+    if record['samples']:
+        return sum(record['samples']) / len(record['samples'])
+    return record['time_sec'] / max(record['num_runs'], 1)
+
+
+baseline_results = load_results(os.path.abspath(args.baseline))
+candidate_results = load_results(os.path.abspath(args.candidate))
+
+num_regressions = 0
+rows = []
+for key in sorted(set(baseline_results) & set(candidate_results)):
+    baseline_record = baseline_results[key]
+    candidate_record = candidate_results[key]
+    if len(baseline_record['samples']) > 1 and len(candidate_record['samples']) > 1:
+        baseline_time, candidate_time, p_value = welch_t_test(baseline_record['samples'], candidate_record['samples'])
+        significant = p_value < args.alpha
+    else:
+        baseline_time, candidate_time, p_value = mean_time(baseline_record), mean_time(candidate_record), None
+        significant = True
+    change = candidate_time / baseline_time - 1.0 if baseline_time > 0.0 else 0.0
+    status = 'unchanged'
+    if significant and change > args.threshold:
+        status = 'REGRESSION'
+        num_regressions += 1
+    elif significant and change < -args.threshold:
+        status = 'improvement'
+    if status != 'unchanged' or args.all:
+        rows.append((key, baseline_time, candidate_time, change, p_value, status))
+
+for key in sorted(set(baseline_results) ^ set(candidate_results)):
+    side = 'baseline' if key in baseline_results else 'candidate'
+    print(f"Warning! {key[0]}/{key[1]}:{key[2]} (n={key[3]}, threads={key[4]}) is only in {side}")
+
+for key, baseline_time, candidate_time, change, p_value, status in rows:
+    p_value_str = 'n/a' if p_value is None else f"{p_value:.2e}"
+    print(f"{status:>11} {key[0]}/{key[1]}:{key[2]} n={key[3]} threads={key[4]}: "
+          f"{baseline_time:.6e} s -> {candidate_time:.6e} s ({change * 100.0:+.1f}%, p={p_value_str})")
+
+print(f"{num_regressions} regression(s) in {len(set(baseline_results) & set(candidate_results))} measurement(s)")
+sys.exit(1 if num_regressions else 0)
@@ -1,4 +1,6 @@
 @echo off
 mkdir build\perf_stat_dir
+if exist build\perf_stat_dir\perf_results.jsonl del build\perf_stat_dir\perf_results.jsonl
+set PPC_PERF_OUTPUT=%cd%\build\perf_stat_dir\perf_results.jsonl
 python3 scripts/run_tests.py --running-type="performance" > build\perf_stat_dir\perf_log.txt
 python scripts\create_perf_table.py --input build\perf_stat_dir\perf_log.txt --output build\perf_stat_dir
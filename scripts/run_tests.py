@@ -104,6 +104,7 @@ class PPCRunner:
         if os.environ.get("CLANG_BUILD") == "1":
             return
         self.__run_exec(f"{self.work_dir / 'omp_func_tests'} {self.__get_gtest_settings(3)}")
+        self.__run_exec(f"{self.work_dir / 'differential_func_tests'} {self.__get_gtest_settings(1)}")
 
     def run_core(self):
         if platform.system() == "Linux" and not os.environ.get("ASAN_RUN"):
@@ -6,19 +6,21 @@
 #include <thread>
 #include <vector>
 
+#include "core/util/include/gemm.hpp"
 #include "core/util/include/util.hpp"
 #include "oneapi/tbb/task_arena.h"
 #include "oneapi/tbb/task_group.h"
 
 namespace {
+// Integer products through the double Gemm, exact while every partial sum
+// stays within the 53 bit mantissa
 void MatMul(const std::vector<int> &in_vec, int rc_size, std::vector<int> &out_vec) {
-  for (int i = 0; i < rc_size; ++i) {
-    for (int j = 0; j < rc_size; ++j) {
-      out_vec[(i * rc_size) + j] = 0;
-      for (int k = 0; k < rc_size; ++k) {
-        out_vec[(i * rc_size) + j] += in_vec[(i * rc_size) + k] * in_vec[(k * rc_size) + j];
-      }
-    }
+  const auto size = static_cast<size_t>(rc_size);
+  const std::vector<double> in(in_vec.begin(), in_vec.end());
+  std::vector<double> out(size * size);
+  ppc::util::Gemm(size, size, size, 1.0, in.data(), size, in.data(), size, 0.0, out.data(), size);
+  for (size_t i = 0; i < out.size(); i++) {
+    out_vec[i] = static_cast<int>(std::llround(out[i]));
   }
 }
 }  // namespace
@@ -107,4 +107,51 @@ TEST(gromov_a_fox_algorithm, Test_Matrix_Multiplication_Zero) {
   if (world.rank() == 0) {
     EXPECT_EQ(c, expected);
   }
-}
\ No newline at end of file
+}
+
+TEST(gromov_a_fox_algorithm, Test_Matrix_Multiplication_12x12_On_Process_Grid) {
+  // 12 splits into 2 x 2, 3 x 3 and 4 x 4 grids, so every step of the
+  // pipelined Fox is used with 4, 9 and 16 processes
+  boost::mpi::communicator world;
+  constexpr size_t kN = 12;
+  std::vector<double> a(kN * kN);
+  std::vector<double> b(kN * kN);
+  for (size_t i = 0; i < kN * kN; ++i) {
+    a[i] = static_cast<double>((i * 7) % 11) - 5.0;
+    b[i] = static_cast<double>((i * 5) % 13) - 6.0;
+  }
+  std::vector<double> expected(kN * kN, 0.0);
+  for (size_t i = 0; i < kN; ++i) {
+    for (size_t k = 0; k < kN; ++k) {
+      for (size_t j = 0; j < kN; ++j) {
+        expected[(i * kN) + j] += a[(i * kN) + k] * b[(k * kN) + j];
+      }
+    }
+  }
+  std::vector<double> c(kN * kN, 0);
+
+  std::vector<double> input;
+  if (world.rank() == 0) {
+    input.insert(input.end(), a.begin(), a.end());
+    input.insert(input.end(), b.begin(), b.end());
+  }
+
+  auto task_data_all = std::make_shared<ppc::core::TaskData>();
+  if (world.rank() == 0) {
+    task_data_all->inputs.emplace_back(reinterpret_cast<uint8_t *>(input.data()));
+    task_data_all->inputs_count.emplace_back(input.size());
+    task_data_all->outputs.emplace_back(reinterpret_cast<uint8_t *>(c.data()));
+    task_data_all->outputs_count.emplace_back(kN * kN);
+  }
+
+  gromov_a_fox_algorithm_all::TestTaskAll matrix_multiplication(task_data_all);
+
+  ASSERT_EQ(matrix_multiplication.ValidationImpl(), true);
+  matrix_multiplication.PreProcessingImpl();
+  matrix_multiplication.RunImpl();
+  matrix_multiplication.PostProcessingImpl();
+
+  if (world.rank() == 0) {
+    EXPECT_EQ(c, expected);
+  }
+}
@@ -1,6 +1,7 @@
 #include "all/gromov_a_fox_algorithm/include/ops_all.hpp"
 
 #include <mpi.h>
+#include <tbb/blocked_range.h>
 #include <tbb/global_control.h>
 #include <tbb/parallel_for.h>
 #include <tbb/task_arena.h>
@@ -12,16 +13,44 @@
 #include <cmath>
 #include <cstddef>
 #include <cstring>
+#include <functional>
 #include <vector>
 
 #include "boost/mpi/collectives/broadcast.hpp"
 #include "boost/mpi/collectives/gather.hpp"
 #include "boost/mpi/collectives/scatter.hpp"
+#include "core/util/include/gemm.hpp"
+#include "core/util/include/util.hpp"
 #include "oneapi/tbb/parallel_for.h"
 #include "oneapi/tbb/task_arena.h"
 
 namespace gromov_a_fox_algorithm_all {
 
+namespace {
+constexpr int kTagA = 0;
+constexpr int kTagB = 1;
+
+// matrix_c += matrix_a * matrix_b in bands on the threads of the arena; the
+// calling thread runs progress() between its bands
+void MultBlocksWithProgress(const double* matrix_a, const double* matrix_b, double* matrix_c, int block_size,
+                            const std::function<void()>& progress) {
+  const auto size = static_cast<std::size_t>(block_size);
+  ppc::util::GemmProblem problem;
+  problem.m = problem.n = problem.k = size;
+  problem.a = matrix_a;
+  problem.lda = size;
+  problem.b = matrix_b;
+  problem.ldb = size;
+  problem.beta = 1.0;
+  problem.c = matrix_c;
+  problem.ldc = size;
+  const auto parallel_for = [](std::size_t count, const std::function<void(std::size_t)>& body) {
+    tbb::parallel_for(std::size_t{0}, count, body);
+  };
+  ppc::util::GemmBatchedWithProgress({&problem, 1}, parallel_for, progress);
+}
+}  // namespace
+
 bool TestTaskAll::PreProcessingImpl() {
   if (mpiCommunicator_.rank() == 0) {
     auto* input_data_ptr = reinterpret_cast<double*>(task_data->inputs[0]);
@@ -95,7 +124,7 @@ bool TestTaskAll::RunImpl() {
                       0);
   boost::mpi::scatter(local_mpi_comm, scatter_matrix_b, local_matrix_b.data(), static_cast<int>(local_matrix_b.size()),
                       0);
-  tbb::task_arena tbb_task_arena;
+  tbb::task_arena tbb_task_arena(ppc::util::GetPPCNumThreads());
   tbb_task_arena.execute([&] {
     FoxStep(local_mpi_comm, process_rank, grid_size, block_size, local_matrix_a, local_matrix_b, local_matrix_c);
   });
@@ -135,22 +164,7 @@ void ExtractBlock(const std::vector<double>& source_matrix, double* block_buffer
 }
 
 void MultBlocks(const double* matrix_a, const double* matrix_b, double* matrix_c, int block_size) {
-  tbb::parallel_for(
-      tbb::blocked_range<int>(0, block_size),
-      [&](const tbb::blocked_range<int>& block_range) {
-        for (int row_idx = block_range.begin(); row_idx < block_range.end(); ++row_idx) {
-          const double* row_a = matrix_a + (row_idx * block_size);
-          double* row_c = matrix_c + (row_idx * block_size);
-          for (int inner_idx = 0; inner_idx < block_size; ++inner_idx) {
-            double element_a = row_a[inner_idx];
-            const double* row_b = matrix_b + (inner_idx * block_size);
-            for (int col_idx = 0; col_idx < block_size; ++col_idx) {
-              row_c[col_idx] += element_a * row_b[col_idx];
-            }
-          }
-        }
-      },
-      tbb::auto_partitioner());
+  MultBlocksWithProgress(matrix_a, matrix_b, matrix_c, block_size, [] {});
 }
 
 std::vector<double> Scatter(const std::vector<double>& source_matrix, std::size_t matrix_size, int grid_size,
@@ -193,38 +207,58 @@ void FoxStep(boost::mpi::communicator& mpi_comm, int process_rank, int active_pr
     return;
   }
 
-  std::vector<double> temp_matrix_a(block_size * block_size);
-  std::vector<double> temp_matrix_b(block_size * block_size);
-
-  int process_row = process_rank / active_process_count;
-  int process_col = process_rank % active_process_count;
+  const int grid = active_process_count;
+  const int count = block_size * block_size;
+  const int process_row = process_rank / grid;
+  const int process_col = process_rank % grid;
+  const int send_to_process = (((process_row - 1 + grid) % grid) * grid) + process_col;
+  const int recv_from_process = (((process_row + 1) % grid) * grid) + process_col;
 
-  for (int step_idx = 0; step_idx < active_process_count; ++step_idx) {
-    if (process_col == (process_row + step_idx) % active_process_count) {
-      for (int target_col_idx = 0; target_col_idx < active_process_count; ++target_col_idx) {
-        if (target_col_idx == process_col) {
-          continue;
-        }
-        int target_process = (process_row * active_process_count) + target_col_idx;
-        mpi_comm.send(target_process, 0, local_matrix_a.data(), block_size * block_size);
+  // A block of the step: its owner in the row keeps a copy and sends it to
+  // the others
+  auto post_step_a = [&](int step_idx, std::vector<double>& step_a, std::vector<MPI_Request>& pending) {
+    const int owner_col = (process_row + step_idx) % grid;
+    if (process_col != owner_col) {
+      pending.emplace_back();
+      MPI_Irecv(step_a.data(), count, MPI_DOUBLE, (process_row * grid) + owner_col, kTagA, mpi_comm, &pending.back());
+      return;
+    }
+    std::ranges::copy(local_matrix_a, step_a.begin());
+    for (int target_col = 0; target_col < grid; ++target_col) {
+      if (target_col != process_col) {
+        pending.emplace_back();
+        MPI_Isend(local_matrix_a.data(), count, MPI_DOUBLE, (process_row * grid) + target_col, kTagA, mpi_comm,
+                  &pending.back());
       }
-      temp_matrix_a = local_matrix_a;
-    } else {
-      int sender_process = (process_row * active_process_count) + ((process_row + step_idx) % active_process_count);
-      mpi_comm.recv(sender_process, 0, temp_matrix_a.data(), block_size * block_size);
     }
-    mpi_comm.barrier();
-    MultBlocks(temp_matrix_a.data(), local_matrix_b.data(), local_matrix_c.data(), block_size);
-    int send_to_process =
-        (((process_row - 1 + active_process_count) % active_process_count) * active_process_count) + process_col;
-    int recv_from_process = (((process_row + 1) % active_process_count) * active_process_count) + process_col;
-
-    mpi_comm.send(send_to_process, 0, local_matrix_b.data(), block_size * block_size);
-    mpi_comm.recv(recv_from_process, 0, temp_matrix_b.data(), block_size * block_size);
+  };
 
-    mpi_comm.barrier();
+  // the A block of the next step and the shifted B block arrive in the
+  // second buffers while the current ones are multiplied
+  std::vector<double> step_a(count);
+  std::vector<double> next_a(count);
+  std::vector<double> next_b(count);
+  std::vector<MPI_Request> pending;
+  post_step_a(0, step_a, pending);
+  MPI_Waitall(static_cast<int>(pending.size()), pending.data(), MPI_STATUSES_IGNORE);
 
-    local_matrix_b.swap(temp_matrix_b);
+  for (int step_idx = 0; step_idx < grid; ++step_idx) {
+    pending.clear();
+    if (step_idx + 1 < grid) {
+      post_step_a(step_idx + 1, next_a, pending);
+      pending.emplace_back();
+      MPI_Irecv(next_b.data(), count, MPI_DOUBLE, recv_from_process, kTagB, mpi_comm, &pending.back());
+      pending.emplace_back();
+      MPI_Isend(local_matrix_b.data(), count, MPI_DOUBLE, send_to_process, kTagB, mpi_comm, &pending.back());
+    }
+    // MPI is polled between the bands of the product, so the transfers progress
+    MultBlocksWithProgress(step_a.data(), local_matrix_b.data(), local_matrix_c.data(), block_size, [&pending] {
+      int done = 0;
+      MPI_Testall(static_cast<int>(pending.size()), pending.data(), &done, MPI_STATUSES_IGNORE);
+    });
+    MPI_Waitall(static_cast<int>(pending.size()), pending.data(), MPI_STATUSES_IGNORE);
+    step_a.swap(next_a);
+    local_matrix_b.swap(next_b);
   }
 }
 
@@ -196,3 +196,35 @@ TEST(odintsov_m_mulmatrix_cannon_all, test_block_sz_1) {
     }
   }
 }
+
+TEST(odintsov_m_mulmatrix_cannon_all, test_matrix_144_on_process_grid) {
+  // 12 splits into 2 x 2, 3 x 3 and 4 x 4 process grids with 4, 9 and 16 processes
+  boost::mpi::communicator com;
+  std::vector<double> matrix_a = odintsov_m_mulmatrix_cannon_all::GenerateMatrix(12);
+  std::vector<double> matrix_b = odintsov_m_mulmatrix_cannon_all::GenerateMatrix(12);
+  std::vector<double> out_all(144, 0);
+  std::vector<double> out_ans = odintsov_m_mulmatrix_cannon_all::MultiplyMatrices(matrix_a, matrix_b, 12);
+
+  auto task_data_all = std::make_shared<ppc::core::TaskData>();
+  if (com.rank() == 0) {
+    task_data_all->inputs.emplace_back(reinterpret_cast<uint8_t *>(matrix_a.data()));
+    task_data_all->inputs.emplace_back(reinterpret_cast<uint8_t *>(matrix_b.data()));
+    task_data_all->inputs_count.emplace_back(matrix_a.size());
+    task_data_all->inputs_count.emplace_back(matrix_b.size());
+    task_data_all->outputs.emplace_back(reinterpret_cast<uint8_t *>(out_all.data()));
+  }
+
+  odintsov_m_mulmatrix_cannon_all::MulMatrixCannonALL test_task_all(task_data_all);
+
+  ASSERT_EQ(test_task_all.Validation(), true);
+
+  test_task_all.PreProcessing();
+  test_task_all.Run();
+  test_task_all.PostProcessing();
+  if (com.rank() == 0) {
+    ASSERT_EQ(out_ans.size(), out_all.size());
+    for (size_t i = 0; i < out_ans.size(); ++i) {
+      EXPECT_NEAR(out_ans[i], out_all[i], 0.00001);
+    }
+  }
+}
@@ -18,18 +18,10 @@ class MulMatrixCannonALL : public ppc::core::Task {
   bool PostProcessingImpl() override;
 
  private:
-  static void ShiftRow(std::vector<double>& matrix, int root, int row, int shift);
-  static void ShiftColumn(std::vector<double>& matrix, int root, int col, int shift);
-  void ShiftBlocksUp(std::vector<double>& matrix, int root, int block_sz) const;
-  void ShiftBlocksLeft(std::vector<double>& matrix, int root, int block_sz) const;
   static bool IsSquere(unsigned int num);
-  static int GetBlockSize(int n);
-  static void InitializeShift(std::vector<double>& matrix, int root, int grid_size, int block_sz, bool is_row_shift);
-  static void ProcessBlockMul(int bi, int bj_start, int bj_end, int root, int block_sz,
-                              const std::vector<double>& matrix_a, const std::vector<double>& matrix_b,
-                              std::vector<double>& local_c);
-  static void ProcessBlockSTL(int bi, int num_blocks, int root, int block_sz, const std::vector<double>& matrix_a,
-                              const std::vector<double>& matrix_b, std::vector<double>& local_c);
+  static int GetGridSize(int num_procs, int root);
+  void CannonSteps(const boost::mpi::communicator& comm, int grid, std::vector<double>& local_a,
+                   std::vector<double>& local_b, std::vector<double>& local_c) const;
 
   std::vector<double> matrixA_, matrixB_;
   unsigned int szA_ = 0, szB_ = 0;
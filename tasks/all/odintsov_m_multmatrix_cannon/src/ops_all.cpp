@@ -1,183 +1,51 @@
 #include "all/odintsov_m_multmatrix_cannon/include/ops_all.hpp"
 
+#include <mpi.h>
+
 #include <algorithm>
-#include <boost/mpi/collectives.hpp>
-#include <boost/mpi/collectives/broadcast.hpp>  // для boost::mpi::broadcast
-#include <boost/mpi/collectives/reduce.hpp>
+#include <boost/mpi/collectives/broadcast.hpp>
+#include <boost/mpi/collectives/gather.hpp>
+#include <boost/mpi/collectives/scatter.hpp>
 #include <boost/mpi/communicator.hpp>
 #include <cmath>
-#include <core/util/include/util.hpp>
 #include <cstddef>
 #include <functional>
-#include <thread>
+#include <utility>
 #include <vector>
 
-using namespace std;
-void odintsov_m_mulmatrix_cannon_all::MulMatrixCannonALL::ShiftRow(std::vector<double>& matrix, int root, int row,
-                                                                   int shift) {
-  shift = shift % root;
-  std::vector<double> tmp(root);
-  for (int j = 0; j < root; j++) {
-    tmp[j] = matrix[(row * root) + ((j + shift) % root)];
-  }
-  for (int j = 0; j < root; j++) {
-    matrix[(row * root) + j] = tmp[j];
-  }
-}
-
-void odintsov_m_mulmatrix_cannon_all::MulMatrixCannonALL::ShiftColumn(std::vector<double>& matrix, int root, int col,
-                                                                      int shift) {
-  shift = shift % root;
-  std::vector<double> tmp(root);
-
-  for (int i = 0; i < root; i++) {
-    tmp[i] = matrix[(((i + shift) % root) * root) + col];
-  }
-  for (int i = 0; i < root; i++) {
-    matrix[(i * root) + col] = tmp[i];
-  }
-}
-void odintsov_m_mulmatrix_cannon_all::MulMatrixCannonALL::ShiftBlocksUp(std::vector<double>& matrix, int root,
-                                                                        int sz) const {
-  int p = root / block_sz_;
-  for (int bj = 0; bj < p; bj++) {
-    std::vector<double> first_block(block_sz_ * block_sz_);
-
-    for (int i = 0; i < block_sz_; i++) {
-      for (int j = 0; j < block_sz_; j++) {
-        first_block[(i * block_sz_) + j] = matrix[(i * root) + ((bj * block_sz_) + j)];
-      }
-    }
+#include "core/util/include/gemm.hpp"
+#include "core/util/include/thread_pool.hpp"
 
-    for (int bi = 0; bi < (p - 1); bi++) {
-      for (int i = 0; i < block_sz_; i++) {
-        for (int j = 0; j < block_sz_; j++) {
-          matrix[((bi * block_sz_ + i) * root) + (bj * block_sz_) + j] =
-              matrix[(((bi + 1) * block_sz_) * root) + (i * root) + ((bj * block_sz_) + j)];
-        }
-      }
-    }
+namespace {
+constexpr int kTagA = 0;
+constexpr int kTagB = 1;
 
-    for (int i = 0; i < block_sz_; i++) {
-      for (int j = 0; j < block_sz_; j++) {
-        matrix[((((p - 1) * block_sz_) * root) + (i * root) + ((bj * block_sz_) + j))] =
-            first_block[(i * block_sz_) + j];
-      }
-    }
-  }
-}
-
-void odintsov_m_mulmatrix_cannon_all::MulMatrixCannonALL::ShiftBlocksLeft(std::vector<double>& matrix, int root,
-                                                                          int sz) const {
-  int p = root / block_sz_;
-  for (int bi = 0; bi < p; bi++) {
-    std::vector<double> first_block(block_sz_ * block_sz_);
-
-    for (int i = 0; i < block_sz_; i++) {
-      for (int j = 0; j < block_sz_; j++) {
-        first_block[(i * block_sz_) + j] = matrix[((bi * block_sz_ + i) * root) + j];
-      }
-    }
-
-    for (int bj = 0; bj < (p - 1); bj++) {
-      for (int i = 0; i < block_sz_; i++) {
-        for (int j = 0; j < block_sz_; j++) {
-          matrix[((bi * block_sz_ + i) * root) + (bj * block_sz_) + j] =
-              matrix[((bi * block_sz_ + i) * root) + (((bj + 1) * block_sz_) + j)];
-        }
-      }
-    }
-
-    for (int i = 0; i < block_sz_; i++) {
-      for (int j = 0; j < block_sz_; j++) {
-        matrix[((bi * block_sz_ + i) * root) + (((p - 1) * block_sz_) + j)] = first_block[(i * block_sz_) + j];
-      }
+// Block (block_row, block_col) of a root x root matrix to a contiguous
+// buffer (to_block) or back
+void CopyBlock(double* matrix, double* block, int root, int block_sz, int block_row, int block_col, bool to_block) {
+  for (int i = 0; i < block_sz; i++) {
+    double* row = matrix + ((((block_row * block_sz) + i) * root) + (block_col * block_sz));
+    double* block_row_ptr = block + (i * block_sz);
+    if (to_block) {
+      std::copy(row, row + block_sz, block_row_ptr);
+    } else {
+      std::copy(block_row_ptr, block_row_ptr + block_sz, row);
     }
   }
 }
+}  // namespace
 
 bool odintsov_m_mulmatrix_cannon_all::MulMatrixCannonALL::IsSquere(unsigned int num) {
   auto root = static_cast<unsigned int>(std::sqrt(num));
   return (root * root) == num;
 }
 
-int odintsov_m_mulmatrix_cannon_all::MulMatrixCannonALL::GetBlockSize(int n) {
-  for (int k = (n / 2); k >= 2; k--) {
-    if ((n % k) == 0) {
-      return k;
-    }
-  }
-  return 1;
-}
-
-void odintsov_m_mulmatrix_cannon_all::MulMatrixCannonALL::InitializeShift(std::vector<double>& matrix, int root,
-                                                                          int grid_size, int block_sz,
-                                                                          bool is_row_shift) {
-  for (int b = 0; b < grid_size; ++b) {
-    for (int index = b * block_sz; index < (b + 1) * block_sz; ++index) {
-      for (int shift = 0; shift < b; ++shift) {
-        if (is_row_shift) {
-          ShiftRow(matrix, root, index, block_sz);
-        } else {
-          ShiftColumn(matrix, root, index, block_sz);
-        }
-      }
-    }
-  }
-}
-
-void odintsov_m_mulmatrix_cannon_all::MulMatrixCannonALL::ProcessBlockMul(int bi, int bj_start, int bj_end, int root,
-                                                                          int block_sz,
-                                                                          const std::vector<double>& matrix_a,
-                                                                          const std::vector<double>& matrix_b,
-                                                                          std::vector<double>& local_c) {
-  std::vector<double> a_block(block_sz * block_sz);
-  std::vector<double> b_block(block_sz * block_sz);
-
-  for (int bj = bj_start; bj < bj_end; ++bj) {
-    // Копирование подблока
-    for (int i = 0; i < block_sz; ++i) {
-      for (int j = 0; j < block_sz; ++j) {
-        int row = (bi * block_sz) + i;
-        int col = (bj * block_sz) + j;
-        a_block[(i * block_sz) + j] = matrix_a[(row * root) + col];
-        b_block[(i * block_sz) + j] = matrix_b[(row * root) + col];
-      }
-    }
-
-    // Перемножение и накопление
-    for (int i = 0; i < block_sz; ++i) {
-      for (int k = 0; k < block_sz; ++k) {
-        double a_ik = a_block[(i * block_sz) + k];
-        int base = (((bi * block_sz) + i) * root) + (bj * block_sz);
-        for (int j = 0; j < block_sz; ++j) {
-          local_c[base + j] += a_ik * b_block[(k * block_sz) + j];
-        }
-      }
-    }
-  }
-}
-
-void odintsov_m_mulmatrix_cannon_all::MulMatrixCannonALL::ProcessBlockSTL(int bi, int num_blocks, int root,
-                                                                          int block_sz,
-                                                                          const std::vector<double>& matrix_a,
-                                                                          const std::vector<double>& matrix_b,
-                                                                          std::vector<double>& local_c) {
-  int max_threads = ppc::util::GetPPCNumThreads();
-  int tcount = std::min(max_threads, num_blocks);
-  std::vector<thread> threads;
-  threads.reserve(tcount);
-
-  for (int t = 0; t < tcount; ++t) {
-    int bj_start = (num_blocks * t) / tcount;
-    int bj_end = (num_blocks * (t + 1)) / tcount;
-    threads.emplace_back(&MulMatrixCannonALL::ProcessBlockMul, bi, bj_start, bj_end, root, block_sz,
-                         std::cref(matrix_a), std::cref(matrix_b), std::ref(local_c));
-  }
-
-  for (auto& th : threads) {
-    th.join();
+int odintsov_m_mulmatrix_cannon_all::MulMatrixCannonALL::GetGridSize(int num_procs, int root) {
+  int grid = static_cast<int>(std::sqrt(num_procs));
+  while (grid > 1 && root % grid != 0) {
+    grid--;
   }
+  return std::max(grid, 1);
 }
 
 bool odintsov_m_mulmatrix_cannon_all::MulMatrixCannonALL::PreProcessingImpl() {
@@ -189,8 +57,6 @@ bool odintsov_m_mulmatrix_cannon_all::MulMatrixCannonALL::PreProcessingImpl() {
     matrixB_.assign(reinterpret_cast<double*>(task_data->inputs[1]),
                     reinterpret_cast<double*>(task_data->inputs[1]) + szB_);
     matrixC_.assign(szA_, 0);
-
-    block_sz_ = GetBlockSize(static_cast<int>(sqrt(szA_)));
   }
   return true;
 }
@@ -208,71 +74,106 @@ bool odintsov_m_mulmatrix_cannon_all::MulMatrixCannonALL::ValidationImpl() {
   return true;
 }
 
-bool odintsov_m_mulmatrix_cannon_all::MulMatrixCannonALL::RunImpl() {
-  int rank = com_.rank();
-  int size = com_.size();
-
-  // Считываем параметры на всех рангах
-  boost::mpi::broadcast(com_, szA_, /*root=*/0);
-  boost::mpi::broadcast(com_, block_sz_, /*root=*/0);
-
-  int count = static_cast<int>(szA_);
-  if (rank != 0) {
-    matrixA_.resize(count);
-    matrixB_.resize(count);
-    matrixC_.resize(count);
+void odintsov_m_mulmatrix_cannon_all::MulMatrixCannonALL::CannonSteps(const boost::mpi::communicator& comm, int grid,
+                                                                      std::vector<double>& local_a,
+                                                                      std::vector<double>& local_b,
+                                                                      std::vector<double>& local_c) const {
+  const int row = comm.rank() / grid;
+  const int col = comm.rank() % grid;
+  // A moves one block left, B one block up per step
+  const int send_a = (row * grid) + ((col + grid - 1) % grid);
+  const int recv_a = (row * grid) + ((col + 1) % grid);
+  const int send_b = (((row + grid - 1) % grid) * grid) + col;
+  const int recv_b = (((row + 1) % grid) * grid) + col;
+  const int count = block_sz_ * block_sz_;
+
+  ppc::util::GemmProblem problem;
+  problem.m = problem.n = problem.k = static_cast<size_t>(block_sz_);
+  problem.lda = problem.ldb = problem.ldc = problem.m;
+  problem.beta = 1.0;
+  problem.c = local_c.data();
+  const auto parallel_for = [](size_t n, const std::function<void(size_t)>& body) {
+    ppc::util::ParallelFor(0, n, body);
+  };
+
+  // the blocks of the next step arrive in next_a and next_b while the
+  // current ones are multiplied and sent
+  std::vector<double> next_a(count);
+  std::vector<double> next_b(count);
+  std::vector<MPI_Request> pending;
+  for (int step = 0; step < grid; step++) {
+    pending.clear();
+    if (step + 1 < grid) {
+      pending.resize(4);
+      MPI_Irecv(next_a.data(), count, MPI_DOUBLE, recv_a, kTagA, comm, pending.data());
+      MPI_Irecv(next_b.data(), count, MPI_DOUBLE, recv_b, kTagB, comm, &pending[1]);
+      MPI_Isend(local_a.data(), count, MPI_DOUBLE, send_a, kTagA, comm, &pending[2]);
+      MPI_Isend(local_b.data(), count, MPI_DOUBLE, send_b, kTagB, comm, &pending[3]);
+    }
+    // MPI is polled between the bands of the product, so the shifts progress
+    problem.a = local_a.data();
+    problem.b = local_b.data();
+    ppc::util::GemmBatchedWithProgress({&problem, 1}, parallel_for, [&pending] {
+      int done = 0;
+      MPI_Testall(static_cast<int>(pending.size()), pending.data(), &done, MPI_STATUSES_IGNORE);
+    });
+    MPI_Waitall(static_cast<int>(pending.size()), pending.data(), MPI_STATUSES_IGNORE);
+    std::swap(local_a, next_a);
+    std::swap(local_b, next_b);
   }
-  // Вычисляем размер матрицы (root × root) и параметры блоков
-  int root = static_cast<int>(std::round(std::sqrt(szA_)));
-  int num_blocks = std::max(1, root / block_sz_);
-  int steps = num_blocks;
-
-  // 1) Начальная инициализация сдвигов на rank 0
-  if (rank == 0) {
-    InitializeShift(matrixA_, root, steps, block_sz_, /*is_row_shift=*/true);
-    InitializeShift(matrixB_, root, steps, block_sz_, /*is_row_shift=*/false);
-  }
-
-  // 2) Рассылка первоначально сдвинутых A и B всем процессам
-  boost::mpi::broadcast(com_, matrixA_.data(), count, /*root=*/0);
-  boost::mpi::broadcast(com_, matrixB_.data(), count, /*root=*/0);
-
-  // 3) Локальный накопитель результата за все шаги
-  std::vector<double> local_c_acc(root * root, 0.0);
-
-  for (int step = 0; step < steps; ++step) {
-    // 3.1) Локальный вектор для этого шага
-    std::vector<double> local_c(root * root, 0.0);
-
-    // 3.2) Каждый процесс обрабатывает блоки bi = rank, rank+size, …
-    for (int bi = rank; bi < num_blocks; bi += size) {
-      ProcessBlockSTL(bi, num_blocks, root, block_sz_, matrixA_, matrixB_, local_c);
-    }
+}
 
-    // 3.3) Аккумулируем во внешний local_c_acc
-    for (int i = 0; i < root * root; ++i) {
-      local_c_acc[i] += local_c[i];
+bool odintsov_m_mulmatrix_cannon_all::MulMatrixCannonALL::RunImpl() {
+  boost::mpi::broadcast(com_, szA_, 0);
+  const int root = static_cast<int>(std::round(std::sqrt(szA_)));
+
+  // q x q process grid, every process owns one block; the others idle
+  const int grid = GetGridSize(com_.size(), root);
+  const int active = grid * grid;
+  block_sz_ = root / grid;
+  boost::mpi::communicator comm = com_.split(com_.rank() < active ? 0 : MPI_UNDEFINED);
+  if (com_.rank() >= active) {
+    return true;
+  }
+  const int count = block_sz_ * block_sz_;
+
+  // the initial skew is applied while scattering: process (i, j) starts
+  // with A (i, i + j) and B (i + j, j)
+  std::vector<double> scatter_a;
+  std::vector<double> scatter_b;
+  if (comm.rank() == 0) {
+    scatter_a.resize(static_cast<size_t>(active) * count);
+    scatter_b.resize(static_cast<size_t>(active) * count);
+    for (int bi = 0; bi < grid; bi++) {
+      for (int bj = 0; bj < grid; bj++) {
+        const int skew = (bi + bj) % grid;
+        const int offset = ((bi * grid) + bj) * count;
+        CopyBlock(matrixA_.data(), scatter_a.data() + offset, root, block_sz_, bi, skew, true);
+        CopyBlock(matrixB_.data(), scatter_b.data() + offset, root, block_sz_, skew, bj, true);
+      }
     }
+  }
+  std::vector<double> local_a(count);
+  std::vector<double> local_b(count);
+  std::vector<double> local_c(count, 0.0);
+  boost::mpi::scatter(comm, scatter_a.data(), local_a.data(), count, 0);
+  boost::mpi::scatter(comm, scatter_b.data(), local_b.data(), count, 0);
 
-    // 3.4) Сдвиги перед следующим шагом — только на rank 0
-    if (rank == 0) {
-      ShiftBlocksLeft(matrixA_, root, block_sz_);
-      ShiftBlocksUp(matrixB_, root, block_sz_);
-    }
+  CannonSteps(comm, grid, local_a, local_b, local_c);
 
-    // 3.5) Рассылка обновлённых A и B
-    boost::mpi::broadcast(com_, matrixA_.data(), count, /*root=*/0);
-    boost::mpi::broadcast(com_, matrixB_.data(), count, /*root=*/0);
+  std::vector<double> gathered;
+  if (comm.rank() == 0) {
+    gathered.resize(static_cast<size_t>(active) * count);
   }
-
-  // 4) Подготавливаем matrixC_ только на rank 0
-  if (rank == 0) {
-    matrixC_.assign(root * root, 0.0);
+  boost::mpi::gather(comm, local_c.data(), count, gathered.data(), 0);
+  if (comm.rank() == 0) {
+    matrixC_.assign(static_cast<size_t>(root) * root, 0.0);
+    for (int bi = 0; bi < grid; bi++) {
+      for (int bj = 0; bj < grid; bj++) {
+        CopyBlock(matrixC_.data(), gathered.data() + (((bi * grid) + bj) * count), root, block_sz_, bi, bj, false);
+      }
+    }
   }
-
-  // 5) Сводим накопленные данные в matrixC_ на rank 0
-  boost::mpi::reduce(com_, local_c_acc.data(), root * root, matrixC_.data(), std::plus<>(), 0);
-
   return true;
 }
 
@@ -1,4 +1,5 @@
 #include <gtest/gtest.h>
+#include <omp.h>
 #include <tbb/global_control.h>
 
 #include <boost/mpi/communicator.hpp>
@@ -9,6 +10,8 @@
 #include <string>
 #include <utility>
 
+#include "core/util/include/topology.hpp"
+#include "core/util/include/topology_tbb.hpp"
 #include "core/util/include/util.hpp"
 #include "oneapi/tbb/global_control.h"
 
@@ -64,8 +67,20 @@ int main(int argc, char** argv) {
   boost::mpi::environment env(argc, argv);
   boost::mpi::communicator world;
 
-  // Limit the number of threads in TBB
-  tbb::global_control control(tbb::global_control::max_allowed_parallelism, ppc::util::GetPPCNumThreads());
+  // Limit the number of threads in TBB, scaling sweeps change the limit through SetPPCNumThreads()
+  auto control = std::make_unique<tbb::global_control>(tbb::global_control::max_allowed_parallelism,
+                                                       ppc::util::GetPPCNumThreads());
+  ppc::util::AddNumThreadsObserver([&control](int num_threads) {
+    control.reset();
+    control = std::make_unique<tbb::global_control>(tbb::global_control::max_allowed_parallelism, num_threads);
+  });
+  ppc::util::PinningObserver observer;
+
+  // Use the same thread count and placement in OpenMP
+  omp_set_num_threads(ppc::util::GetPPCNumThreads());
+  ppc::util::AddNumThreadsObserver([](int num_threads) { omp_set_num_threads(num_threads); });
+#pragma omp parallel
+  ppc::util::PinWorkerThread(omp_get_thread_num());
 
   ::testing::InitGoogleTest(&argc, argv);
 
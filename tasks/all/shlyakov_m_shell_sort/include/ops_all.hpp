@@ -1,6 +1,7 @@
 #pragma once
 
 #include <boost/mpi/communicator.hpp>
+#include <span>
 #include <utility>
 #include <vector>
 
@@ -8,7 +9,7 @@
 
 namespace shlyakov_m_shell_sort_all {
 
-void ShellSort(int left, int right, std::vector<int>& arr);
+void ShellSort(std::span<int> arr);
 void Merge(int left, int mid, int right, std::vector<int>& arr, std::vector<int>& buffer);
 
 class TestTaskALL : public ppc::core::Task {
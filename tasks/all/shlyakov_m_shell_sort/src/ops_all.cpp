@@ -8,8 +8,10 @@
 #include <boost/mpi/collectives/gather.hpp>
 #include <boost/mpi/collectives/scatter.hpp>
 #include <boost/serialization/vector.hpp>  // NOLINT(misc-include-cleaner)
+#include <core/util/include/natural_merge.hpp>
 #include <core/util/include/util.hpp>
 #include <cstddef>
+#include <span>
 #include <vector>
 
 namespace shlyakov_m_shell_sort_all {
@@ -70,7 +72,11 @@ bool TestTaskALL::RunImpl() {
       for (int t = 0; t < threads; ++t) {
         int l = t * seg_size;
         int r = std::min(n - 1, ((t + 1) * seg_size) - 1);
-        tg.run([l, r, &local_data]() { ShellSort(l, r, local_data); });
+        if (l < r) {
+          tg.run([l, r, &local_data]() {
+            ppc::util::AdaptiveSort(std::span<int>(local_data).subspan(l, r - l + 1), ShellSort);
+          });
+        }
       }
       tg.wait();
 
@@ -113,17 +119,17 @@ bool TestTaskALL::PostProcessingImpl() {
   return true;
 }
 
-void ShellSort(int left, int right, std::vector<int>& arr) {
+void ShellSort(std::span<int> arr) {
   int gap = 1;
-  int len = right - left + 1;
+  const int len = static_cast<int>(arr.size());
   while (gap <= len / 3) {
     gap = gap * 3 + 1;
   }
   for (; gap > 0; gap /= 3) {
-    for (int i = left + gap; i <= right; ++i) {
+    for (int i = gap; i < len; ++i) {
       int tmp = arr[i];
       int j = i;
-      while (j >= left + gap && arr[j - gap] > tmp) {
+      while (j >= gap && arr[j - gap] > tmp) {
         arr[j] = arr[j - gap];
         j -= gap;
       }
@@ -133,6 +139,15 @@ void ShellSort(int left, int right, std::vector<int>& arr) {
 }
 
 void Merge(int left, int mid, int right, std::vector<int>& arr, std::vector<int>& buffer) {
+  // blocks of partially ordered input are often in order already, otherwise
+  // only their overlapping ends need merging
+  if (mid >= right || arr[mid] <= arr[mid + 1]) {
+    return;
+  }
+  const auto first = arr.begin();
+  left = static_cast<int>(std::upper_bound(first + left, first + mid + 1, arr[mid + 1]) - first);
+  right = static_cast<int>(std::lower_bound(first + mid + 1, first + right + 1, arr[mid]) - first) - 1;
+
   int total = right - left + 1;
   buffer.clear();
   buffer.reserve(total);
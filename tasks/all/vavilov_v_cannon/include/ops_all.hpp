@@ -1,5 +1,7 @@
 #pragma once
 
+#include <mpi.h>
+
 #include <boost/mpi/collectives.hpp>
 #include <boost/mpi/communicator.hpp>
 #include <cmath>
@@ -28,10 +30,10 @@ class CannonALL : public ppc::core::Task {
   std::vector<double> C_;
   boost::mpi::communicator world_;
 
-  void InitialShift(std::vector<double>& local_a, std::vector<double>& local_b);
-  void BlockMultiply(const std::vector<double>& local_a, const std::vector<double>& local_b,
-                     std::vector<double>& local_c);
-  void ShiftBlocks(std::vector<double>& local_a, std::vector<double>& local_b);
+  void MultiplyAdd(const std::vector<double>& local_a, const std::vector<double>& local_b,
+                   std::vector<double>& local_c, std::vector<MPI_Request>& pending) const;
+  void CannonSteps(const boost::mpi::communicator& comm, std::vector<double>& local_a, std::vector<double>& local_b,
+                   std::vector<double>& local_c) const;
   static int FindOptimalGridSize(int size, int n);
   static void TakeBlock(const std::vector<double>& matrix, double* block, int n, int k, int block_row, int block_col);
   void GatherResults(std::vector<double>& tmp_c, int block_size_sq);
@@ -1,6 +1,8 @@
 #include "all/vavilov_v_cannon/include/ops_all.hpp"
 
 #include <mpi.h>
+#include <oneapi/tbb/parallel_for.h>
+#include <oneapi/tbb/task_arena.h>
 
 #include <algorithm>
 #include <boost/mpi/collectives/broadcast.hpp>
@@ -9,10 +11,21 @@
 #include <boost/mpi/communicator.hpp>
 #include <boost/mpi/request.hpp>
 #include <cmath>
+#include <cstddef>
+#include <functional>
+#include <utility>
 #include <vector>
 
+#include "core/util/include/gemm.hpp"
+#include "core/util/include/util.hpp"
+
 namespace mpi = boost::mpi;
 
+namespace {
+constexpr int kTagA = 2;
+constexpr int kTagB = 3;
+}  // namespace
+
 int vavilov_v_cannon_all::CannonALL::FindOptimalGridSize(int size, int n) {
   int grid = std::floor(std::sqrt(size));
   while (grid > 0) {
@@ -58,68 +71,63 @@ bool vavilov_v_cannon_all::CannonALL::ValidationImpl() {
   return true;
 }
 
-void vavilov_v_cannon_all::CannonALL::InitialShift(std::vector<double>& local_a, std::vector<double>& local_b) {
-  int rank = world_.rank();
-  int grid_size = num_blocks_;
-  int row = rank / grid_size;
-  int col = rank % grid_size;
-
-  int send_rank_a = (row * grid_size) + ((col + grid_size - 1) % grid_size);
-  int recv_rank_a = (row * grid_size) + ((col + 1) % grid_size);
-
-  int send_rank_b = col + (grid_size * ((row + grid_size - 1) % grid_size));
-  int recv_rank_b = col + (grid_size * ((row + 1) % grid_size));
-
-  std::vector<double> tmp_a(block_size_ * block_size_);
-  std::vector<double> tmp_b(block_size_ * block_size_);
-  for (int i = 0; i < row; ++i) {
-    world_.send(send_rank_a, 0, local_a.data(), block_size_ * block_size_);
-    world_.recv(recv_rank_a, 0, tmp_a.data(), block_size_ * block_size_);
-    std::swap(local_a, tmp_a);
-  }
-
-  for (int i = 0; i < col; ++i) {
-    world_.send(send_rank_b, 1, local_b.data(), block_size_ * block_size_);
-    world_.recv(recv_rank_b, 1, tmp_b.data(), block_size_ * block_size_);
-    std::swap(local_b, tmp_b);
-  }
-}
-
-void vavilov_v_cannon_all::CannonALL::ShiftBlocks(std::vector<double>& local_a, std::vector<double>& local_b) {
-  int rank = world_.rank();
-  int grid_size = num_blocks_;
-  int row = rank / grid_size;
-  int col = rank % grid_size;
-
-  int send_rank_a = (row * grid_size) + ((col + grid_size - 1) % grid_size);
-  int recv_rank_a = (row * grid_size) + ((col + 1) % grid_size);
-
-  int send_rank_b = col + (grid_size * ((row + grid_size - 1) % grid_size));
-  int recv_rank_b = col + (grid_size * ((row + 1) % grid_size));
-
-  std::vector<double> tmp_a(block_size_ * block_size_);
-  std::vector<double> tmp_b(block_size_ * block_size_);
-
-  world_.send(send_rank_a, 2, local_a.data(), block_size_ * block_size_);
-  world_.recv(recv_rank_a, 2, tmp_a.data(), block_size_ * block_size_);
-  std::swap(local_a, tmp_a);
-
-  world_.send(send_rank_b, 3, local_b.data(), block_size_ * block_size_);
-  world_.recv(recv_rank_b, 3, tmp_b.data(), block_size_ * block_size_);
-  std::swap(local_b, tmp_b);
+void vavilov_v_cannon_all::CannonALL::MultiplyAdd(const std::vector<double>& local_a,
+                                                  const std::vector<double>& local_b, std::vector<double>& local_c,
+                                                  std::vector<MPI_Request>& pending) const {
+  // one banded product on the threads of the rank; the calling thread polls
+  // MPI between its bands, so the shifts in flight progress meanwhile
+  const auto k = static_cast<size_t>(block_size_);
+  ppc::util::GemmProblem problem;
+  problem.m = problem.n = problem.k = k;
+  problem.a = local_a.data();
+  problem.lda = k;
+  problem.b = local_b.data();
+  problem.ldb = k;
+  problem.beta = 1.0;
+  problem.c = local_c.data();
+  problem.ldc = k;
+  const auto parallel_for = [](size_t count, const std::function<void(size_t)>& body) {
+    oneapi::tbb::parallel_for(size_t{0}, count, body);
+  };
+  const auto poll = [&pending] {
+    int done = 0;
+    MPI_Testall(static_cast<int>(pending.size()), pending.data(), &done, MPI_STATUSES_IGNORE);
+  };
+  oneapi::tbb::task_arena arena(ppc::util::GetPPCNumThreads());
+  arena.execute([&] { ppc::util::GemmBatchedWithProgress({&problem, 1}, parallel_for, poll); });
 }
 
-void vavilov_v_cannon_all::CannonALL::BlockMultiply(const std::vector<double>& local_a,
-                                                    const std::vector<double>& local_b, std::vector<double>& local_c) {
-#pragma omp parallel for
-  for (int i = 0; i < block_size_; ++i) {
-    for (int j = 0; j < block_size_; ++j) {
-      double temp = 0.0;
-      for (int k = 0; k < block_size_; ++k) {
-        temp += local_a[(i * block_size_) + k] * local_b[(k * block_size_) + j];
-      }
-      local_c[(i * block_size_) + j] += temp;
+void vavilov_v_cannon_all::CannonALL::CannonSteps(const mpi::communicator& comm, std::vector<double>& local_a,
+                                                  std::vector<double>& local_b, std::vector<double>& local_c) const {
+  const int rank = comm.rank();
+  const int grid_size = num_blocks_;
+  const int row = rank / grid_size;
+  const int col = rank % grid_size;
+  // A moves one block left, B one block up per step
+  const int send_rank_a = (row * grid_size) + ((col + grid_size - 1) % grid_size);
+  const int recv_rank_a = (row * grid_size) + ((col + 1) % grid_size);
+  const int send_rank_b = col + (grid_size * ((row + grid_size - 1) % grid_size));
+  const int recv_rank_b = col + (grid_size * ((row + 1) % grid_size));
+  const int count = block_size_ * block_size_;
+
+  // the blocks of the next step arrive in next_a and next_b while the
+  // current ones are multiplied and sent
+  std::vector<double> next_a(count);
+  std::vector<double> next_b(count);
+  std::vector<MPI_Request> pending;
+  for (int step = 0; step < grid_size; ++step) {
+    pending.clear();
+    if (step + 1 < grid_size) {
+      pending.resize(4);
+      MPI_Irecv(next_a.data(), count, MPI_DOUBLE, recv_rank_a, kTagA, comm, pending.data());
+      MPI_Irecv(next_b.data(), count, MPI_DOUBLE, recv_rank_b, kTagB, comm, &pending[1]);
+      MPI_Isend(local_a.data(), count, MPI_DOUBLE, send_rank_a, kTagA, comm, &pending[2]);
+      MPI_Isend(local_b.data(), count, MPI_DOUBLE, send_rank_b, kTagB, comm, &pending[3]);
     }
+    MultiplyAdd(local_a, local_b, local_c, pending);
+    MPI_Waitall(static_cast<int>(pending.size()), pending.data(), MPI_STATUSES_IGNORE);
+    std::swap(local_a, next_a);
+    std::swap(local_b, next_b);
   }
 }
 
@@ -144,11 +152,14 @@ void vavilov_v_cannon_all::CannonALL::PrepareScatterData(std::vector<double>& sc
                                                          int active_procs, int block_size_sq) {
   scatter_a.resize(active_procs * block_size_sq);
   scatter_b.resize(active_procs * block_size_sq);
+  // the initial skew is applied here: process (i, j) starts with
+  // A (i, i + j) and B (i + j, j)
   int index = 0;
   for (int block_row = 0; block_row < num_blocks_; ++block_row) {
     for (int block_col = 0; block_col < num_blocks_; ++block_col) {
-      TakeBlock(A_, scatter_a.data() + index, N_, block_size_, block_row, block_col);
-      TakeBlock(B_, scatter_b.data() + index, N_, block_size_, block_row, block_col);
+      const int skew = (block_row + block_col) % num_blocks_;
+      TakeBlock(A_, scatter_a.data() + index, N_, block_size_, block_row, skew);
+      TakeBlock(B_, scatter_b.data() + index, N_, block_size_, skew, block_col);
       index += block_size_sq;
     }
   }
@@ -185,13 +196,7 @@ bool vavilov_v_cannon_all::CannonALL::RunImpl() {
   mpi::scatter(active_world, scatter_a.data(), local_a.data(), block_size_sq, 0);
   mpi::scatter(active_world, scatter_b.data(), local_b.data(), block_size_sq, 0);
 
-  InitialShift(local_a, local_b);
-
-  BlockMultiply(local_a, local_b, local_c);
-  for (int iter = 0; iter < num_blocks_ - 1; ++iter) {
-    ShiftBlocks(local_a, local_b);
-    BlockMultiply(local_a, local_b, local_c);
-  }
+  CannonSteps(active_world, local_a, local_b, local_c);
 
   std::vector<double> tmp_c;
   if (rank == 0) {
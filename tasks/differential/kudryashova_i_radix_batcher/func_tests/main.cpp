@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "core/differential/include/differential.hpp"
+#include "core/perf/include/perf.hpp"
+#include "core/task/include/task.hpp"
+#include "omp/kudryashova_i_radix_batcher/include/kudryashovaRadixBatcherOMP.hpp"
+#include "seq/kudryashova_i_radix_batcher/include/kudryashovaRadixBatcherSeq.hpp"
+#include "stl/kudryashova_i_radix_batcher/include/kudryashovaRadixBatcherSTL.hpp"
+#include "tbb/kudryashova_i_radix_batcher/include/kudryashovaRadixBatcherTBB.hpp"
+
+namespace {
+
+class SortData {
+ public:
+  explicit SortData(std::vector<double> input) : input_(std::move(input)) {}
+
+  std::shared_ptr<ppc::core::TaskData> Make() {
+    outputs_.emplace_back(input_.size());
+    auto task_data = std::make_shared<ppc::core::TaskData>();
+    task_data->AddInput(input_.data(), input_.size());
+    task_data->AddOutput(outputs_.back().data(), outputs_.back().size());
+    return task_data;
+  }
+
+ private:
+  std::vector<double> input_;
+  std::vector<std::vector<double>> outputs_;
+};
+
+std::vector<double> GetRandomVector(size_t size, unsigned seed) {
+  std::mt19937 generator(seed);
+  std::uniform_real_distribution<double> distribution(-1000.0, 1000.0);
+  std::vector<double> vector(size);
+  for (auto &value : vector) {
+    value = distribution(generator);
+  }
+  return vector;
+}
+
+ppc::core::DifferentialTest MakeTest(SortData &data) {
+  ppc::core::DifferentialTest test([&data] { return data.Make(); });
+  test.AddBackend<kudryashova_i_radix_batcher_seq::TestTaskSequential>("seq");
+  test.AddBackend<kudryashova_i_radix_batcher_omp::TestTaskOpenMP>("omp");
+  test.AddBackend<kudryashova_i_radix_batcher_tbb::TestTaskTBB>("tbb");
+  test.AddBackend<kudryashova_i_radix_batcher_stl::TestTaskSTL>("stl");
+  // compare by value: the order of -0.0 and 0.0 is not specified
+  test.SetComparator(0, ppc::core::CompareElements<double>());
+  return test;
+}
+
+}  // namespace
+
+TEST(kudryashova_i_radix_batcher_differential, backends_agree_on_random_input) {
+  for (size_t size : {1, 2, 7, 100, 1023, 10000}) {
+    SortData data(GetRandomVector(size, static_cast<unsigned>(size)));
+    auto results = MakeTest(data).Run();
+    for (const auto &result : results) {
+      EXPECT_TRUE(result.passed) << "size " << size << ", " << result.name << ": " << result.message;
+    }
+  }
+}
+
+TEST(kudryashova_i_radix_batcher_differential, backends_agree_on_special_values) {
+  SortData data({0.0, -0.0, 1e-310, -1e-310, 1e308, -1e308, 3.5, 3.5, -3.5, 0.0});
+  auto results = MakeTest(data).Run();
+  for (const auto &result : results) {
+    EXPECT_TRUE(result.passed) << result.name << ": " << result.message;
+  }
+}
+
+TEST(kudryashova_i_radix_batcher_differential, speedup_table) {
+  SortData data(GetRandomVector(20000, 42));
+  auto perf_attr = std::make_shared<ppc::core::PerfAttr>();
+  perf_attr->num_running = 3;
+  const auto t0 = std::chrono::high_resolution_clock::now();
+  perf_attr->current_timer = [&] {
+    auto current_time_point = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(current_time_point - t0).count();
+    return static_cast<double>(duration) * 1e-9;
+  };
+
+  auto results = MakeTest(data).Run(perf_attr);
+  std::cout << ppc::core::DifferentialTest::FormatTable(results);
+  for (const auto &result : results) {
+    EXPECT_TRUE(result.passed) << result.name << ": " << result.message;
+  }
+}
@@ -0,0 +1,23 @@
+#include <gtest/gtest.h>
+#include <omp.h>
+#include <tbb/global_control.h>
+
+#include <memory>
+
+#include "core/util/include/util.hpp"
+#include "oneapi/tbb/global_control.h"
+
+int main(int argc, char** argv) {
+  // Every backend gets the same thread count
+  auto control = std::make_unique<tbb::global_control>(tbb::global_control::max_allowed_parallelism,
+                                                       ppc::util::GetPPCNumThreads());
+  ppc::util::AddNumThreadsObserver([&control](int num_threads) {
+    control.reset();
+    control = std::make_unique<tbb::global_control>(tbb::global_control::max_allowed_parallelism, num_threads);
+  });
+  omp_set_num_threads(ppc::util::GetPPCNumThreads());
+  ppc::util::AddNumThreadsObserver([](int num_threads) { omp_set_num_threads(num_threads); });
+
+  ::testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <array>
+#include <cstddef>
 #include <utility>
 #include <vector>
 
@@ -10,18 +11,24 @@ namespace burykin_m_radix_omp {
 
 class RadixOMP : public ppc::core::Task {
  public:
+  using Histogram = std::array<std::size_t, 256>;
+
   explicit RadixOMP(ppc::core::TaskDataPtr task_data) : Task(std::move(task_data)) {}
   bool PreProcessingImpl() override;
   bool ValidationImpl() override;
   bool RunImpl() override;
   bool PostProcessingImpl() override;
 
-  static std::array<int, 256> ComputeFrequency(const std::vector<int>& a, int shift);
-  static std::array<int, 256> ComputeIndices(const std::array<int, 256>& count);
-  static void DistributeElements(const std::vector<int>& a, std::vector<int>& b, std::array<int, 256> index, int shift);
+  // Digit counts of a[begin, end) for the byte at shift
+  static Histogram ComputeFrequency(const int* a, std::size_t begin, std::size_t end, int shift);
+  // Turns the per-thread counts into the first output position of every (digit, thread) pair:
+  // digits in order, threads in order within a digit, so the scatter stays stable
+  static void ComputeIndices(std::vector<Histogram>& histograms, int num_threads);
+  // Moves a[begin, end) to b starting at index[digit], staging a cache line per digit
+  static void DistributeElements(const int* a, int* b, std::size_t begin, std::size_t end, Histogram index, int shift);
 
  private:
   std::vector<int> input_, output_;
 };
 
-}  // namespace burykin_m_radix_omp
\ No newline at end of file
+}  // namespace burykin_m_radix_omp
@@ -1,79 +1,72 @@
 #include "omp/burykin_m_radix/include/ops_omp.hpp"
 
+#include <omp.h>
+
+#include <algorithm>
 #include <array>
+#include <cstddef>
 #include <utility>
 #include <vector>
 
-std::array<int, 256> burykin_m_radix_omp::RadixOMP::ComputeFrequency(const std::vector<int>& a, const int shift) {
-  std::array<int, 256> count = {};
+#include "core/task/include/registry.hpp"
 
-#pragma omp parallel default(none) shared(a, count, shift)
-  {
-    // Each thread maintains its own local counter
-    std::array<int, 256> local_count = {};
-
-#pragma omp for nowait
-    for (int i = 0; i < static_cast<int>(a.size()); ++i) {
-      const int v = a[i];
-      unsigned int key = ((static_cast<unsigned int>(v) >> shift) & 0xFFU);
-      if (shift == 24) {
-        key ^= 0x80;
-      }
-      ++local_count[key];
-    }
+namespace {
 
-// Merge local counters into the shared counter
-#pragma omp critical
-    {
-      for (int i = 0; i < 256; ++i) {
-        count[i] += local_count[i];
-      }
-    }
+// Elements of one digit collected before they are written out: one cache line
+constexpr std::size_t kBufferSize = 64 / sizeof(int);
+
+unsigned int GetKey(int v, int shift) {
+  unsigned int key = ((static_cast<unsigned int>(v) >> shift) & 0xFFU);
+  if (shift == 24) {
+    key ^= 0x80;
   }
+  return key;
+}
 
+}  // namespace
+
+burykin_m_radix_omp::RadixOMP::Histogram burykin_m_radix_omp::RadixOMP::ComputeFrequency(const int* a,
+                                                                                         std::size_t begin,
+                                                                                         std::size_t end,
+                                                                                         const int shift) {
+  Histogram count = {};
+  for (std::size_t i = begin; i < end; ++i) {
+    ++count[GetKey(a[i], shift)];
+  }
   return count;
 }
 
-std::array<int, 256> burykin_m_radix_omp::RadixOMP::ComputeIndices(const std::array<int, 256>& count) {
-  std::array<int, 256> index = {0};
-  // This loop has sequential dependency, cannot be parallelized
-  for (int i = 1; i < 256; ++i) {
-    index[i] = index[i - 1] + count[i - 1];
+void burykin_m_radix_omp::RadixOMP::ComputeIndices(std::vector<Histogram>& histograms, const int num_threads) {
+  std::size_t sum = 0;
+  for (std::size_t key = 0; key < 256; ++key) {
+    for (int thread = 0; thread < num_threads; ++thread) {
+      const std::size_t count = histograms[thread][key];
+      histograms[thread][key] = sum;
+      sum += count;
+    }
   }
-  return index;
 }
 
-void burykin_m_radix_omp::RadixOMP::DistributeElements(const std::vector<int>& a, std::vector<int>& b,
-                                                       std::array<int, 256> index, const int shift) {
-  // Create a copy of indices for parallel access
-  std::array<int, 256> local_index = index;
-
-  // Calculate offset for each element
-  std::vector<int> offsets(a.size());
+void burykin_m_radix_omp::RadixOMP::DistributeElements(const int* a, int* b, std::size_t begin, std::size_t end,
+                                                       Histogram index, const int shift) {
+  // Write-combining buffers: every digit is written in full cache lines instead of
+  // one scattered store per element
+  alignas(64) std::array<std::array<int, kBufferSize>, 256> buffers;
+  std::array<std::size_t, 256> filled = {};
 
-#pragma omp parallel for default(none) shared(a, offsets, local_index, shift)
-  for (int i = 0; i < static_cast<int>(a.size()); ++i) {
+  for (std::size_t i = begin; i < end; ++i) {
     const int v = a[i];
-    unsigned int key = ((static_cast<unsigned int>(v) >> shift) & 0xFFU);
-    if (shift == 24) {
-      key ^= 0x80;
-    }
-
-    int pos = 0;
-#pragma omp critical
-    {
-      pos = local_index[key];
-      local_index[key]++;
+    const unsigned int key = GetKey(v, shift);
+    buffers[key][filled[key]++] = v;
+    if (filled[key] == kBufferSize) {
+      std::copy(buffers[key].begin(), buffers[key].end(), b + index[key]);
+      index[key] += kBufferSize;
+      filled[key] = 0;
     }
-
-    // Store position for later use
-    offsets[i] = pos;
   }
 
-// Distribute elements to output array using calculated offsets
-#pragma omp parallel for default(none) shared(a, b, offsets)
-  for (int i = 0; i < static_cast<int>(a.size()); ++i) {
-    b[offsets[i]] = a[i];
+  for (std::size_t key = 0; key < 256; ++key) {
+    std::copy(buffers[key].begin(), buffers[key].begin() + static_cast<std::ptrdiff_t>(filled[key]), b + index[key]);
   }
 }
 
@@ -95,25 +88,33 @@ bool burykin_m_radix_omp::RadixOMP::RunImpl() {
     return true;
   }
 
-  std::vector<int> a = std::move(input_);
-  std::vector<int> b(a.size());
+  const std::size_t size = input_.size();
+  std::vector<int> buffer(size);
+  std::vector<Histogram> histograms(omp_get_max_threads());
 
-#pragma omp parallel
+#pragma omp parallel default(none) shared(size, buffer, histograms)
   {
-// Single directive ensures one thread executes the outer loop
-// while inner operations can still be parallelized
+    const int num_threads = omp_get_num_threads();
+    const int thread = omp_get_thread_num();
+    // Every thread keeps the same contiguous block in all passes
+    const std::size_t begin = size * thread / num_threads;
+    const std::size_t end = size * (thread + 1) / num_threads;
+    int* src = input_.data();
+    int* dst = buffer.data();
+
+    for (int shift = 0; shift < 32; shift += 8) {
+      histograms[thread] = ComputeFrequency(src, begin, end, shift);
+#pragma omp barrier
 #pragma omp single
-    {
-      for (int shift = 0; shift < 32; shift += 8) {
-        auto count = ComputeFrequency(a, shift);
-        const auto index = ComputeIndices(count);
-        DistributeElements(a, b, index, shift);
-        a.swap(b);
-      }
+      ComputeIndices(histograms, num_threads);
+      DistributeElements(src, dst, begin, end, histograms[thread], shift);
+#pragma omp barrier
+      std::swap(src, dst);
     }
   }
 
-  output_ = std::move(a);
+  // Even number of passes: the sorted data is back in input_
+  output_ = std::move(input_);
   return true;
 }
 
@@ -127,4 +128,6 @@ bool burykin_m_radix_omp::RadixOMP::PostProcessingImpl() {
     output_ptr[i] = output_[i];
   }
   return true;
-}
\ No newline at end of file
+}
+
+PPC_REGISTER_SORT_TASK(burykin_m_radix_omp::RadixOMP, "burykin_m_radix", "omp", int);
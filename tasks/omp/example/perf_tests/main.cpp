@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 
 #include <chrono>
+#include <cmath>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
@@ -91,3 +92,53 @@ TEST(nesterov_a_test_task_omp, test_task_run) {
   ppc::core::Perf::PrintPerfStatistic(perf_results);
   ASSERT_EQ(in, out);
 }
+
+TEST(nesterov_a_test_task_omp, test_scaling_run) {
+  // Storage of matrices of every generated task
+  std::vector<std::vector<int>> inputs;
+  std::vector<std::vector<int>> outputs;
+  inputs.reserve(16);
+  outputs.reserve(16);
+
+  // Create identity matrix of size elements for every point of the sweep
+  auto generator = [&](uint64_t size) {
+    const auto count = static_cast<size_t>(std::sqrt(static_cast<double>(size)));
+    inputs.emplace_back(count * count, 0);
+    outputs.emplace_back(count * count, 0);
+    for (size_t i = 0; i < count; i++) {
+      inputs.back()[(i * count) + i] = 1;
+    }
+    auto task_data_omp = std::make_shared<ppc::core::TaskData>();
+    task_data_omp->inputs.emplace_back(reinterpret_cast<uint8_t *>(inputs.back().data()));
+    task_data_omp->inputs_count.emplace_back(inputs.back().size());
+    task_data_omp->outputs.emplace_back(reinterpret_cast<uint8_t *>(outputs.back().data()));
+    task_data_omp->outputs_count.emplace_back(outputs.back().size());
+    return std::make_shared<nesterov_a_test_task_omp::TestTaskOpenMP>(task_data_omp);
+  };
+
+  // Create Perf attributes
+  auto perf_attr = std::make_shared<ppc::core::PerfAttr>();
+  perf_attr->num_running = 3;
+  const auto t0 = std::chrono::high_resolution_clock::now();
+  perf_attr->current_timer = [&] {
+    auto current_time_point = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(current_time_point - t0).count();
+    return static_cast<double>(duration) * 1e-9;
+  };
+
+  // Sweep matrices of 50x50 to 150x150 over 1 and 2 threads, one run multiplies two matrices
+  ppc::core::ScalingAttr scaling_attr;
+  scaling_attr.sizes = {50 * 50, 100 * 100, 150 * 150};
+  scaling_attr.num_threads = {1, 2};
+  scaling_attr.flops = [](uint64_t size) { return 2.0 * std::pow(static_cast<double>(size), 1.5); };
+
+  // Create and init scaling results
+  auto scaling_results = std::make_shared<ppc::core::ScalingResults>();
+
+  ppc::core::Perf::ScalingRun(generator, perf_attr, scaling_attr, scaling_results);
+  ppc::core::Perf::PrintScalingStatistic(scaling_results);
+  ASSERT_EQ(scaling_results->points.size(), 6U);
+  for (size_t i = 0; i < inputs.size(); i++) {
+    ASSERT_EQ(inputs[i], outputs[i]);
+  }
+}
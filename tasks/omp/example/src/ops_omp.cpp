@@ -4,6 +4,8 @@
 #include <cstddef>
 #include <vector>
 
+#include "core/task/include/registry.hpp"
+
 bool nesterov_a_test_task_omp::TestTaskOpenMP::PreProcessingImpl() {
   // Init value for input and output
   unsigned int input_size = task_data->inputs_count[0];
@@ -47,3 +49,5 @@ bool nesterov_a_test_task_omp::TestTaskOpenMP::PostProcessingImpl() {
   }
   return true;
 }
+
+PPC_REGISTER_TASK(nesterov_a_test_task_omp::TestTaskOpenMP, "example", "omp", ppc::core::MakeIdentitySquareInput);
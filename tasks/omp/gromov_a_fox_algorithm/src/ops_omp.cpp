@@ -2,8 +2,12 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstddef>
+#include <functional>
 #include <vector>
 
+#include "core/util/include/gemm.hpp"
+
 bool gromov_a_fox_algorithm_omp::TestTaskOpenMP::PreProcessingImpl() {
   unsigned int input_size = task_data->inputs_count[0];
   if (input_size % 2 != 0) {
@@ -24,13 +28,21 @@ bool gromov_a_fox_algorithm_omp::TestTaskOpenMP::PreProcessingImpl() {
     return false;
   }
 
-  block_size_ = n_ / 2;
-  for (int i = 1; i <= n_; ++i) {
+  block_size_ = static_cast<int>(std::sqrt(n_));
+  for (int i = block_size_; i >= 1; --i) {
     if (n_ % i == 0) {
       block_size_ = i;
       break;
     }
   }
+  for (int i = block_size_ + 1; i <= n_; ++i) {
+    if (n_ % i == 0) {
+      if (std::abs(i - static_cast<int>(std::sqrt(n_))) < std::abs(block_size_ - static_cast<int>(std::sqrt(n_)))) {
+        block_size_ = i;
+      }
+      break;
+    }
+  }
   return block_size_ > 0;
 }
 
@@ -45,28 +57,18 @@ bool gromov_a_fox_algorithm_omp::TestTaskOpenMP::ValidationImpl() {
 }
 
 bool gromov_a_fox_algorithm_omp::TestTaskOpenMP::RunImpl() {
-  int num_blocks = (n_ + block_size_ - 1) / block_size_;
-
-  std::vector<double>& a_ref = A_;
-  std::vector<double>& b_ref = B_;
-  std::vector<double>& output_ref = output_;
-  int n_ref = n_;
-  int block_size_ref = block_size_;
-
-  for (int stage = 0; stage < num_blocks; ++stage) {
-#pragma omp parallel for default(none) shared(a_ref, b_ref, output_ref, n_ref, block_size_ref, stage)
-    for (int i = 0; i < n_ref; i += block_size_ref) {
-      for (int j = 0; j < n_ref; j += block_size_ref) {
-        for (int bi = i; bi < i + block_size_ref && bi < n_ref; ++bi) {
-          for (int bj = j; bj < j + block_size_ref && bj < n_ref; ++bj) {
-            int start_k = stage * block_size_ref;
-            for (int bk = start_k; bk < std::min((stage + 1) * block_size_ref, n_ref); ++bk) {
-              output_ref[(bi * n_ref) + bj] += a_ref[(bi * n_ref) + bk] * b_ref[(bk * n_ref) + bj];
-            }
-          }
-        }
-      }
+  // the block products of a stage are independent, the stages add up
+  const int num_blocks = (n_ + block_size_ - 1) / block_size_;
+  const auto parallel_for = [](size_t count, const std::function<void(size_t)>& body) {
+#pragma omp parallel for schedule(dynamic)
+    for (int i = 0; i < static_cast<int>(count); ++i) {
+      body(static_cast<size_t>(i));
     }
+  };
+  for (int stage = 0; stage < num_blocks; ++stage) {
+    const auto batch = ppc::util::BlockStageBatch(A_.data(), B_.data(), output_.data(), n_, block_size_, stage,
+                                                  ppc::util::BlockSchedule::kFox);
+    ppc::util::GemmBatched(batch, parallel_for);
   }
   return true;
 }
@@ -1,12 +1,22 @@
 // Copyright 2025 Kavtorev Dmitry
 #include "omp/kavtorev_d_dense_matrix_cannon/include/ops_omp.hpp"
 
-#include <omp.h>
-
 #include <algorithm>
 #include <cstddef>
+#include <functional>
 #include <vector>
 
+#include "core/util/include/gemm.hpp"
+
+namespace {
+void OmpParallelFor(size_t count, const std::function<void(size_t)>& body) {
+#pragma omp parallel for schedule(dynamic)
+  for (int i = 0; i < static_cast<int>(count); ++i) {
+    body(static_cast<size_t>(i));
+  }
+}
+}  // namespace
+
 std::vector<double> kavtorev_d_dense_matrix_cannon_omp::CannonMatrixMultiplication(const std::vector<double>& a,
                                                                                    const std::vector<double>& b, int n,
                                                                                    int m) {
@@ -18,24 +28,32 @@ std::vector<double> kavtorev_d_dense_matrix_cannon_omp::CannonMatrixMultiplicati
     return {};
   }
 
-#pragma omp parallel for schedule(static)
-  for (int i = 0; i < n; i += size_block) {
-    for (int j = 0; j < m; j += size_block) {
-      for (int k = 0; k < m; k += size_block) {
-        int i_end = std::min(i + size_block, n);
-        int j_end = std::min(j + size_block, m);
-        int k_end = std::min(k + size_block, m);
-
-        for (int ii = i; ii < i_end; ++ii) {
-          for (int kk = k; kk < k_end; ++kk) {
-            double a_ik = a[(ii * m) + kk];
-            for (int jj = j; jj < j_end; ++jj) {
-              mtrx_c[(ii * m) + jj] += a_ik * b[(kk * m) + jj];
-            }
-          }
-        }
+  // Произведения округляются отдельно (без FMA), как в обычном цикле
+  ppc::util::GemmOptions options;
+  options.fused = false;
+
+  // Блоки C одного шага по k независимы, шаги складываются по порядку
+  const auto ld = static_cast<size_t>(m);
+  std::vector<ppc::util::GemmProblem> batch;
+  for (int k = 0; k < m; k += size_block) {
+    batch.clear();
+    for (int i = 0; i < n; i += size_block) {
+      for (int j = 0; j < m; j += size_block) {
+        ppc::util::GemmProblem problem;
+        problem.m = static_cast<size_t>(std::min(i + size_block, n) - i);
+        problem.n = static_cast<size_t>(std::min(j + size_block, m) - j);
+        problem.k = static_cast<size_t>(std::min(k + size_block, m) - k);
+        problem.a = a.data() + (i * ld) + k;
+        problem.lda = ld;
+        problem.b = b.data() + (k * ld) + j;
+        problem.ldb = ld;
+        problem.beta = 1.0;
+        problem.c = mtrx_c.data() + (i * ld) + j;
+        problem.ldc = ld;
+        batch.push_back(problem);
       }
     }
+    ppc::util::GemmBatched(batch, OmpParallelFor, options);
   }
 
   return mtrx_c;
@@ -51,14 +69,20 @@ std::vector<double> kavtorev_d_dense_matrix_cannon_omp::MultiplyMatrix(const std
     return {};
   }
 
-#pragma omp parallel for schedule(static)  // Распараллеливаем внешние циклы
-  for (int i = 0; i < rows_a; ++i) {
-    for (int j = 0; j < col_b; ++j) {
-      for (int k = 0; k < col_a; ++k) {
-        mtrx_c[(i * col_b) + j] += a[(i * col_a) + k] * b[(k * col_b) + j];
-      }
-    }
-  }
+  // a large product is split into bands of rows by GemmBatched, without FMA like CannonMatrixMultiplication
+  ppc::util::GemmOptions options;
+  options.fused = false;
+  ppc::util::GemmProblem problem;
+  problem.m = static_cast<size_t>(rows_a);
+  problem.n = static_cast<size_t>(col_b);
+  problem.k = static_cast<size_t>(col_a);
+  problem.a = a.data();
+  problem.lda = problem.k;
+  problem.b = b.data();
+  problem.ldb = problem.n;
+  problem.c = mtrx_c.data();
+  problem.ldc = problem.n;
+  ppc::util::GemmBatched({&problem, 1}, OmpParallelFor, options);
   return mtrx_c;
 }
 
@@ -10,6 +10,8 @@
 #include <span>
 #include <vector>
 
+#include "core/util/include/sorting_network.hpp"
+
 namespace korovin_n_qsort_batcher_omp {
 
 int TestTaskOpenMP::GetRandomIndex(int low, int high) {
@@ -47,35 +49,18 @@ void TestTaskOpenMP::QuickSort(std::vector<int>::iterator low, std::vector<int>:
 }
 
 bool TestTaskOpenMP::InPlaceMerge(const BlockRange& a, const BlockRange& b, std::vector<int>& buffer) {
-  bool changed = false;
-  int len_a = static_cast<int>(std::distance(a.low, a.high));
-  int len_b = static_cast<int>(std::distance(b.low, b.high));
-
-  std::span<int> span_a{a.low, static_cast<size_t>(len_a)};
-  std::span<int> span_b{b.low, static_cast<size_t>(len_b)};
-
-  size_t i = 0;
-  size_t j = 0;
-  size_t k = 0;
-
-  while (i < span_a.size() && j < span_b.size()) {
-    if (span_a[i] <= span_b[j]) {
-      buffer[k++] = span_a[i++];
-    } else {
-      changed = true;
-      buffer[k++] = span_b[j++];
-    }
-  }
-  while (i < span_a.size()) {
-    buffer[k++] = span_a[i++];
-  }
-  while (j < span_b.size()) {
-    changed = true;
-    buffer[k++] = span_b[j++];
+  const std::span<const int> span_a{a.low, a.high};
+  const std::span<const int> span_b{b.low, b.high};
+  // The phase reports a change for every pair with a non-empty right block,
+  // pairs that are in order already skip the merge and the copies
+  const bool changed = !span_b.empty();
+  if (span_a.empty() || !changed || span_a.back() <= span_b.front()) {
+    return changed;
   }
+  ppc::util::NetworkMerge(span_a, span_b, buffer.data());
+  const auto len_a = static_cast<std::ptrdiff_t>(span_a.size());
   std::ranges::copy(buffer.begin(), buffer.begin() + len_a, a.low);
-  std::ranges::copy(buffer.begin() + len_a, buffer.begin() + len_a + len_b, b.low);
-
+  std::ranges::copy(buffer.begin() + len_a, buffer.begin() + len_a + static_cast<std::ptrdiff_t>(span_b.size()), b.low);
   return changed;
 }
 
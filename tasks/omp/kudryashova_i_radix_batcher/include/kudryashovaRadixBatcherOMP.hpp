@@ -9,6 +9,8 @@
 
 namespace kudryashova_i_radix_batcher_omp {
 std::vector<double> GetRandomDoubleVector(int size);
+// Blocks up to this size are sorted with SIMD sorting networks instead of radix passes
+constexpr size_t kNetworkSortMaxSize = 4096;
 void RadixDoubleSort(std::vector<double>& data, size_t first, size_t last);
 void BatcherMerge(std::vector<double>& target_array, size_t merge_start, size_t mid_point, size_t merge_end);
 
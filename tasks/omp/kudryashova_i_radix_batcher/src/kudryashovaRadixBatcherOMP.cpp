@@ -3,115 +3,73 @@
 #include <omp.h>
 
 #include <algorithm>
-#include <atomic>
 #include <cstddef>
 #include <cstdint>
-#include <cstring>
+#include <span>
+#include <utility>
 #include <vector>
 
+#include "core/task/include/registry.hpp"
+#include "core/util/include/radix_sort.hpp"
+#include "core/util/include/sorting_network.hpp"
+
 void kudryashova_i_radix_batcher_omp::RadixDoubleSort(std::vector<double>& data, size_t first, size_t last) {
   const size_t sort_size = last - first;
-  std::vector<uint64_t> converted(sort_size);
-
-#pragma omp parallel for
-  for (int i = 0; i < static_cast<int>(sort_size); ++i) {
-    double value = data[first + i];
-    uint64_t bits = 0;
-    std::memcpy(&bits, &value, sizeof(value));
-    converted[i] = ((bits & (1ULL << 63)) != 0) ? ~bits : bits ^ (1ULL << 63);
+  if (sort_size <= kNetworkSortMaxSize) {
+    ppc::util::NetworkSort(std::span<double>(data).subspan(first, sort_size));
+    return;
   }
-
+  using KeyTraits = ppc::util::RadixKeyTraits<double>;
+  constexpr int kKeyBits = 64;
+  const int digit_bits = ppc::util::RadixDigitBits(sort_size, kKeyBits);
+  const int num_passes = ppc::util::RadixNumPasses(kKeyBits, digit_bits);
+  const size_t num_digits = size_t{1} << digit_bits;
+
+  // Called for one block per thread of the parallel loop in RunImpl, so the
+  // passes run on the calling thread
+  std::vector<uint64_t> converted(sort_size);
   std::vector<uint64_t> buffer(sort_size);
-  const int bits_in_byte = 8;
-  const int total_passes = sizeof(uint64_t);
-  const int max_byte_value = 255;
-
-  for (int shift = 0; shift < total_passes; ++shift) {
-    std::vector<size_t> count(256, 0);
-    const int shift_loc = shift * bits_in_byte;
-
-#pragma omp parallel
-    {
-      std::vector<size_t> local_count(256, 0);
-#pragma omp for
-      for (int i = 0; i < static_cast<int>(sort_size); ++i) {
-        ++local_count[(converted[i] >> shift_loc) & max_byte_value];
-      }
-#pragma omp critical
-      {
-        for (int j = 0; j < 256; ++j) {
-          count[j] += local_count[j];
-        }
-      }
-    }
-
-    size_t total = 0;
-    for (int j = 0; j < 256; ++j) {
-      size_t old = count[j];
-      count[j] = total;
-      total += old;
+  std::vector<size_t> counts(num_passes * num_digits);
+  uint64_t* src = converted.data();
+  uint64_t* dst = buffer.data();
+  for (size_t i = 0; i < sort_size; ++i) {
+    src[i] = KeyTraits::ToBits(data[first + i]);
+  }
+  // digit counts of all passes in one sweep
+  ppc::util::RadixCountAll(src, 0, sort_size, digit_bits, counts.data());
+
+  for (int pass = 0; pass < num_passes; ++pass) {
+    size_t* index = counts.data() + (static_cast<size_t>(pass) * num_digits);
+    const int shift = pass * digit_bits;
+    // all keys share the digit: the pass would only copy the data
+    if (ppc::util::RadixPassIsConstant(index, digit_bits, sort_size)) {
+      continue;
     }
-
-    std::vector<std::atomic<size_t>> atomic_count(256);
-    for (int j = 0; j < 256; ++j) {
-      atomic_count[j] = count[j];
+    size_t sum = 0;
+    for (size_t digit = 0; digit < num_digits; ++digit) {
+      const size_t count = index[digit];
+      index[digit] = sum;
+      sum += count;
     }
-#pragma omp parallel for
-    for (int i = 0; i < static_cast<int>(sort_size); ++i) {
-      const uint8_t byte = (converted[i] >> shift_loc) & max_byte_value;
-      size_t pos = atomic_count[byte].fetch_add(1, std::memory_order_seq_cst);
-      buffer[pos] = converted[i];
+    for (size_t i = 0; i < sort_size; ++i) {
+      dst[index[(src[i] >> shift) & (num_digits - 1)]++] = src[i];
     }
-
-    converted.swap(buffer);
+    std::swap(src, dst);
   }
 
-#pragma omp parallel for
-  for (int i = 0; i < static_cast<int>(sort_size); ++i) {
-    uint64_t bits = converted[i];
-    bits = ((bits & (1ULL << 63)) != 0) ? (bits ^ (1ULL << 63)) : ~bits;
-    std::memcpy(&data[first + i], &bits, sizeof(double));
+  for (size_t i = 0; i < sort_size; ++i) {
+    data[first + i] = KeyTraits::FromBits(src[i]);
   }
 }
 
 void kudryashova_i_radix_batcher_omp::BatcherMerge(std::vector<double>& target_array, size_t merge_start,
                                                    size_t mid_point, size_t merge_end) {
-  const size_t total_elements = merge_end - merge_start;
-  std::vector<double> merge_buffer(total_elements);
-  const size_t left_size = mid_point - merge_start;
-  const size_t right_size = merge_end - mid_point;
-  std::vector<double> left_array(target_array.begin() + static_cast<std::ptrdiff_t>(merge_start),
-                                 target_array.begin() + static_cast<std::ptrdiff_t>(mid_point));
-
-  std::vector<double> right_array(target_array.begin() + static_cast<std::ptrdiff_t>(mid_point),
-                                  target_array.begin() + static_cast<std::ptrdiff_t>(merge_end));
-  size_t left_ptr = 0;
-  size_t right_ptr = 0;
-  size_t merge_ptr = merge_start;
-#pragma omp parallel
-  {
-    const int num_threads = omp_get_num_threads();
-    const int thread_id = omp_get_thread_num();
-    const size_t chunk = (total_elements + num_threads - 1) / num_threads;
-    const size_t start = std::min(thread_id * chunk, total_elements);
-    const size_t end = std::min((thread_id + 1) * chunk, total_elements);
-
-    for (size_t i = start; i < end; ++i) {
-      if (i % 2 == 0) {
-        if (left_ptr < left_size && (right_ptr >= right_size || left_array[left_ptr] <= right_array[right_ptr])) {
-          target_array[merge_ptr++] = left_array[left_ptr++];
-        } else {
-          target_array[merge_ptr++] = right_array[right_ptr++];
-        }
-      } else {
-        if (right_ptr < right_size && (left_ptr >= left_size || right_array[right_ptr] <= left_array[left_ptr])) {
-          target_array[merge_ptr++] = right_array[right_ptr++];
-        } else {
-          target_array[merge_ptr++] = left_array[left_ptr++];
-        }
-      }
-    }
-  }
+  // The merges of one level already run in parallel, so a merge is a single
+  // branch-free network pass; only the left run is copied away
+  const std::vector<double> left_array(target_array.begin() + static_cast<std::ptrdiff_t>(merge_start),
+                                       target_array.begin() + static_cast<std::ptrdiff_t>(mid_point));
+  ppc::util::NetworkMerge(left_array, std::span<const double>(target_array).subspan(mid_point, merge_end - mid_point),
+                          target_array.data() + merge_start);
 }
 
 bool kudryashova_i_radix_batcher_omp::TestTaskOpenMP::PreProcessingImpl() {
@@ -159,3 +117,5 @@ bool kudryashova_i_radix_batcher_omp::TestTaskOpenMP::PostProcessingImpl() {
   std::ranges::copy(input_data_, reinterpret_cast<double*>(task_data->outputs[0]));
   return true;
 }
+
+PPC_REGISTER_SORT_TASK(kudryashova_i_radix_batcher_omp::TestTaskOpenMP, "kudryashova_i_radix_batcher", "omp", double);
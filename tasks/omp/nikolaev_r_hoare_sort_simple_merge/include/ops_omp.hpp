@@ -20,6 +20,8 @@ class HoareSortSimpleMergeOpenMP : public ppc::core::Task {
 
  private:
   std::vector<double> vect_;
+  // second buffer of the merge levels
+  std::vector<double> buffer_;
   size_t vect_size_{};
 
   size_t Partition(size_t low, size_t high);
@@ -8,10 +8,40 @@
 #include <utility>
 #include <vector>
 
+#include "core/task/include/registry.hpp"
+
+namespace {
+
+// Number of elements of a among the first k elements of the stable merge of a and b
+size_t CoRank(const double *a, size_t a_size, const double *b, size_t b_size, size_t k) {
+  size_t low = k > b_size ? k - b_size : 0;
+  size_t high = std::min(k, a_size);
+  while (low < high) {
+    const size_t middle = low + ((high - low) / 2);
+    if (a[middle] <= b[k - middle - 1]) {
+      low = middle + 1;
+    } else {
+      high = middle;
+    }
+  }
+  return low;
+}
+
+// Writes the elements [out_begin, out_end) of the merge of a and b to out + out_begin
+void MergePart(const double *a, size_t a_size, const double *b, size_t b_size, size_t out_begin, size_t out_end,
+               double *out) {
+  const size_t a_begin = CoRank(a, a_size, b, b_size, out_begin);
+  const size_t a_end = CoRank(a, a_size, b, b_size, out_end);
+  std::merge(a + a_begin, a + a_end, b + (out_begin - a_begin), b + (out_end - a_end), out + out_begin);
+}
+
+}  // namespace
+
 bool nikolaev_r_hoare_sort_simple_merge_omp::HoareSortSimpleMergeOpenMP::PreProcessingImpl() {
   vect_size_ = task_data->inputs_count[0];
   auto *vect_ptr = reinterpret_cast<double *>(task_data->inputs[0]);
   vect_ = std::vector<double>(vect_ptr, vect_ptr + vect_size_);
+  buffer_.resize(vect_size_);
 
   return true;
 }
@@ -45,47 +75,44 @@ bool nikolaev_r_hoare_sort_simple_merge_omp::HoareSortSimpleMergeOpenMP::RunImpl
     QuickSort(segments[i].first, segments[i].second);
   }
 
+  // Every level merges all pairs of neighbouring segments from one buffer into the other. The output of a
+  // level is split evenly between the threads (merge path), so all threads stay busy up to the last merge
+  double *src = vect_.data();
+  double *dst = buffer_.data();
   while (segments.size() > 1) {
-    size_t num_pairs = segments.size() / 2;
     std::vector<std::pair<size_t, size_t>> new_segments;
-    new_segments.resize(num_pairs);
-
-#pragma omp parallel for schedule(static)
-    for (int i = 0; i < static_cast<int>(num_pairs); i++) {
-      size_t left_start = segments[2 * i].first;
-      size_t left_end = segments[2 * i].second;
-
-      size_t right_start = segments[(2 * i) + 1].first;
-      size_t right_end = segments[(2 * i) + 1].second;
-
-      size_t merged_size = right_end - left_start + 1;
-      std::vector<double> merged(merged_size);
-
-      size_t i1 = left_start;
-      size_t i2 = right_start;
-      size_t k = 0;
-      while (i1 <= left_end && i2 <= right_end) {
-        if (vect_[i1] < vect_[i2]) {
-          merged[k++] = vect_[i1++];
-        } else {
-          merged[k++] = vect_[i2++];
-        }
-      }
-      while (i1 <= left_end) {
-        merged[k++] = vect_[i1++];
-      }
-      while (i2 <= right_end) {
-        merged[k++] = vect_[i2++];
-      }
-
-      std::ranges::copy(merged, vect_.begin() + static_cast<std::ptrdiff_t>(left_start));
-      new_segments[i] = {left_start, right_end};
+    new_segments.reserve((segments.size() + 1) / 2);
+    for (size_t i = 0; i + 1 < segments.size(); i += 2) {
+      new_segments.emplace_back(segments[i].first, segments[i + 1].second);
     }
     if (segments.size() % 2 == 1) {
       new_segments.push_back(segments.back());
     }
+
+#pragma omp parallel num_threads(num_threads)
+    {
+      const auto thread = static_cast<size_t>(omp_get_thread_num());
+      const auto team_size = static_cast<size_t>(omp_get_num_threads());
+      const size_t out_begin = vect_size_ * thread / team_size;
+      const size_t out_end = vect_size_ * (thread + 1) / team_size;
+      for (size_t i = 0; i < new_segments.size(); i++) {
+        const size_t first = new_segments[i].first;
+        const size_t last = new_segments[i].second + 1;
+        if (last <= out_begin || first >= out_end) {
+          continue;
+        }
+        // the odd segment is a merge with an empty right part
+        const size_t middle = (2 * i) + 1 < segments.size() ? segments[(2 * i) + 1].first : last;
+        MergePart(src + first, middle - first, src + middle, last - middle, std::max(out_begin, first) - first,
+                  std::min(out_end, last) - first, dst + first);
+      }
+    }
+    std::swap(src, dst);
     segments.swap(new_segments);
   }
+  if (src != vect_.data()) {
+    vect_.swap(buffer_);
+  }
   return true;
 }
 
@@ -127,4 +154,7 @@ void nikolaev_r_hoare_sort_simple_merge_omp::HoareSortSimpleMergeOpenMP::QuickSo
     QuickSort(low, pivot - 1);
   }
   QuickSort(pivot + 1, high);
-}
\ No newline at end of file
+}
+
+PPC_REGISTER_SORT_TASK(nikolaev_r_hoare_sort_simple_merge_omp::HoareSortSimpleMergeOpenMP,
+                       "nikolaev_r_hoare_sort_simple_merge", "omp", double);
@@ -5,9 +5,12 @@
 #include <algorithm>
 #include <cmath>
 #include <cstddef>
+#include <span>
 #include <utility>
 #include <vector>
 
+#include "core/util/include/sorting_network.hpp"
+
 bool opolin_d_radix_batcher_sort_omp::RadixBatcherSortTaskOpenMP::PreProcessingImpl() {
   auto *in_ptr = reinterpret_cast<int *>(task_data->inputs[0]);
   input_ = std::vector<int>(in_ptr, in_ptr + size_);
@@ -133,24 +136,8 @@ void opolin_d_radix_batcher_sort_omp::SortByDigit(std::vector<int> &array, int d
 }
 
 void opolin_d_radix_batcher_sort_omp::BatcherOddEvenMerge(std::vector<int> &array, int start, int mid, int end) {
-  int n = end - start;
-  if (n <= 1) {
-    return;
-  }
-  int p = 0;
-  if (n <= 1) {
-    p = 0;
-  } else {
-    int exp = static_cast<int>(std::floor(std::log2(n)));
-    p = 1 << exp;
-  }
-  while (p > 0) {
-#pragma omp parallel for
-    for (int i = start; i < end - p; i++) {
-      if (array[i] > array[i + p]) {
-        std::swap(array[i], array[i + p]);
-      }
-    }
-    p /= 2;
-  }
+  // Branch-free network merge of the sorted blocks [start, mid) and [mid, end),
+  // only the left block is copied away
+  const std::vector<int> left(array.begin() + start, array.begin() + mid);
+  ppc::util::NetworkMerge(left, std::span<const int>(array).subspan(mid, end - mid), array.data() + start);
 }
\ No newline at end of file
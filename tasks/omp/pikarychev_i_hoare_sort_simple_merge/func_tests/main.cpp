@@ -78,6 +78,7 @@ TEST(pikarychev_i_hoare_sort_simple_merge_omp, standard_116) { PerformTest(116,
 TEST(pikarychev_i_hoare_sort_simple_merge_omp, standard_125) { PerformTest(125, false); }
 TEST(pikarychev_i_hoare_sort_simple_merge_omp, standard_126) { PerformTest(126, false); }
 TEST(pikarychev_i_hoare_sort_simple_merge_omp, standard_127) { PerformTest(127, false); }
+TEST(pikarychev_i_hoare_sort_simple_merge_omp, standard_20000) { PerformTest(20000, false); }
 
 TEST(pikarychev_i_hoare_sort_simple_merge_omp, reverse_0) { PerformTest(0, true); }
 TEST(pikarychev_i_hoare_sort_simple_merge_omp, reverse_1) { PerformTest(1, true); }
@@ -120,4 +121,5 @@ TEST(pikarychev_i_hoare_sort_simple_merge_omp, reverse_115) { PerformTest(115, t
 TEST(pikarychev_i_hoare_sort_simple_merge_omp, reverse_116) { PerformTest(116, true); }
 TEST(pikarychev_i_hoare_sort_simple_merge_omp, reverse_125) { PerformTest(125, true); }
 TEST(pikarychev_i_hoare_sort_simple_merge_omp, reverse_126) { PerformTest(126, true); }
-TEST(pikarychev_i_hoare_sort_simple_merge_omp, reverse_127) { PerformTest(127, true); }
\ No newline at end of file
+TEST(pikarychev_i_hoare_sort_simple_merge_omp, reverse_127) { PerformTest(127, true); }
+TEST(pikarychev_i_hoare_sort_simple_merge_omp, reverse_20000) { PerformTest(20000, true); }
\ No newline at end of file
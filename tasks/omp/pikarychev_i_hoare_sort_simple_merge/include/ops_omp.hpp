@@ -2,21 +2,18 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <span>
 #include <utility>
 #include <vector>
 
 #include "core/task/include/task.hpp"
+#include "core/util/include/sample_sort.hpp"
 #include "core/util/include/util.hpp"
 
 namespace pikarychev_i_hoare_sort_simple_merge {
 
 template <class T>
 class HoareOpenMP : public ppc::core::Task {
-  struct Block {
-    T* e;
-    std::size_t sz;
-  };
-
  public:
   explicit HoareOpenMP(ppc::core::TaskDataPtr task_data) : Task(std::move(task_data)) {}
 
@@ -35,43 +32,20 @@ class HoareOpenMP : public ppc::core::Task {
   }
 
   bool RunImpl() override {
-    const auto size = input_.size();
-    std::ranges::copy_n(input_.begin(), size, res_.begin());
-
-    const auto parallelism = std::min<std::size_t>(size, ppc::util::GetPPCNumThreads());
-    if (size < 1) {
-      return true;
-    }
-
-    const auto fair = size / parallelism;
-    const auto extra = size % parallelism;
-
-    std::vector<Block> blocks(parallelism);
-    T* pointer = res_.data();
-    for (std::size_t i = 0; i < parallelism; i++) {
-      blocks[i] = {.e = pointer, .sz = fair + ((i < extra) ? 1 : 0)};
-      pointer += blocks[i].sz;
-    }
-
-#pragma omp parallel for
-    for (int i = 0; i < int(parallelism); i++) {
-      DoSort(blocks[i].e, 0, blocks[i].sz - 1, reverse_ ? ReverseComp : StandardComp);
-    }
-
-    auto partind = parallelism;
-    for (auto wide = decltype(parallelism){1}; partind > 1; wide *= 2, partind /= 2) {
-#pragma omp parallel for if (blocks[wide].sz >= 40)
-      for (int k = 0; k < static_cast<int>(partind / 2); ++k) {
-        const auto idx = 2 * wide * k;
-        DoInplaceMerge(blocks.data() + idx, blocks.data() + idx + wide, reverse_ ? ReverseComp : StandardComp);
-      }
-      if ((partind / 2) == 1) {
-        DoInplaceMerge(&blocks.front(), &blocks.back(), reverse_ ? ReverseComp : StandardComp);
-      } else if ((partind / 2) % 2 != 0) {
-        DoInplaceMerge(blocks.data() + (2 * wide * ((partind / 2) - 2)),
-                       blocks.data() + (2 * wide * ((partind / 2) - 1)), reverse_ ? ReverseComp : StandardComp);
-      }
-    }
+    std::ranges::copy_n(input_.begin(), input_.size(), res_.begin());
+
+    // every element is moved once, to its bucket, and the buckets are sorted independently instead of merging
+    // per-thread blocks in rounds
+    const auto comp = reverse_ ? ReverseComp : StandardComp;
+    ppc::util::SampleSort(
+        std::span<T>(res_),
+        [](std::size_t count, const auto& body) {
+#pragma omp parallel for schedule(dynamic)
+          for (int i = 0; i < static_cast<int>(count); i++) {
+            body(static_cast<std::size_t>(i));
+          }
+        },
+        [comp](std::span<T> bucket) { DoSort(bucket.data(), 0, static_cast<int>(bucket.size()) - 1, comp); }, comp);
 
     return true;
   }
@@ -85,11 +59,6 @@ class HoareOpenMP : public ppc::core::Task {
   }
 
  private:
-  static void DoInplaceMerge(Block* b1, Block* b2, bool (*comp)(const T&, const T&)) {
-    std::inplace_merge(b1->e, b2->e, b2->e + b2->sz, comp);
-    b1->sz += b2->sz;
-  }
-
   static int Partition(T* block, int low, int high, bool (*comp)(const T&, const T&)) {
     int e = low - 1;
     for (int j = low; j <= high - 1; j++) {
@@ -1,6 +1,16 @@
 #include <gtest/gtest.h>
+#include <omp.h>
+
+#include "core/util/include/topology.hpp"
+#include "core/util/include/util.hpp"
 
 int main(int argc, char **argv) {
+  // Use the same thread count and placement as the other backends
+  omp_set_num_threads(ppc::util::GetPPCNumThreads());
+  ppc::util::AddNumThreadsObserver([](int num_threads) { omp_set_num_threads(num_threads); });
+#pragma omp parallel
+  ppc::util::PinWorkerThread(omp_get_thread_num());
+
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
 }
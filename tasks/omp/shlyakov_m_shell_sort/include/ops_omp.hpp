@@ -2,6 +2,7 @@
 
 #include <omp.h>
 
+#include <span>
 #include <utility>
 #include <vector>
 
@@ -9,7 +10,7 @@
 
 namespace shlyakov_m_shell_sort_omp {
 void Merge(int left, int mid, int right, std::vector<int>& arr, std::vector<int>& buffer);
-void ShellSort(int left, int right, std::vector<int>& arr);
+void ShellSort(std::span<int> arr);
 
 class TestTaskOpenMP : public ppc::core::Task {
  public:
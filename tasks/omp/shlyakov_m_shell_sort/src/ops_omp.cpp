@@ -2,10 +2,14 @@
 
 #include <omp.h>
 
-#include <cmath>
+#include <algorithm>
 #include <cstddef>
+#include <span>
 #include <vector>
 
+#include "core/task/include/registry.hpp"
+#include "core/util/include/natural_merge.hpp"
+
 bool shlyakov_m_shell_sort_omp::TestTaskOpenMP::PreProcessingImpl() {
   std::size_t input_size = task_data->inputs_count[0];
   auto* in_ptr = reinterpret_cast<int*>(task_data->inputs[0]);
@@ -35,7 +39,7 @@ bool shlyakov_m_shell_sort_omp::TestTaskOpenMP::RunImpl() {
       int right = (left + sub_arr_size - 1 < array_size - 1) ? (left + sub_arr_size - 1) : (array_size - 1);
 
       if (left < right) {
-        ShellSort(left, right, input_);
+        ppc::util::AdaptiveSort(std::span<int>(input_).subspan(left, right - left + 1), ShellSort);
       }
     }
 
@@ -58,8 +62,8 @@ bool shlyakov_m_shell_sort_omp::TestTaskOpenMP::RunImpl() {
 }
 
 namespace shlyakov_m_shell_sort_omp {
-void ShellSort(int left, int right, std::vector<int>& arr) {
-  int sub_array_size = right - left + 1;
+void ShellSort(std::span<int> arr) {
+  const int sub_array_size = static_cast<int>(arr.size());
   int gap = 1;
 
   for (; gap <= sub_array_size / 3;) {
@@ -67,11 +71,11 @@ void ShellSort(int left, int right, std::vector<int>& arr) {
   }
 
   for (; gap > 0; gap /= 3) {
-    for (int k = left + gap; k <= right; ++k) {
+    for (int k = gap; k < sub_array_size; ++k) {
       int current_element = arr[k];
       int j = k;
 
-      while (j >= left + gap && arr[j - gap] > current_element) {
+      while (j >= gap && arr[j - gap] > current_element) {
         arr[j] = arr[j - gap];
         j -= gap;
       }
@@ -81,6 +85,15 @@ void ShellSort(int left, int right, std::vector<int>& arr) {
 }
 
 void Merge(int left, int mid, int right, std::vector<int>& arr, std::vector<int>& buffer) {
+  // blocks of partially ordered input are often in order already, otherwise
+  // only their overlapping ends need merging
+  if (mid >= right || arr[mid] <= arr[mid + 1]) {
+    return;
+  }
+  const auto first = arr.begin();
+  left = static_cast<int>(std::upper_bound(first + left, first + mid + 1, arr[mid + 1]) - first);
+  right = static_cast<int>(std::lower_bound(first + mid + 1, first + right + 1, arr[mid]) - first) - 1;
+
   int i = left;
   int j = mid + 1;
   int k = 0;
@@ -112,4 +125,6 @@ bool shlyakov_m_shell_sort_omp::TestTaskOpenMP::PostProcessingImpl() {
   }
   return true;
 }
-// namespace shlyakov_m_shell_sort_omp
\ No newline at end of file
+// namespace shlyakov_m_shell_sort_omp
+
+PPC_REGISTER_SORT_TASK(shlyakov_m_shell_sort_omp::TestTaskOpenMP, "shlyakov_m_shell_sort", "omp", int);
@@ -5,41 +5,13 @@
 #include <algorithm>
 #include <cmath>
 #include <cstddef>
-#include <deque>
 #include <numeric>
+#include <span>
 #include <utility>
 #include <vector>
 
-std::vector<int> smirnov_i_radix_sort_simple_merge_omp::TestTaskOpenMP::Merge(std::vector<int> mas1,
-                                                                              std::vector<int> mas2) {
-  std::vector<int> res;
-  res.reserve(mas1.size() + mas2.size());
-  int p1 = 0;
-  int p2 = 0;
-  while (static_cast<int>(mas1.size()) != p1 && static_cast<int>(mas2.size()) != p2) {
-    if (mas1[p1] < mas2[p2]) {
-      res.push_back(mas1[p1]);
-      p1++;
-    } else if (mas2[p2] < mas1[p1]) {
-      res.push_back(mas2[p2]);
-      p2++;
-    } else {
-      res.push_back(mas1[p1]);
-      res.push_back(mas2[p2]);
-      p1++;
-      p2++;
-    }
-  }
-  while (static_cast<int>(mas1.size()) != p1) {
-    res.push_back(mas1[p1]);
-    p1++;
-  }
-  while (static_cast<int>(mas2.size()) != p2) {
-    res.push_back(mas2[p2]);
-    p2++;
-  }
-  return res;
-}
+#include "core/util/include/multiway_merge.hpp"
+
 void smirnov_i_radix_sort_simple_merge_omp::TestTaskOpenMP::RadixSort(std::vector<int>& mas) {
   if (mas.empty()) {
     return;
@@ -75,66 +47,24 @@ bool smirnov_i_radix_sort_simple_merge_omp::TestTaskOpenMP::ValidationImpl() {
   return task_data->inputs_count[0] == task_data->outputs_count[0];
 }
 bool smirnov_i_radix_sort_simple_merge_omp::TestTaskOpenMP::RunImpl() {
-  std::deque<std::vector<int>> firstdq;
-  std::deque<std::vector<int>> seconddq;
-  bool flag = false;
-#pragma omp parallel shared(flag)
+  const int max_th = std::max(1, std::min(omp_get_max_threads(), static_cast<int>(mas_.size())));
+  std::vector<std::vector<int>> runs(max_th);
+#pragma omp parallel num_threads(max_th)
   {
     int num = omp_get_thread_num();
     int all = omp_get_num_threads();
-    std::vector<int> local_mas;
     int start = static_cast<int>(num * mas_.size() / all);
     int end = static_cast<int>(std::min((num + 1) * mas_.size() / all, mas_.size()));
-    for (int i = start; i < end; i++) {
-      local_mas.push_back(mas_[i]);
-    }
+    std::vector<int> local_mas(mas_.begin() + start, mas_.begin() + end);
     RadixSort(local_mas);
-#pragma omp critical
-    {
-      if (!local_mas.empty()) {
-        firstdq.push_back(local_mas);
-      }
-    }
-#pragma omp barrier
-#pragma omp single
-    { flag = static_cast<int>(firstdq.size()) != 1; }
-#pragma omp barrier
-    while (flag) {
-      std::vector<int> mas1{};
-      std::vector<int> mas2{};
-      std::vector<int> merge_mas{};
-#pragma omp critical
-      {
-        if (static_cast<int>(firstdq.size()) >= 2) {
-          mas1 = std::move(firstdq.front());
-          firstdq.pop_front();
-          mas2 = std::move(firstdq.front());
-          firstdq.pop_front();
-        }
-      }
-      if (!mas1.empty() && !mas2.empty()) {
-        merge_mas = Merge(mas1, mas2);
-      }
+    runs[num] = std::move(local_mas);
+  }
 
-      if (!merge_mas.empty()) {
-#pragma omp critical
-        seconddq.push_back(merge_mas);
-      }
-#pragma omp barrier
-#pragma omp single
-      {
-        if (static_cast<int>(firstdq.size()) == 1) {
-          seconddq.push_back(std::move(firstdq.front()));
-          firstdq.pop_front();
-        }
-        std::swap(firstdq, seconddq);
-        flag = static_cast<int>(firstdq.size()) != 1;
-      }
-#pragma omp barrier
-    }
-#pragma omp barrier
-#pragma omp single
-    { output_ = std::move(firstdq.front()); }
+  // All runs are merged in one pass, every thread writes an equal part of the output
+  const std::vector<std::span<const int>> sorted_runs(runs.begin(), runs.end());
+#pragma omp parallel for num_threads(max_th)
+  for (int part = 0; part < max_th; part++) {
+    ppc::util::MultiwayMergePart(sorted_runs, output_.data(), part, max_th);
   }
   return true;
 }
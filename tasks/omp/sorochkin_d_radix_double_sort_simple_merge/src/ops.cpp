@@ -12,6 +12,7 @@
 #include <span>
 #include <vector>
 
+#include "core/task/include/registry.hpp"
 #include "core/util/include/util.hpp"
 
 namespace {
@@ -127,3 +128,6 @@ bool sorochkin_d_radix_double_sort_simple_merge_omp::SortTask::PostProcessingImp
   std::ranges::copy(output_, reinterpret_cast<double *>(task_data->outputs[0]));
   return true;
 }
+
+PPC_REGISTER_SORT_TASK(sorochkin_d_radix_double_sort_simple_merge_omp::SortTask,
+                       "sorochkin_d_radix_double_sort_simple_merge", "omp", double);
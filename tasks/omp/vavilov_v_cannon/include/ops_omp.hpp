@@ -24,9 +24,5 @@ class CannonOMP : public ppc::core::Task {
   std::vector<double> A_;
   std::vector<double> B_;
   std::vector<double> C_;
-
-  void InitialShift();
-  void BlockMultiply();
-  void ShiftBlocks();
 };
 }  // namespace vavilov_v_cannon_omp
@@ -0,0 +1,200 @@
+#include <omp.h>
+#include <tbb/global_control.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include "core/perf/include/perf.hpp"
+#include "core/perf/include/report.hpp"
+#include "core/task/include/registry.hpp"
+#include "core/util/include/topology.hpp"
+#include "core/util/include/topology_tbb.hpp"
+#include "core/util/include/util.hpp"
+#include "oneapi/tbb/global_control.h"
+
+namespace {
+
+struct Options {
+  std::string task;
+  std::string backend = "seq";
+  uint64_t size = 1000000;
+  std::string input;
+  int threads = 0;
+  std::string placement;
+  uint64_t repeat = 5;
+  uint64_t warmup = 1;
+  bool pipeline = false;
+  bool counters = false;
+  std::string output;
+  bool list = false;
+};
+
+void PrintUsage() {
+  std::cout << "usage: ppc_run --list\n"
+               "       ppc_run <task> [options]\n"
+               "options:\n"
+               "  --backend NAME     seq, omp, tbb or stl (default seq)\n"
+               "  --size N           generate input of about N elements (default 1000000)\n"
+               "  --input FILE       load input from FILE instead of generating it\n"
+               "  --threads N        thread count (default PPC_NUM_THREADS, OMP_NUM_THREADS or physical cores)\n"
+               "  --placement NAME   pin threads: compact, scatter or numa\n"
+               "  --repeat N         timed runs (default 5)\n"
+               "  --warmup N         untimed runs before measurement (default 1)\n"
+               "  --mode MODE        task_run (Run() only, default) or pipeline\n"
+               "  --counters         read hardware counters around Run()\n"
+               "  --output FILE      append the result to FILE (.jsonl or .csv)\n";
+}
+
+bool ParseOptions(int argc, char** argv, Options& options) {
+  for (int i = 1; i < argc; i++) {
+    const std::string arg = argv[i];
+    auto value = [&]() -> std::string {
+      if (i + 1 >= argc) {
+        throw std::invalid_argument("missing value of " + arg);
+      }
+      return argv[++i];
+    };
+    if (arg == "--list") {
+      options.list = true;
+    } else if (arg == "--backend") {
+      options.backend = value();
+    } else if (arg == "--size") {
+      options.size = std::stoull(value());
+    } else if (arg == "--input") {
+      options.input = value();
+    } else if (arg == "--threads") {
+      options.threads = std::stoi(value());
+    } else if (arg == "--placement") {
+      options.placement = value();
+    } else if (arg == "--repeat") {
+      options.repeat = std::stoull(value());
+    } else if (arg == "--warmup") {
+      options.warmup = std::stoull(value());
+    } else if (arg == "--mode") {
+      const std::string mode = value();
+      if (mode != "task_run" && mode != "pipeline") {
+        throw std::invalid_argument("unknown mode " + mode);
+      }
+      options.pipeline = mode == "pipeline";
+    } else if (arg == "--counters") {
+      options.counters = true;
+    } else if (arg == "--output") {
+      options.output = value();
+    } else if (arg == "--help" || arg == "-h") {
+      return false;
+    } else if (!arg.starts_with("--") && options.task.empty()) {
+      options.task = arg;
+    } else {
+      throw std::invalid_argument("unknown argument " + arg);
+    }
+  }
+  return options.list || !options.task.empty();
+}
+
+int Run(const Options& options) {
+  const auto& registry = ppc::core::TaskRegistry::Instance();
+  if (options.list) {
+    for (const auto* registration : registry.List()) {
+      std::cout << registration->name << " " << registration->backend << (registration->load ? " (loads files)" : "")
+                << '\n';
+    }
+    return 0;
+  }
+  const auto* registration = registry.Find(options.task, options.backend);
+  if (registration == nullptr) {
+    std::cerr << "ppc_run: task " << options.task << " (" << options.backend << ") is not registered\n";
+    return 2;
+  }
+  if (!options.input.empty() && !registration->load) {
+    std::cerr << "ppc_run: task " << options.task << " (" << options.backend << ") cannot load input files\n";
+    return 2;
+  }
+
+  auto input = options.input.empty() ? registration->generate(options.size) : registration->load(options.input);
+  auto task = registration->make_task(input.task_data);
+
+  auto perf_attr = std::make_shared<ppc::core::PerfAttr>();
+  perf_attr->num_running = options.repeat;
+  perf_attr->num_warmup = options.warmup;
+  perf_attr->measurement_mode = ppc::core::PerfAttr::MeasurementMode::kPerIteration;
+  perf_attr->enable_hw_counters = options.counters;
+  const auto t0 = std::chrono::high_resolution_clock::now();
+  perf_attr->current_timer = [&] {
+    auto current_time_point = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(current_time_point - t0).count();
+    return static_cast<double>(duration) * 1e-9;
+  };
+
+  auto perf_results = std::make_shared<ppc::core::PerfResults>();
+  ppc::core::Perf perf_analyzer(task);
+  if (options.pipeline) {
+    perf_analyzer.PipelineRun(perf_attr, perf_results);
+  } else {
+    perf_analyzer.TaskRun(perf_attr, perf_results);
+  }
+  const bool passed = !input.check || input.check();
+
+  const auto& stats = perf_results->statistics;
+  std::cout << options.task << " (" << options.backend << "): " << perf_results->num_elements << " elements, "
+            << perf_results->num_threads << " threads, " << stats.num_samples << " runs\n"
+            << std::scientific << std::setprecision(4) << "  median " << stats.median << " s, mean " << stats.mean
+            << " s +- " << (stats.ci_high - stats.mean) << " s, min " << stats.min << " s, max " << stats.max << " s\n";
+  if (perf_results->counters.available) {
+    const auto& counters = perf_results->counters;
+    std::cout << std::defaultfloat << "  ipc " << counters.ipc << ", llc misses " << counters.llc_misses
+              << ", branch misses " << counters.branch_misses << '\n';
+  }
+  std::cout << "  output check: " << (input.check ? (passed ? "passed" : "FAILED") : "none") << '\n';
+
+  if (!options.output.empty()) {
+    ppc::core::AppendPerfRecord(options.output, ppc::core::MakePerfRecord(
+                                                    "tasks/" + options.backend + "/" + options.task, *perf_results));
+  }
+  return passed ? 0 : 1;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  Options options;
+  try {
+    if (!ParseOptions(argc, argv, options)) {
+      PrintUsage();
+      return 2;
+    }
+  } catch (const std::exception& e) {
+    std::cerr << "ppc_run: " << e.what() << '\n';
+    PrintUsage();
+    return 2;
+  }
+
+  // Placement and thread count are read by every backend from the environment
+  if (!options.placement.empty()) {
+#ifdef _WIN32
+    _putenv_s("PPC_PLACEMENT", options.placement.c_str());
+#else
+    setenv("PPC_PLACEMENT", options.placement.c_str(), 1);  // NOLINT(misc-include-cleaner)
+#endif
+  }
+  if (options.threads > 0) {
+    ppc::util::SetPPCNumThreads(options.threads);
+  }
+  tbb::global_control control(tbb::global_control::max_allowed_parallelism, ppc::util::GetPPCNumThreads());
+  ppc::util::PinningObserver observer;
+  omp_set_num_threads(ppc::util::GetPPCNumThreads());
+#pragma omp parallel
+  ppc::util::PinWorkerThread(omp_get_thread_num());
+
+  try {
+    return Run(options);
+  } catch (const std::exception& e) {
+    std::cerr << "ppc_run: " << e.what() << '\n';
+    return 1;
+  }
+}
@@ -5,6 +5,8 @@
 #include <utility>
 #include <vector>
 
+#include "core/task/include/registry.hpp"
+
 std::array<int, 256> burykin_m_radix_seq::RadixSequential::ComputeFrequency(const std::vector<int>& a,
                                                                             const int shift) {
   std::array<int, 256> count = {};
@@ -75,3 +77,5 @@ bool burykin_m_radix_seq::RadixSequential::PostProcessingImpl() {
   }
   return true;
 }
+
+PPC_REGISTER_SORT_TASK(burykin_m_radix_seq::RadixSequential, "burykin_m_radix", "seq", int);
@@ -4,6 +4,8 @@
 #include <cstddef>
 #include <vector>
 
+#include "core/task/include/registry.hpp"
+
 bool nesterov_a_test_task_seq::TestTaskSequential::PreProcessingImpl() {
   // Init value for input and output
   unsigned int input_size = task_data->inputs_count[0];
@@ -40,3 +42,5 @@ bool nesterov_a_test_task_seq::TestTaskSequential::PostProcessingImpl() {
   }
   return true;
 }
+
+PPC_REGISTER_TASK(nesterov_a_test_task_seq::TestTaskSequential, "example", "seq", ppc::core::MakeIdentitySquareInput);
@@ -7,6 +7,8 @@
 #include <cstring>
 #include <vector>
 
+#include "core/task/include/registry.hpp"
+
 void kudryashova_i_radix_batcher_seq::RadixDoubleSort(std::vector<double> &data, int first, int last) {
   const int sort_size = last - first;
   std::vector<uint64_t> converted(sort_size);
@@ -76,3 +78,6 @@ bool kudryashova_i_radix_batcher_seq::TestTaskSequential::PostProcessingImpl() {
   std::ranges::copy(input_data_, reinterpret_cast<double *>(task_data->outputs[0]));
   return true;
 }
+
+PPC_REGISTER_SORT_TASK(kudryashova_i_radix_batcher_seq::TestTaskSequential, "kudryashova_i_radix_batcher", "seq",
+                       double);
@@ -5,6 +5,8 @@
 #include <random>
 #include <vector>
 
+#include "core/task/include/registry.hpp"
+
 bool nikolaev_r_hoare_sort_simple_merge_seq::HoareSortSimpleMergeSequential::PreProcessingImpl() {
   vect_size_ = task_data->inputs_count[0];
   auto *vect_ptr = reinterpret_cast<double *>(task_data->inputs[0]);
@@ -61,4 +63,7 @@ void nikolaev_r_hoare_sort_simple_merge_seq::HoareSortSimpleMergeSequential::Qui
     QuickSort(low, pivot - 1);
   }
   QuickSort(pivot + 1, high);
-}
\ No newline at end of file
+}
+
+PPC_REGISTER_SORT_TASK(nikolaev_r_hoare_sort_simple_merge_seq::HoareSortSimpleMergeSequential,
+                       "nikolaev_r_hoare_sort_simple_merge", "seq", double);
@@ -7,6 +7,8 @@
 #include <ranges>
 #include <vector>
 
+#include "core/task/include/registry.hpp"
+
 namespace {
 auto Translate(double e, size_t i) {
   const uint64_t mask = 1ULL << ((sizeof(uint64_t) * 8) - 1);
@@ -60,3 +62,6 @@ bool petrov_a_radix_double_batcher_seq::TestTaskSequential::PostProcessingImpl()
   std::ranges::copy(res_, reinterpret_cast<double *>(task_data->outputs[0]));
   return true;
 }
+
+PPC_REGISTER_SORT_TASK(petrov_a_radix_double_batcher_seq::TestTaskSequential, "petrov_a_radix_double_batcher", "seq",
+                       double);
@@ -2,24 +2,16 @@
 
 #include <cmath>
 #include <cstddef>
+#include <span>
 #include <vector>
 
-bool shlyakov_m_shell_sort_seq::TestTaskSequential::PreProcessingImpl() {
-  std::size_t input_size = task_data->inputs_count[0];
-  auto* in_ptr = reinterpret_cast<int*>(task_data->inputs[0]);
-  input_ = std::vector<int>(in_ptr, in_ptr + input_size);
+#include "core/task/include/registry.hpp"
+#include "core/util/include/natural_merge.hpp"
 
-  output_ = input_;
+namespace {
 
-  return true;
-}
-
-bool shlyakov_m_shell_sort_seq::TestTaskSequential::ValidationImpl() {
-  return task_data->inputs_count[0] == task_data->outputs_count[0];
-}
-
-bool shlyakov_m_shell_sort_seq::TestTaskSequential::RunImpl() {
-  int n = static_cast<int>(input_.size());
+void ShellSort(std::span<int> arr) {
+  const int n = static_cast<int>(arr.size());
 
   std::vector<int> gaps;
   for (int i = 1; i <= static_cast<int>(std::sqrt(n)) + 1; ++i) {
@@ -33,16 +25,36 @@ bool shlyakov_m_shell_sort_seq::TestTaskSequential::RunImpl() {
     int gap = gaps[k];
     for (int start = 0; start < gap; ++start) {
       for (int i = start + gap; i < n; i += gap) {
-        int key = output_[i];
+        int key = arr[i];
         int j = i - gap;
-        while (j >= start && output_[j] > key) {
-          output_[j + gap] = output_[j];
+        while (j >= start && arr[j] > key) {
+          arr[j + gap] = arr[j];
           j -= gap;
         }
-        output_[j + gap] = key;
+        arr[j + gap] = key;
       }
     }
   }
+}
+
+}  // namespace
+
+bool shlyakov_m_shell_sort_seq::TestTaskSequential::PreProcessingImpl() {
+  std::size_t input_size = task_data->inputs_count[0];
+  auto* in_ptr = reinterpret_cast<int*>(task_data->inputs[0]);
+  input_ = std::vector<int>(in_ptr, in_ptr + input_size);
+
+  output_ = input_;
+
+  return true;
+}
+
+bool shlyakov_m_shell_sort_seq::TestTaskSequential::ValidationImpl() {
+  return task_data->inputs_count[0] == task_data->outputs_count[0];
+}
+
+bool shlyakov_m_shell_sort_seq::TestTaskSequential::RunImpl() {
+  ppc::util::AdaptiveSort(std::span<int>(output_), ShellSort);
   return true;
 }
 
@@ -51,4 +63,6 @@ bool shlyakov_m_shell_sort_seq::TestTaskSequential::PostProcessingImpl() {
     reinterpret_cast<int*>(task_data->outputs[0])[i] = output_[i];
   }
   return true;
-}
\ No newline at end of file
+}
+
+PPC_REGISTER_SORT_TASK(shlyakov_m_shell_sort_seq::TestTaskSequential, "shlyakov_m_shell_sort", "seq", int);
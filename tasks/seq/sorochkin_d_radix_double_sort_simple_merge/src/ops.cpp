@@ -11,6 +11,8 @@
 #include <span>
 #include <vector>
 
+#include "core/task/include/registry.hpp"
+
 namespace {
 template <typename T>
 constexpr size_t Bytes() {
@@ -80,3 +82,6 @@ bool sorochkin_d_radix_double_sort_simple_merge_seq::SortTask::PostProcessingImp
   std::ranges::copy(output_, reinterpret_cast<double *>(task_data->outputs[0]));
   return true;
 }
+
+PPC_REGISTER_SORT_TASK(sorochkin_d_radix_double_sort_simple_merge_seq::SortTask,
+                       "sorochkin_d_radix_double_sort_simple_merge", "seq", double);
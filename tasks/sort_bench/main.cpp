@@ -0,0 +1,251 @@
+#include <omp.h>
+#include <tbb/global_control.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "core/perf/include/perf.hpp"
+#include "core/task/include/registry.hpp"
+#include "core/util/include/sort_inputs.hpp"
+#include "core/util/include/util.hpp"
+
+namespace {
+
+struct Options {
+  std::vector<std::string> tasks;
+  std::vector<std::string> backends = {"seq", "omp", "tbb", "stl"};
+  std::vector<ppc::util::SortDistribution> distributions;
+  std::vector<uint64_t> sizes = {uint64_t{1} << 10, uint64_t{1} << 16, uint64_t{1} << 20};
+  int threads = 0;
+  uint64_t repeat = 5;
+  uint64_t warmup = 1;
+  std::string output;
+};
+
+void PrintUsage() {
+  std::cout << "usage: ppc_sort_bench [options]\n"
+               "runs every registered sorting task on every input distribution and size\n"
+               "options:\n"
+               "  --tasks A,B,...          task names (default every sorting task)\n"
+               "  --backends A,B,...       seq, omp, tbb, stl (default all)\n"
+               "  --distributions A,B,...  uniform, sorted, reverse, nearly_sorted, few_unique, zipf,\n"
+               "                           all_equal, organ_pipe, special, huge_range, nan_heavy (default all)\n"
+               "  --sizes N,N,...          element counts with optional K, M or G suffix (powers of 1024),\n"
+               "                           default 1K,64K,1M\n"
+               "  --threads N              thread count (default PPC_NUM_THREADS, OMP_NUM_THREADS or physical cores)\n"
+               "  --repeat N               timed runs per point (default 5)\n"
+               "  --warmup N               untimed runs per point (default 1)\n"
+               "  --output FILE            append the points to FILE as csv\n";
+}
+
+std::vector<std::string> SplitList(const std::string& list) {
+  std::vector<std::string> items;
+  std::stringstream stream(list);
+  std::string item;
+  while (std::getline(stream, item, ',')) {
+    if (!item.empty()) {
+      items.push_back(item);
+    }
+  }
+  return items;
+}
+
+uint64_t ParseSize(const std::string& text) {
+  size_t end = 0;
+  const uint64_t value = std::stoull(text, &end);
+  const std::string suffix = text.substr(end);
+  if (suffix.empty()) {
+    return value;
+  }
+  if (suffix == "K" || suffix == "k") {
+    return value << 10;
+  }
+  if (suffix == "M" || suffix == "m") {
+    return value << 20;
+  }
+  if (suffix == "G" || suffix == "g") {
+    return value << 30;
+  }
+  throw std::invalid_argument("bad size " + text);
+}
+
+bool ParseOptions(int argc, char** argv, Options& options) {
+  for (int i = 1; i < argc; i++) {
+    const std::string arg = argv[i];
+    auto value = [&]() -> std::string {
+      if (i + 1 >= argc) {
+        throw std::invalid_argument("missing value of " + arg);
+      }
+      return argv[++i];
+    };
+    if (arg == "--tasks") {
+      options.tasks = SplitList(value());
+    } else if (arg == "--backends") {
+      options.backends = SplitList(value());
+    } else if (arg == "--distributions") {
+      options.distributions.clear();
+      for (const auto& name : SplitList(value())) {
+        options.distributions.push_back(ppc::util::ParseSortDistribution(name));
+      }
+    } else if (arg == "--sizes") {
+      options.sizes.clear();
+      for (const auto& size : SplitList(value())) {
+        options.sizes.push_back(ParseSize(size));
+      }
+    } else if (arg == "--threads") {
+      options.threads = std::stoi(value());
+    } else if (arg == "--repeat") {
+      options.repeat = std::stoull(value());
+    } else if (arg == "--warmup") {
+      options.warmup = std::stoull(value());
+    } else if (arg == "--output") {
+      options.output = value();
+    } else if (arg == "--help" || arg == "-h") {
+      return false;
+    } else {
+      throw std::invalid_argument("unknown argument " + arg);
+    }
+  }
+  if (options.distributions.empty()) {
+    const auto all = ppc::util::GetSortDistributions();
+    options.distributions.assign(all.begin(), all.end());
+  }
+  return true;
+}
+
+struct Point {
+  std::string task;
+  std::string backend;
+  ppc::util::SortDistribution distribution;
+  uint64_t size;
+  int threads;
+  // median of the whole pipeline and mean of Run() alone, per element
+  double ns_per_element;
+  double run_ns_per_element;
+  bool passed;
+};
+
+// Whole pipeline per run: several tasks sort their working copy in place, so
+// repeated Run() calls after one PreProcessing would sort sorted data
+Point Measure(const ppc::core::TaskRegistration& registration, ppc::util::SortDistribution distribution,
+              uint64_t size, const Options& options) {
+  auto input = registration.generate_sort(distribution, size);
+  auto task = registration.make_task(input.task_data);
+
+  auto perf_attr = std::make_shared<ppc::core::PerfAttr>();
+  perf_attr->num_running = options.repeat;
+  perf_attr->num_warmup = options.warmup;
+  perf_attr->measurement_mode = ppc::core::PerfAttr::MeasurementMode::kPerIteration;
+  const auto t0 = std::chrono::high_resolution_clock::now();
+  perf_attr->current_timer = [&] {
+    auto current_time_point = std::chrono::high_resolution_clock::now();
+    auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(current_time_point - t0).count();
+    return static_cast<double>(duration) * 1e-9;
+  };
+
+  auto perf_results = std::make_shared<ppc::core::PerfResults>();
+  ppc::core::Perf perf_analyzer(task);
+  perf_analyzer.PipelineRun(perf_attr, perf_results);
+
+  const auto elements = static_cast<double>(size == 0 ? 1 : size);
+  const auto runs = static_cast<double>(options.warmup + perf_results->num_runs);
+  return {.task = registration.name,
+          .backend = registration.backend,
+          .distribution = distribution,
+          .size = size,
+          .threads = perf_results->num_threads,
+          .ns_per_element = perf_results->statistics.median * 1e9 / elements,
+          .run_ns_per_element = perf_results->phases.run * 1e9 / runs / elements,
+          .passed = input.check()};
+}
+
+void AppendCsv(const std::string& path, const Point& point) {
+  const bool header = !std::filesystem::exists(path) || std::filesystem::file_size(path) == 0;
+  std::ofstream file(path, std::ios::app);
+  if (!file.is_open()) {
+    throw std::runtime_error("Failed to open output file: " + path);
+  }
+  if (header) {
+    file << "task,backend,distribution,size,threads,ns_per_element,run_ns_per_element,check\n";
+  }
+  file << point.task << ',' << point.backend << ',' << ppc::util::GetSortDistributionName(point.distribution) << ','
+       << point.size << ',' << point.threads << ',' << point.ns_per_element << ',' << point.run_ns_per_element << ','
+       << (point.passed ? "passed" : "failed") << '\n';
+}
+
+int Run(const Options& options) {
+  std::vector<const ppc::core::TaskRegistration*> registrations;
+  for (const auto* registration : ppc::core::TaskRegistry::Instance().List()) {
+    const bool task_selected =
+        options.tasks.empty() || std::ranges::find(options.tasks, registration->name) != options.tasks.end();
+    if (registration->generate_sort && task_selected &&
+        std::ranges::find(options.backends, registration->backend) != options.backends.end()) {
+      registrations.push_back(registration);
+    }
+  }
+  if (registrations.empty()) {
+    std::cerr << "ppc_sort_bench: no registered sorting task matches\n";
+    return 2;
+  }
+
+  std::cout << std::left << std::setw(44) << "task" << std::setw(8) << "backend" << std::setw(15) << "distribution"
+            << std::right << std::setw(12) << "size" << std::setw(12) << "ns/elem" << std::setw(12) << "run ns/elem"
+            << "  check\n";
+  bool all_passed = true;
+  for (const auto size : options.sizes) {
+    for (const auto distribution : options.distributions) {
+      for (const auto* registration : registrations) {
+        const auto point = Measure(*registration, distribution, size, options);
+        all_passed = all_passed && point.passed;
+        std::cout << std::left << std::setw(44) << point.task << std::setw(8) << point.backend << std::setw(15)
+                  << ppc::util::GetSortDistributionName(distribution) << std::right << std::setw(12) << size
+                  << std::fixed << std::setprecision(3) << std::setw(12) << point.ns_per_element << std::setw(12)
+                  << point.run_ns_per_element << "  " << (point.passed ? "passed" : "FAILED") << '\n' << std::flush;
+        if (!options.output.empty()) {
+          AppendCsv(options.output, point);
+        }
+      }
+    }
+  }
+  return all_passed ? 0 : 1;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  Options options;
+  try {
+    if (!ParseOptions(argc, argv, options)) {
+      PrintUsage();
+      return 2;
+    }
+  } catch (const std::exception& e) {
+    std::cerr << "ppc_sort_bench: " << e.what() << '\n';
+    PrintUsage();
+    return 2;
+  }
+
+  if (options.threads > 0) {
+    ppc::util::SetPPCNumThreads(options.threads);
+  }
+  tbb::global_control control(tbb::global_control::max_allowed_parallelism, ppc::util::GetPPCNumThreads());
+  omp_set_num_threads(ppc::util::GetPPCNumThreads());
+
+  try {
+    return Run(options);
+  } catch (const std::exception& e) {
+    std::cerr << "ppc_sort_bench: " << e.what() << '\n';
+    return 1;
+  }
+}
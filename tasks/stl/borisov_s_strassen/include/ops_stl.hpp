@@ -1,15 +1,19 @@
 #pragma once
 
+#include <cstddef>
 #include <utility>
 #include <vector>
 
 #include "core/task/include/task.hpp"
+#include "core/util/include/strassen.hpp"
 
 namespace borisov_s_strassen_stl {
 
 class ParallelStrassenStl : public ppc::core::Task {
  public:
-  explicit ParallelStrassenStl(ppc::core::TaskDataPtr task_data) : Task(std::move(task_data)) {}
+  // products with a dimension of at most crossover are left to Gemm
+  explicit ParallelStrassenStl(ppc::core::TaskDataPtr task_data, size_t crossover = ppc::util::kStrassenCrossover)
+      : Task(std::move(task_data)), crossover_(crossover) {}
 
   bool PreProcessingImpl() override;
   bool ValidationImpl() override;
@@ -25,6 +29,8 @@ class ParallelStrassenStl : public ppc::core::Task {
   int colsA_ = 0;
   int rowsB_ = 0;
   int colsB_ = 0;
+
+  size_t crossover_;
 };
 
 }  // namespace borisov_s_strassen_stl
\ No newline at end of file
@@ -7,6 +7,7 @@
 #include <utility>
 #include <vector>
 
+#include "core/task/include/registry.hpp"
 #include "core/util/include/util.hpp"
 
 std::array<int, 256> burykin_m_radix_stl::RadixSTL::ComputeFrequency(const std::vector<int>& a, const int shift) {
@@ -205,4 +206,6 @@ bool burykin_m_radix_stl::RadixSTL::PostProcessingImpl() {
     reinterpret_cast<int*>(task_data->outputs[0])[i] = output_[i];
   }
   return true;
-}
\ No newline at end of file
+}
+
+PPC_REGISTER_SORT_TASK(burykin_m_radix_stl::RadixSTL, "burykin_m_radix", "stl", int);
@@ -3,9 +3,11 @@
 #include <algorithm>
 #include <cstddef>
 #include <functional>
+#include <span>
 #include <thread>
 #include <vector>
 
+#include "core/util/include/sorting_network.hpp"
 #include "core/util/include/util.hpp"
 
 namespace {
@@ -51,33 +53,10 @@ void ShellSort(std::vector<int> &data, size_t start, size_t end) {
 }
 
 void BatcherMerge(std::vector<int> &data, size_t start, size_t mid, size_t end) {
-  std::vector<int> left(data.begin() + static_cast<std::ptrdiff_t>(start),
-                        data.begin() + static_cast<std::ptrdiff_t>(mid));
-
-  std::vector<int> right(data.begin() + static_cast<std::ptrdiff_t>(mid),
-                         data.begin() + static_cast<std::ptrdiff_t>(end));
-  size_t left_index = 0;
-  size_t right_index = 0;
-  size_t data_offset = start;
-
-  size_t left_size = mid - start;
-  size_t right_size = end - mid;
-
-  for (size_t i = start; i < end; ++i) {
-    if (i % 2 == 0) {
-      if (left_index < left_size && (right_index >= right_size || left[left_index] <= right[right_index])) {
-        data[data_offset++] = left[left_index++];
-      } else {
-        data[data_offset++] = right[right_index++];
-      }
-    } else {
-      if (right_index < right_size && (left_index >= left_size || right[right_index] <= left[left_index])) {
-        data[data_offset++] = right[right_index++];
-      } else {
-        data[data_offset++] = left[left_index++];
-      }
-    }
-  }
+  // Branch-free network merge, only the left run is copied away
+  const std::vector<int> left(data.begin() + static_cast<std::ptrdiff_t>(start),
+                              data.begin() + static_cast<std::ptrdiff_t>(mid));
+  ppc::util::NetworkMerge(left, std::span<const int>(data).subspan(mid, end - mid), data.data() + start);
 }
 
 void ParallelShellSortWithBatcherMerge(std::vector<int> &data) {
@@ -5,6 +5,7 @@
 #include <thread>
 #include <vector>
 
+#include "core/task/include/registry.hpp"
 #include "core/util/include/util.hpp"
 
 namespace {
@@ -54,3 +55,5 @@ bool nesterov_a_test_task_stl::TestTaskSTL::PostProcessingImpl() {
   }
   return true;
 }
+
+PPC_REGISTER_TASK(nesterov_a_test_task_stl::TestTaskSTL, "example", "stl", ppc::core::MakeIdentitySquareInput);
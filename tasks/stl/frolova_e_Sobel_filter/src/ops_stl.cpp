@@ -3,10 +3,9 @@
 #include <algorithm>
 #include <cmath>
 #include <cstddef>
-#include <thread>
 #include <vector>
 
-#include "core/util/include/util.hpp"
+#include "core/util/include/thread_pool.hpp"
 
 std::vector<int> frolova_e_sobel_filter_stl::ToGrayScaleImg(std::vector<frolova_e_sobel_filter_stl::RGB>& color_img,
                                                             size_t width, size_t height) {
@@ -81,9 +80,6 @@ bool frolova_e_sobel_filter_stl::SobelFilterSTL::ValidationImpl() {
 }
 
 bool frolova_e_sobel_filter_stl::SobelFilterSTL::RunImpl() {
-  int num_threads = ppc::util::GetPPCNumThreads();
-  std::vector<std::thread> threads;
-
   auto sobel_task = [&](size_t y_start, size_t y_end) {
     for (size_t y = y_start; y < y_end; ++y) {
       for (size_t x = 0; x < width_; ++x) {
@@ -110,18 +106,7 @@ bool frolova_e_sobel_filter_stl::SobelFilterSTL::RunImpl() {
     }
   };
 
-  size_t actual_threads_sobel = std::min(static_cast<size_t>(num_threads), height_);
-  size_t rows_per_thread = (height_ + actual_threads_sobel - 1) / actual_threads_sobel;
-
-  for (size_t i = 0; i < actual_threads_sobel; ++i) {
-    size_t y_start = i * rows_per_thread;
-    size_t y_end = std::min(y_start + rows_per_thread, height_);
-    threads.emplace_back(sobel_task, y_start, y_end);
-  }
-
-  for (auto& thread : threads) {
-    thread.join();
-  }
+  ppc::util::ParallelForRange(0, height_, sobel_task);
 
   return true;
 }
@@ -8,6 +8,8 @@
 #include <thread>
 #include <vector>
 
+#include "core/util/include/sorting_network.hpp"
+
 namespace fyodorov_m_shell_sort_with_even_odd_batcher_merge_stl {
 
 bool TestTaskSTL::PreProcessingImpl() {
@@ -106,25 +108,8 @@ void TestTaskSTL::ShellSort() {
 }
 
 void TestTaskSTL::BatcherMerge(std::vector<int>& left, std::vector<int>& right, std::vector<int>& result) {
-  size_t i = 0;
-  size_t j = 0;
-  size_t k = 0;
-
-  while (i < left.size() && j < right.size()) {
-    if (left[i] <= right[j]) {
-      result[k++] = left[i++];
-    } else {
-      result[k++] = right[j++];
-    }
-  }
-
-  while (i < left.size()) {
-    result[k++] = left[i++];
-  }
-
-  while (j < right.size()) {
-    result[k++] = right[j++];
-  }
+  // Branch-free network merge instead of a compare-and-branch loop
+  ppc::util::NetworkMerge(left, right, result.data());
 }
 
 }  // namespace fyodorov_m_shell_sort_with_even_odd_batcher_merge_stl
\ No newline at end of file
@@ -1,28 +1,12 @@
 #include "stl/gromov_a_fox_algorithm/include/ops_stl.hpp"
 
-#include <algorithm>
 #include <cmath>
 #include <cstddef>
-#include <thread>
+#include <functional>
 #include <vector>
 
-#include "core/util/include/util.hpp"
-
-namespace {
-void FoxBlockMul(const std::vector<double>& a, const std::vector<double>& b, std::vector<double>& c, int n,
-                 int block_size, int stage, int i, int j) {
-  int start_k = stage * block_size;
-  int end_k = std::min((stage + 1) * block_size, n);
-
-  for (int bk = start_k; bk < end_k; ++bk) {
-    for (int bi = i; bi < i + block_size && bi < n; ++bi) {
-      for (int bj = j; bj < j + block_size && bj < n; ++bj) {
-        c[(bi * n) + bj] += a[(bi * n) + bk] * b[(bk * n) + bj];
-      }
-    }
-  }
-}
-}  // namespace
+#include "core/util/include/gemm.hpp"
+#include "core/util/include/thread_pool.hpp"
 
 bool gromov_a_fox_algorithm_stl::TestTaskSTL::PreProcessingImpl() {
   unsigned int input_size = task_data->inputs_count[0];
@@ -73,35 +57,16 @@ bool gromov_a_fox_algorithm_stl::TestTaskSTL::ValidationImpl() {
 }
 
 bool gromov_a_fox_algorithm_stl::TestTaskSTL::RunImpl() {
-  int num_blocks = (n_ + block_size_ - 1) / block_size_;
-  const int num_threads = std::min(ppc::util::GetPPCNumThreads(), 8);
-  std::vector<std::thread> threads;
-
-  int num_block_rows = num_blocks;
-  int num_block_cols = num_blocks;
-  int total_tasks = num_block_rows * num_block_cols;
-
+  // the block products of a stage are independent, the stages add up
+  const int num_blocks = (n_ + block_size_ - 1) / block_size_;
+  const auto parallel_for = [](size_t count, const std::function<void(size_t)>& body) {
+    ppc::util::ParallelFor(0, count, body);
+  };
   for (int stage = 0; stage < num_blocks; ++stage) {
-    threads.clear();
-    threads.reserve(num_threads);
-
-    for (int t = 0; t < num_threads; ++t) {
-      threads.emplace_back([&, t, stage]() {
-        for (int task_id = t; task_id < total_tasks; task_id += num_threads) {
-          int i = (task_id / num_block_cols) * block_size_;
-          int j = (task_id % num_block_cols) * block_size_;
-          if (i < n_ && j < n_) {
-            FoxBlockMul(A_, B_, output_, n_, block_size_, stage, i, j);
-          }
-        }
-      });
-    }
-
-    for (auto& thread : threads) {
-      thread.join();
-    }
+    const auto batch = ppc::util::BlockStageBatch(A_.data(), B_.data(), output_.data(), n_, block_size_, stage,
+                                                  ppc::util::BlockSchedule::kFox);
+    ppc::util::GemmBatched(batch, parallel_for);
   }
-
   return true;
 }
 
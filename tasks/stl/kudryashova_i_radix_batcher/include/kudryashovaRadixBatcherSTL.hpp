@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstddef>
+#include <span>
 #include <utility>
 #include <vector>
 
@@ -8,8 +9,11 @@
 
 namespace kudryashova_i_radix_batcher_stl {
 std::vector<double> GetRandomDoubleVector(int size);
-void RadixDoubleSort(std::vector<double>& data, size_t first, size_t last);
-void BatcherMerge(std::vector<double>& target_array, size_t merge_start, size_t mid_point, size_t merge_end);
+// Blocks up to this size are sorted with SIMD sorting networks instead of radix passes
+constexpr size_t kNetworkSortMaxSize = 4096;
+// In-place MSD radix sort of data[first, last) by the IEEE-754 order of the bits
+void RadixDoubleSort(std::span<double> data, size_t first, size_t last);
+void BatcherMerge(std::span<double> target_array, size_t merge_start, size_t mid_point, size_t merge_end);
 
 class TestTaskSTL : public ppc::core::Task {
  public:
@@ -20,7 +24,8 @@ class TestTaskSTL : public ppc::core::Task {
   bool PostProcessingImpl() override;
 
  private:
-  std::vector<double> input_data_;
+  // sorted in place in the output buffer
+  std::span<double> data_;
 };
 
 }  // namespace kudryashova_i_radix_batcher_stl
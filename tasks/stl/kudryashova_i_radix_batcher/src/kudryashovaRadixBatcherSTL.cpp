@@ -4,149 +4,164 @@
 #include <array>
 #include <cstddef>
 #include <cstdint>
-#include <cstring>
-#include <thread>
+#include <span>
+#include <utility>
 #include <vector>
 
+#include "core/task/include/registry.hpp"
+#include "core/util/include/radix_sort.hpp"
+#include "core/util/include/sorting_network.hpp"
+#include "core/util/include/thread_pool.hpp"
 #include "core/util/include/util.hpp"
 
-void kudryashova_i_radix_batcher_stl::RadixDoubleSort(std::vector<double> &data, size_t first, size_t last) {
-  const size_t sort_size = last - first;
-  if (sort_size == 0) {
+namespace {
+
+using KeyTraits = ppc::util::RadixKeyTraits<double>;
+
+// Buckets up to this size are finished by insertion sort
+constexpr size_t kInsertionSortMaxSize = 32;
+// Buckets from this size are sorted as tasks of their own
+constexpr size_t kParallelBucketMinSize = size_t{1} << 15;
+
+unsigned GetDigit(double value, int shift) { return (KeyTraits::ToBits(value) >> shift) & 0xFFU; }
+
+void InsertionSort(std::span<double> data) {
+  for (size_t i = 1; i < data.size(); ++i) {
+    const double value = data[i];
+    const uint64_t key = KeyTraits::ToBits(value);
+    size_t j = i;
+    for (; j > 0 && key < KeyTraits::ToBits(data[j - 1]); --j) {
+      data[j] = data[j - 1];
+    }
+    data[j] = value;
+  }
+}
+
+// American flag sort: the byte at shift distributes data in place by following
+// swap cycles from bucket to bucket, then every bucket is sorted by the next byte
+void AmericanFlagSort(std::span<double> data, int shift, ppc::util::TaskGroup &group) {
+  if (data.size() <= kInsertionSortMaxSize) {
+    InsertionSort(data);
     return;
   }
-  std::vector<uint64_t> converted;
-  converted.reserve(sort_size);
-  for (size_t i = 0; i < sort_size; ++i) {
-    double value = data[first + i];
-    uint64_t bits = 0;
-    std::memcpy(&bits, &value, sizeof(value));
-    converted.push_back(((bits & (1ULL << 63)) != 0) ? ~bits : bits ^ (1ULL << 63));
+  std::array<size_t, 256> count = {};
+  for (const double value : data) {
+    ++count[GetDigit(value, shift)];
   }
-  std::vector<uint64_t> buffer;
-  buffer.reserve(sort_size);
-  buffer.resize(sort_size);
-  int bits_int_byte = 8;
-  int total_passes = sizeof(uint64_t);
-  int max_byte_value = 255;
-
-  for (int shift = 0; shift < total_passes; ++shift) {
-    std::array<size_t, 256> count = {0};
-    const int shift_loc = shift * bits_int_byte;
-    for (const auto &num : converted) {
-      ++count[(num >> shift_loc) & max_byte_value];
-    }
-    size_t total = 0;
-    for (auto &safe : count) {
-      size_t old = safe;
-      safe = total;
-      total += old;
-    }
-    for (const auto &num : converted) {
-      const uint8_t byte = (num >> shift_loc) & max_byte_value;
-      buffer[count[byte]++] = num;
+  // all keys share the byte (the sign and exponent of a narrow range): nothing moves
+  if (std::ranges::find(count, data.size()) != count.end()) {
+    if (shift > 0) {
+      AmericanFlagSort(data, shift - 8, group);
     }
-    converted.swap(buffer);
+    return;
   }
-  for (size_t i = 0; i < sort_size; ++i) {
-    uint64_t bits = converted[i];
-    bits = ((bits & (1ULL << 63)) != 0) ? (bits ^ (1ULL << 63)) : ~bits;
-    std::memcpy(&data[first + i], &bits, sizeof(double));
+  std::array<size_t, 256> head = {};
+  std::array<size_t, 256> tail = {};
+  size_t total = 0;
+  for (size_t digit = 0; digit < 256; ++digit) {
+    head[digit] = total;
+    total += count[digit];
+    tail[digit] = total;
   }
-}
-void kudryashova_i_radix_batcher_stl::BatcherMerge(std::vector<double> &target_array, size_t merge_start,
-                                                   size_t mid_point, size_t merge_end) {
-  const size_t total_elements = merge_end - merge_start;
-  const size_t left_size = mid_point - merge_start;
-  const size_t right_size = merge_end - mid_point;
-  std::vector<double> left_array(target_array.begin() + static_cast<std::ptrdiff_t>(merge_start),
-                                 target_array.begin() + static_cast<std::ptrdiff_t>(mid_point));
-  std::vector<double> right_array(target_array.begin() + static_cast<std::ptrdiff_t>(mid_point),
-                                  target_array.begin() + static_cast<std::ptrdiff_t>(merge_end));
-  size_t left_ptr = 0;
-  size_t right_ptr = 0;
-  size_t merge_ptr = merge_start;
-
-  for (size_t i = 0; i < total_elements; ++i) {
-    if (i % 2 == 0) {
-      if (left_ptr < left_size && (right_ptr >= right_size || left_array[left_ptr] <= right_array[right_ptr])) {
-        target_array[merge_ptr++] = left_array[left_ptr++];
-      } else {
-        target_array[merge_ptr++] = right_array[right_ptr++];
+
+  for (size_t digit = 0; digit < 256; ++digit) {
+    while (head[digit] < tail[digit]) {
+      double value = data[head[digit]];
+      unsigned value_digit = GetDigit(value, shift);
+      // carry value to its bucket until one that belongs here comes back
+      while (value_digit != digit) {
+        std::swap(value, data[head[value_digit]++]);
+        value_digit = GetDigit(value, shift);
       }
+      data[head[digit]++] = value;
+    }
+  }
+
+  if (shift == 0) {
+    return;
+  }
+  size_t begin = 0;
+  for (const size_t size : count) {
+    auto bucket = data.subspan(begin, size);
+    begin += size;
+    if (size <= 1) {
+      continue;
+    }
+    if (size >= kParallelBucketMinSize) {
+      group.Run([bucket, shift, &group] { AmericanFlagSort(bucket, shift - 8, group); });
     } else {
-      if (right_ptr < right_size && (left_ptr >= left_size || right_array[right_ptr] <= left_array[left_ptr])) {
-        target_array[merge_ptr++] = right_array[right_ptr++];
-      } else {
-        target_array[merge_ptr++] = left_array[left_ptr++];
-      }
+      AmericanFlagSort(bucket, shift - 8, group);
     }
   }
 }
 
+}  // namespace
+
+void kudryashova_i_radix_batcher_stl::RadixDoubleSort(std::span<double> data, size_t first, size_t last) {
+  const size_t sort_size = last - first;
+  if (sort_size == 0) {
+    return;
+  }
+  if (sort_size <= kNetworkSortMaxSize) {
+    ppc::util::NetworkSort(data.subspan(first, sort_size));
+    return;
+  }
+  // Keys are transformed on the fly, so no memory is needed beyond the data
+  ppc::util::TaskGroup group;
+  AmericanFlagSort(data.subspan(first, sort_size), 56, group);
+  group.Wait();
+}
+
+void kudryashova_i_radix_batcher_stl::BatcherMerge(std::span<double> target_array, size_t merge_start, size_t mid_point,
+                                                   size_t merge_end) {
+  // only the left run is copied away: the merge writes behind the unread part of the right run
+  const std::vector<double> left_array(target_array.begin() + static_cast<std::ptrdiff_t>(merge_start),
+                                       target_array.begin() + static_cast<std::ptrdiff_t>(mid_point));
+  ppc::util::NetworkMerge(left_array, target_array.subspan(mid_point, merge_end - mid_point),
+                          target_array.data() + merge_start);
+}
+
 bool kudryashova_i_radix_batcher_stl::TestTaskSTL::RunImpl() {
-  const size_t input_size = input_data_.size();
+  const size_t input_size = data_.size();
   if (input_size <= 1) {
     return true;
   }
 
   const size_t num_threads = ppc::util::GetPPCNumThreads();
   const size_t sort_block_size = (input_size + num_threads - 1) / num_threads;
+  const size_t num_blocks = (input_size + sort_block_size - 1) / sort_block_size;
 
-  std::vector<std::thread> sort_threads;
-  for (size_t thread_idx = 0; thread_idx < num_threads; ++thread_idx) {
-    const size_t block_start = thread_idx * sort_block_size;
+  ppc::util::ParallelFor(0, num_blocks, [this, sort_block_size, input_size](size_t block_idx) {
+    const size_t block_start = block_idx * sort_block_size;
     const size_t block_end = std::min(block_start + sort_block_size, input_size);
-
-    if (block_start >= input_size) {
-      break;
-    }
-
-    sort_threads.emplace_back([this, block_start, block_end] { RadixDoubleSort(input_data_, block_start, block_end); });
-  }
-  for (auto &thread : sort_threads) {
-    thread.join();
-  }
+    RadixDoubleSort(data_, block_start, block_end);
+  });
 
   for (size_t current_merge_size = sort_block_size; current_merge_size < input_size; current_merge_size *= 2) {
     const size_t merge_group_size = 2 * current_merge_size;
     const size_t total_merge_groups = (input_size + merge_group_size - 1) / merge_group_size;
 
-    std::vector<std::thread> merge_threads;
-    const size_t merge_groups_per_thread = (total_merge_groups + num_threads - 1) / num_threads;
-
-    for (size_t thread_idx = 0; thread_idx < num_threads; ++thread_idx) {
-      const size_t group_range_start = thread_idx * merge_groups_per_thread;
-      const size_t group_range_end = std::min(group_range_start + merge_groups_per_thread, total_merge_groups);
-
-      if (group_range_start >= group_range_end) {
-        break;
+    ppc::util::ParallelFor(0, total_merge_groups, [&, current_merge_size, merge_group_size](size_t group_index) {
+      const size_t merge_start = group_index * merge_group_size;
+      const size_t merge_mid = std::min(merge_start + current_merge_size, input_size);
+      const size_t merge_end = std::min(merge_start + merge_group_size, input_size);
+      if (merge_mid < merge_end) {
+        BatcherMerge(data_, merge_start, merge_mid, merge_end);
       }
-      merge_threads.emplace_back([&, group_range_start, group_range_end, current_merge_size, merge_group_size] {
-        for (size_t group_index = group_range_start; group_index < group_range_end; ++group_index) {
-          const size_t merge_start = group_index * merge_group_size;
-          const size_t merge_mid = std::min(merge_start + current_merge_size, input_size);
-          const size_t merge_end = std::min(merge_start + merge_group_size, input_size);
-          if (merge_mid < merge_end) {
-            BatcherMerge(input_data_, merge_start, merge_mid, merge_end);
-          }
-        }
-      });
-    }
-    for (auto &thread : merge_threads) {
-      thread.join();
-    }
+    });
   }
   return true;
 }
 
 bool kudryashova_i_radix_batcher_stl::TestTaskSTL::PreProcessingImpl() {
-  input_data_.resize(task_data->inputs_count[0]);
   if (task_data->inputs[0] == nullptr || task_data->inputs_count[0] == 0) {
     return false;
   }
-  auto *tmp_ptr = reinterpret_cast<double *>(task_data->inputs[0]);
-  std::copy(tmp_ptr, tmp_ptr + task_data->inputs_count[0], input_data_.begin());
+  auto input = task_data->GetInput<double>(0);
+  data_ = task_data->GetOutput<double>(0);
+  if (!task_data->IsInPlace()) {
+    std::ranges::copy(input, data_.begin());
+  }
   return true;
 }
 
@@ -154,7 +169,6 @@ bool kudryashova_i_radix_batcher_stl::TestTaskSTL::ValidationImpl() {
   return task_data->inputs_count[0] > 0 && task_data->outputs_count[0] == task_data->inputs_count[0];
 }
 
-bool kudryashova_i_radix_batcher_stl::TestTaskSTL::PostProcessingImpl() {
-  std::ranges::copy(input_data_, reinterpret_cast<double *>(task_data->outputs[0]));
-  return true;
-}
+bool kudryashova_i_radix_batcher_stl::TestTaskSTL::PostProcessingImpl() { return true; }
+
+PPC_REGISTER_SORT_TASK(kudryashova_i_radix_batcher_stl::TestTaskSTL, "kudryashova_i_radix_batcher", "stl", double);
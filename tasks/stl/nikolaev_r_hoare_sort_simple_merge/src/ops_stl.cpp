@@ -6,6 +6,7 @@
 #include <thread>
 #include <vector>
 
+#include "core/task/include/registry.hpp"
 #include "core/util/include/util.hpp"
 
 bool nikolaev_r_hoare_sort_simple_merge_stl::HoareSortSimpleMergeSTL::PreProcessingImpl() {
@@ -97,3 +98,6 @@ void nikolaev_r_hoare_sort_simple_merge_stl::HoareSortSimpleMergeSTL::QuickSort(
   }
   QuickSort(pivot + 1, high);
 }
+
+PPC_REGISTER_SORT_TASK(nikolaev_r_hoare_sort_simple_merge_stl::HoareSortSimpleMergeSTL,
+                       "nikolaev_r_hoare_sort_simple_merge", "stl", double);
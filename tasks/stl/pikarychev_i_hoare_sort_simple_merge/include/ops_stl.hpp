@@ -3,23 +3,19 @@
 #include <algorithm>
 #include <cstddef>
 #include <cstdio>
-#include <thread>
+#include <span>
 #include <utility>
 #include <vector>
 
 #include "core/task/include/task.hpp"
+#include "core/util/include/sample_sort.hpp"
+#include "core/util/include/thread_pool.hpp"
 #include "core/util/include/util.hpp"
 
 namespace pikarychev_i_hoare_sort_simple_merge {
 
 template <class T>
 class HoareSTL : public ppc::core::Task {
-  struct Block {
-    T* e;
-    std::size_t sz;
-    bool merged{false};
-  };
-
  public:
   explicit HoareSTL(ppc::core::TaskDataPtr task_data) : Task(std::move(task_data)) {}
 
@@ -37,71 +33,16 @@ class HoareSTL : public ppc::core::Task {
     return true;
   }
 
-  void SortInParallel(std::size_t parallelism, std::vector<Block>& blocks) {
-    std::vector<std::thread> workers(parallelism);
-    for (std::size_t t = 0; t < parallelism; t++) {
-      workers[t] = std::thread(
-          [&](std::size_t i) { DoSort(blocks[i].e, 0, blocks[i].sz - 1, reverse_ ? ReverseComp : StandardComp); }, t);
-    }
-    for (auto& thd : workers) {
-      thd.join();
-    }
-  }
-
-  void MergeGroup(std::size_t b, std::size_t e, std::size_t wide, std::vector<Block>& blocks) {
-    for (std::size_t k = b; k < e; ++k) {
-      const auto idx = 2 * wide * k;
-      DoInplaceMerge(blocks.data() + idx, blocks.data() + idx + wide, reverse_ ? ReverseComp : StandardComp);
-    }
-  }
-
-  void MergeInParallel(std::size_t parallelism, std::vector<Block>& blocks) {
-    std::vector<std::thread> workers;
-    workers.reserve(parallelism);
-
-    auto partind = parallelism;
-    for (auto wide = decltype(parallelism){1}; partind > 1; wide *= 2, partind /= 2) {
-      if (blocks[wide].sz < 40) {
-        MergeGroup(0, partind / 2, wide, blocks);
-      } else {
-        workers.resize(partind / 2);
-        for (std::size_t t = 0; t < workers.size(); t++) {
-          workers[t] = std::thread([&](std::size_t i) { MergeGroup(i, i + 1, wide, blocks); }, t);
-        }
-        for (auto& w : workers) {
-          w.join();
-        }
-      }
-      if ((partind / 2) == 1) {
-        DoInplaceMerge(&blocks.front(), &blocks.back(), reverse_ ? ReverseComp : StandardComp);
-      } else if ((partind / 2) % 2 != 0) {
-        DoInplaceMerge(blocks.data() + (2 * wide * ((partind / 2) - 2)),
-                       blocks.data() + (2 * wide * ((partind / 2) - 1)), reverse_ ? ReverseComp : StandardComp);
-      }
-    }
-  }
-
   bool RunImpl() override {
-    const auto size = input_.size();
-    std::ranges::copy_n(input_.begin(), size, res_.begin());
-
-    const auto parallelism = std::min<std::size_t>(size, ppc::util::GetPPCNumThreads());
-    if (size < 1) {
-      return true;
-    }
+    std::ranges::copy_n(input_.begin(), input_.size(), res_.begin());
 
-    const auto fair = size / parallelism;
-    const auto extra = size % parallelism;
-
-    std::vector<Block> blocks(parallelism);
-    T* pointer = res_.data();
-    for (std::size_t i = 0; i < parallelism; i++) {
-      blocks[i] = {.e = pointer, .sz = fair + ((i < extra) ? 1 : 0)};
-      pointer += blocks[i].sz;
-    }
-
-    SortInParallel(parallelism, blocks);
-    MergeInParallel(parallelism, blocks);
+    // every element is moved once, to its bucket, and the buckets are sorted independently instead of merging
+    // per-thread blocks in rounds
+    const auto comp = reverse_ ? ReverseComp : StandardComp;
+    ppc::util::SampleSort(
+        std::span<T>(res_),
+        [](std::size_t count, const auto& body) { ppc::util::ParallelFor(0, count, body); },
+        [comp](std::span<T> bucket) { DoSort(bucket.data(), 0, static_cast<int>(bucket.size()) - 1, comp); }, comp);
 
     return true;
   }
@@ -115,12 +56,6 @@ class HoareSTL : public ppc::core::Task {
   }
 
  private:
-  static void DoInplaceMerge(Block* b1, Block* b2, bool (*comp)(const T&, const T&)) {
-    std::inplace_merge(b1->e, b2->e, b2->e + b2->sz, comp);
-    b2->merged = true;
-    b1->sz += b2->sz;
-  }
-
   static int Partition(T* block, int low, int high, bool (*comp)(const T&, const T&)) {
     int e = low - 1;
     for (int j = low; j <= high - 1; j++) {
@@ -2,9 +2,12 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <span>
 #include <thread>
 #include <vector>
 
+#include "core/task/include/registry.hpp"
+#include "core/util/include/natural_merge.hpp"
 #include "core/util/include/util.hpp"
 
 namespace shlyakov_m_shell_sort_stl {
@@ -38,7 +41,9 @@ bool TestTaskSTL::RunImpl() {
     int right = std::min(left + sub_arr_size - 1, array_size - 1);
 
     if (left < right) {
-      threads.emplace_back([this, left, right]() { ShellSort(left, right, input_); });
+      threads.emplace_back([this, left, right]() {
+        ppc::util::AdaptiveSort(std::span<int>(input_).subspan(left, right - left + 1), ShellSort);
+      });
     }
   }
 
@@ -60,7 +65,7 @@ bool TestTaskSTL::RunImpl() {
 
       if (mid < right) {
         threads.emplace_back([this, left, mid, right]() {
-          std::vector<int> local_buffer(input_.size());
+          std::vector<int> local_buffer;
           Merge(left, mid, right, input_, local_buffer);
         });
       }
@@ -81,6 +86,15 @@ bool TestTaskSTL::RunImpl() {
 }
 
 void Merge(int left, int mid, int right, std::vector<int>& arr, std::vector<int>& buffer) {
+  // blocks of partially ordered input are often in order already, otherwise
+  // only their overlapping ends need merging
+  if (mid >= right || arr[mid] <= arr[mid + 1]) {
+    return;
+  }
+  const auto first = arr.begin();
+  left = static_cast<int>(std::upper_bound(first + left, first + mid + 1, arr[mid + 1]) - first);
+  right = static_cast<int>(std::lower_bound(first + mid + 1, first + right + 1, arr[mid]) - first) - 1;
+
   int i = left;
   int j = mid + 1;
   int k = 0;
@@ -105,8 +119,8 @@ void Merge(int left, int mid, int right, std::vector<int>& arr, std::vector<int>
   }
 }
 
-void ShellSort(int left, int right, std::vector<int>& arr) {
-  int sub_array_size = right - left + 1;
+void ShellSort(std::span<int> arr) {
+  const int sub_array_size = static_cast<int>(arr.size());
   int gap = 1;
 
   for (; gap <= sub_array_size / 3;) {
@@ -114,11 +128,11 @@ void ShellSort(int left, int right, std::vector<int>& arr) {
   }
 
   for (; gap > 0; gap /= 3) {
-    for (int k = left + gap; k <= right; ++k) {
+    for (int k = gap; k < sub_array_size; ++k) {
       int current_element = arr[k];
       int j = k;
 
-      while (j >= left + gap && arr[j - gap] > current_element) {
+      while (j >= gap && arr[j - gap] > current_element) {
         arr[j] = arr[j - gap];
         j -= gap;
       }
@@ -135,3 +149,5 @@ bool TestTaskSTL::PostProcessingImpl() {
 }
 
 }  // namespace shlyakov_m_shell_sort_stl
+
+PPC_REGISTER_SORT_TASK(shlyakov_m_shell_sort_stl::TestTaskSTL, "shlyakov_m_shell_sort", "stl", int);
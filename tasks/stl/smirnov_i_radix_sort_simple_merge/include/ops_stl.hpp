@@ -1,8 +1,6 @@
 #pragma once
 
 #include <cmath>
-#include <deque>
-#include <mutex>
 #include <utility>
 #include <vector>
 
@@ -21,8 +19,6 @@ class TestTaskSTL : public ppc::core::Task {
  private:
   std::vector<int> mas_, output_;
   static void RadixSort(std::vector<int> &mas);
-  static std::vector<int> Merge(std::vector<int> &mas1, std::vector<int> &mas2);
-  static void Merging(std::deque<std::vector<int>> &firstdq, std::deque<std::vector<int>> &seconddq, std::mutex &mtx);
   static std::vector<int> Sorting(int id, std::vector<int> &mas, int max_th);
 };
 
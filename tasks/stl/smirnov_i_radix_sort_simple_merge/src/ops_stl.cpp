@@ -3,47 +3,15 @@
 #include <algorithm>
 #include <cmath>
 #include <cstddef>
-#include <deque>
-#include <functional>
-#include <future>
-#include <mutex>
 #include <numeric>
-#include <thread>
+#include <span>
 #include <utility>
 #include <vector>
 
+#include "core/util/include/multiway_merge.hpp"
+#include "core/util/include/thread_pool.hpp"
 #include "core/util/include/util.hpp"
 
-std::vector<int> smirnov_i_radix_sort_simple_merge_stl::TestTaskSTL::Merge(std::vector<int> &mas1,
-                                                                           std::vector<int> &mas2) {
-  std::vector<int> res;
-  res.reserve(mas1.size() + mas2.size());
-  int p1 = 0;
-  int p2 = 0;
-  while (static_cast<int>(mas1.size()) != p1 && static_cast<int>(mas2.size()) != p2) {
-    if (mas1[p1] < mas2[p2]) {
-      res.push_back(mas1[p1]);
-      p1++;
-    } else if (mas2[p2] < mas1[p1]) {
-      res.push_back(mas2[p2]);
-      p2++;
-    } else {
-      res.push_back(mas1[p1]);
-      res.push_back(mas2[p2]);
-      p1++;
-      p2++;
-    }
-  }
-  while (static_cast<int>(mas1.size()) != p1) {
-    res.push_back(mas1[p1]);
-    p1++;
-  }
-  while (static_cast<int>(mas2.size()) != p2) {
-    res.push_back(mas2[p2]);
-    p2++;
-  }
-  return res;
-}
 void smirnov_i_radix_sort_simple_merge_stl::TestTaskSTL::RadixSort(std::vector<int> &mas) {
   if (mas.empty()) {
     return;
@@ -75,31 +43,6 @@ std::vector<int> smirnov_i_radix_sort_simple_merge_stl::TestTaskSTL::Sorting(int
   RadixSort(local_mas);
   return local_mas;
 }
-void smirnov_i_radix_sort_simple_merge_stl::TestTaskSTL::Merging(std::deque<std::vector<int>> &firstdq,
-                                                                 std::deque<std::vector<int>> &seconddq,
-                                                                 std::mutex &mtx) {
-  std::vector<int> mas1{};
-  std::vector<int> mas2{};
-  std::vector<int> merge_mas{};
-  {
-    std::lock_guard<std::mutex> lock(mtx);
-    if (static_cast<int>(firstdq.size()) >= 2) {
-      mas1 = std::move(firstdq.front());
-      firstdq.pop_front();
-      mas2 = std::move(firstdq.front());
-      firstdq.pop_front();
-    } else {
-      return;
-    }
-  }
-  if (!mas1.empty() && !mas2.empty()) {
-    merge_mas = Merge(mas1, mas2);
-  }
-  if (!merge_mas.empty()) {
-    std::lock_guard<std::mutex> lock(mtx);
-    seconddq.push_back(std::move(merge_mas));
-  }
-}
 bool smirnov_i_radix_sort_simple_merge_stl::TestTaskSTL::PreProcessingImpl() {
   unsigned int input_size = task_data->inputs_count[0];
   auto *in_ptr = reinterpret_cast<int *>(task_data->inputs[0]);
@@ -117,43 +60,14 @@ bool smirnov_i_radix_sort_simple_merge_stl::TestTaskSTL::RunImpl() {
   const int min_chunk_size = 20;
   max_th = std::min(max_th, static_cast<int>(mas_.size() / min_chunk_size) + 1);
   max_th = std::max(1, max_th);
-  std::mutex mtxfirstdq;
-  std::mutex mtx;
-  std::vector<std::future<std::vector<int>>> ths(max_th);
-  for (int i = 0; i < max_th; i++) {
-    ths[i] = std::async(std::launch::async, &smirnov_i_radix_sort_simple_merge_stl::TestTaskSTL::Sorting, i,
-                        std::ref(mas_), max_th);
-  }
-  std::deque<std::vector<int>> firstdq;
-  std::deque<std::vector<int>> seconddq;
-  for (int i = 0; i < max_th; i++) {
-    std::vector<int> local_mas = ths[i].get();
-    if (!local_mas.empty()) {
-      std::lock_guard<std::mutex> lock(mtxfirstdq);
-      firstdq.push_back(std::move(local_mas));
-    }
-  }
-  bool flag = static_cast<int>(firstdq.size()) != 1;
-  std::vector<std::thread> threads{};
-  while (flag) {
-    int pairs = (static_cast<int>(firstdq.size()) + 1) / 2;
-    threads.clear();
-    threads.reserve(pairs);
-    for (int i = 0; i < pairs; i++) {
-      threads.emplace_back(&smirnov_i_radix_sort_simple_merge_stl::TestTaskSTL::Merging, std::ref(firstdq),
-                           std::ref(seconddq), std::ref(mtx));
-    }
-    for (auto &th : threads) {
-      th.join();
-    }
-    if (static_cast<int>(firstdq.size()) == 1) {
-      seconddq.push_back(std::move(firstdq.front()));
-      firstdq.pop_front();
-    }
-    std::swap(firstdq, seconddq);
-    flag = static_cast<int>(firstdq.size()) != 1;
-  }
-  output_ = std::move(firstdq.front());
+  std::vector<std::vector<int>> runs(max_th);
+  ppc::util::ParallelFor(0, max_th, [&](size_t i) { runs[i] = Sorting(static_cast<int>(i), mas_, max_th); });
+
+  // All runs are merged in one pass, every thread writes an equal part of the output
+  const std::vector<std::span<const int>> sorted_runs(runs.begin(), runs.end());
+  ppc::util::ParallelFor(0, max_th, [&](size_t part) {
+    ppc::util::MultiwayMergePart(sorted_runs, output_.data(), part, max_th);
+  });
   return true;
 }
 
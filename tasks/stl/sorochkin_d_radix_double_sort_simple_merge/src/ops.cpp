@@ -12,6 +12,7 @@
 #include <thread>
 #include <vector>
 
+#include "core/task/include/registry.hpp"
 #include "core/util/include/util.hpp"
 
 namespace {
@@ -135,3 +136,6 @@ bool sorochkin_d_radix_double_sort_simple_merge_stl::SortTask::PostProcessingImp
   std::ranges::copy(output_, reinterpret_cast<double *>(task_data->outputs[0]));
   return true;
 }
+
+PPC_REGISTER_SORT_TASK(sorochkin_d_radix_double_sort_simple_merge_stl::SortTask,
+                       "sorochkin_d_radix_double_sort_simple_merge", "stl", double);
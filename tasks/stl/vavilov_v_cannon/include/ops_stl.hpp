@@ -24,11 +24,5 @@ class CannonSTL : public ppc::core::Task {
   std::vector<double> A_;
   std::vector<double> B_;
   std::vector<double> C_;
-
-  void InitialShift(int num_threads, int blocks_per_thread);
-  void BlockMultiply(int num_threads, int blocks_per_thread);
-  void ShiftBlocks(int num_threads, int blocks_per_thread);
-  void ProcessSingleBlock(int bi, int bj, int bi_start, std::vector<double>& local);
-  void MergeResults(int num_threads, int bi_range, const std::vector<std::vector<double>>& local_c);
 };
 }  // namespace vavilov_v_cannon_stl
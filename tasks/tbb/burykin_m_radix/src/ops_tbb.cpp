@@ -10,6 +10,7 @@
 #include <utility>
 #include <vector>
 
+#include "core/task/include/registry.hpp"
 #include "core/util/include/util.hpp"
 
 std::array<int, 256> burykin_m_radix_tbb::RadixTBB::ComputeFrequencyParallel(const std::vector<int>& a,
@@ -145,3 +146,5 @@ bool burykin_m_radix_tbb::RadixTBB::PostProcessingImpl() {
   }
   return true;
 }
+
+PPC_REGISTER_SORT_TASK(burykin_m_radix_tbb::RadixTBB, "burykin_m_radix", "tbb", int);
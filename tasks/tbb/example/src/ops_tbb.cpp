@@ -7,6 +7,7 @@
 #include <cstddef>
 #include <vector>
 
+#include "core/task/include/registry.hpp"
 #include "oneapi/tbb/task_arena.h"
 #include "oneapi/tbb/task_group.h"
 
@@ -59,3 +60,5 @@ bool nesterov_a_test_task_tbb::TestTaskTBB::PostProcessingImpl() {
   }
   return true;
 }
+
+PPC_REGISTER_TASK(nesterov_a_test_task_tbb::TestTaskTBB, "example", "tbb", ppc::core::MakeIdentitySquareInput);
@@ -10,6 +10,8 @@
 #include <cstddef>
 #include <vector>
 
+#include "core/util/include/sorting_network.hpp"
+
 namespace fyodorov_m_shell_sort_with_even_odd_batcher_merge_tbb {
 
 bool TestTaskTBB::PreProcessingImpl() {
@@ -76,25 +78,8 @@ void TestTaskTBB::ShellSort() {
 }
 
 void TestTaskTBB::BatcherMerge(std::vector<int>& left, std::vector<int>& right, std::vector<int>& result) {
-  size_t i = 0;
-  size_t j = 0;
-  size_t k = 0;
-
-  while (i < left.size() && j < right.size()) {
-    if (left[i] <= right[j]) {
-      result[k++] = left[i++];
-    } else {
-      result[k++] = right[j++];
-    }
-  }
-
-  while (i < left.size()) {
-    result[k++] = left[i++];
-  }
-
-  while (j < right.size()) {
-    result[k++] = right[j++];
-  }
+  // Branch-free network merge instead of a compare-and-branch loop
+  ppc::util::NetworkMerge(left, right, result.data());
 }
 
 }  // namespace fyodorov_m_shell_sort_with_even_odd_batcher_merge_tbb
\ No newline at end of file
@@ -4,22 +4,22 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstddef>
 #include <vector>
 
+#include "core/util/include/gemm.hpp"
 #include "oneapi/tbb/parallel_for.h"
 
 namespace {
+// C block (i, j) += A block (i, k) * B block (k, j)
 void FoxBlockMul(const std::vector<double>& a, const std::vector<double>& b, std::vector<double>& c, int n,
-                 int block_size, int stage, int i, int j, int k) {
-  for (int bi = i; bi < std::min(i + block_size, n); ++bi) {
-    for (int bj = j; bj < std::min(j + block_size, n); ++bj) {
-      double sum = 0.0;
-      for (int bk = k; bk < std::min(k + block_size, n); ++bk) {
-        sum += a[(bi * n) + bk] * b[(bk * n) + bj];
-      }
-      c[(bi * n) + bj] += sum;
-    }
-  }
+                 int block_size, int i, int j, int k) {
+  const auto rows = static_cast<size_t>(std::min(block_size, n - i));
+  const auto cols = static_cast<size_t>(std::min(block_size, n - j));
+  const auto depth = static_cast<size_t>(std::min(block_size, n - k));
+  const auto ld = static_cast<size_t>(n);
+  ppc::util::Gemm(rows, cols, depth, 1.0, a.data() + (i * ld) + k, ld, b.data() + (k * ld) + j, ld, 1.0,
+                  c.data() + (i * ld) + j, ld);
 }
 }  // namespace
 
@@ -80,7 +80,7 @@ bool gromov_a_fox_algorithm_tbb::TestTaskTBB::RunImpl() {
 
     for (int step = 0; step < num_blocks; ++step) {
       int k = (i + step) % num_blocks;
-      FoxBlockMul(A_, B_, output_, n_, block_size_, step, i * block_size_, j * block_size_, k * block_size_);
+      FoxBlockMul(A_, B_, output_, n_, block_size_, i * block_size_, j * block_size_, k * block_size_);
     }
   });
 
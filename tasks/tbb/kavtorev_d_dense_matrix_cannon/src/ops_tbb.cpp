@@ -1,13 +1,17 @@
 // Copyright 2025 Kavtorev Dmitry
 #include "tbb/kavtorev_d_dense_matrix_cannon/include/ops_tbb.hpp"
 
+#include <oneapi/tbb/blocked_range.h>
 #include <oneapi/tbb/blocked_range2d.h>
 #include <oneapi/tbb/parallel_for.h>
+#include <oneapi/tbb/task_arena.h>
 
 #include <algorithm>
 #include <cstddef>
 #include <vector>
 
+#include "core/util/include/gemm.hpp"
+
 std::vector<double> kavtorev_d_dense_matrix_cannon_tbb::CannonMatrixMultiplication(const std::vector<double>& a,
                                                                                    const std::vector<double>& b, int n,
                                                                                    int m) {
@@ -18,20 +22,18 @@ std::vector<double> kavtorev_d_dense_matrix_cannon_tbb::CannonMatrixMultiplicati
   int size_block = std::min(n, m);
   std::vector<double> mtrx_c(n * m, 0.0);
 
+  // Произведения округляются отдельно (без FMA), как в обычном цикле
+  ppc::util::GemmOptions options;
+  options.fused = false;
+
   // Вспомогательная функция для обработки одного блока
   auto process_block = [&](int i, int j, int k) {
-    int i_end = std::min(i + size_block, n);
-    int j_end = std::min(j + size_block, m);
-    int k_end = std::min(k + size_block, m);
-
-    for (int ii = i; ii < i_end; ++ii) {
-      for (int kk = k; kk < k_end; ++kk) {
-        double a_ik = a[(ii * m) + kk];
-        for (int jj = j; jj < j_end; ++jj) {
-          mtrx_c[(ii * m) + jj] += a_ik * b[(kk * m) + jj];
-        }
-      }
-    }
+    const auto rows = static_cast<size_t>(std::min(i + size_block, n) - i);
+    const auto cols = static_cast<size_t>(std::min(j + size_block, m) - j);
+    const auto depth = static_cast<size_t>(std::min(k + size_block, m) - k);
+    const auto ld = static_cast<size_t>(m);
+    ppc::util::Gemm(rows, cols, depth, 1.0, a.data() + (i * ld) + k, ld, b.data() + (k * ld) + j, ld, 1.0,
+                    mtrx_c.data() + (i * ld) + j, ld, options);
   };
 
   // Параллельная обработка блоков
@@ -59,12 +61,17 @@ std::vector<double> kavtorev_d_dense_matrix_cannon_tbb::MultiplyMatrix(const std
     return {};
   }
 
-  tbb::parallel_for(0, rows_a, [&](int i) {
-    for (int j = 0; j < col_b; ++j) {
-      for (int k = 0; k < col_a; ++k) {
-        mtrx_c[(i * col_b) + j] += a[(i * col_a) + k] * b[(k * col_b) + j];
-      }
-    }
+  // every task multiplies a band of rows, without FMA like CannonMatrixMultiplication
+  ppc::util::GemmOptions options;
+  options.fused = false;
+  const int band = std::max(1, rows_a / tbb::this_task_arena::max_concurrency());
+  tbb::parallel_for(tbb::blocked_range<int>(0, rows_a, band), [&](const tbb::blocked_range<int>& range) {
+    const auto rows = static_cast<size_t>(range.end() - range.begin());
+    const auto begin = static_cast<size_t>(range.begin());
+    const auto lda = static_cast<size_t>(col_a);
+    const auto ldc = static_cast<size_t>(col_b);
+    ppc::util::Gemm(rows, ldc, lda, 1.0, a.data() + (begin * lda), lda, b.data(), ldc, 0.0,
+                    mtrx_c.data() + (begin * ldc), ldc, options);
   });
 
   return mtrx_c;
@@ -4,10 +4,12 @@
 #include <cstdint>
 #include <ctime>
 #include <functional>
+#include <limits>
 #include <memory>
 #include <random>
 #include <vector>
 
+#include "core/task/include/registry.hpp"
 #include "core/task/include/task.hpp"
 #include "tbb/kudryashova_i_radix_batcher/include/kudryashovaRadixBatcherTBB.hpp"
 
@@ -190,3 +192,24 @@ TEST(kudryashova_i_radix_batcher_tbb, tbb_radix_test_reverse_order) {
   std::ranges::sort(sorted_global_vector);
   ASSERT_EQ(result, sorted_global_vector);
 }
+
+TEST(kudryashova_i_radix_batcher_tbb, tbb_radix_test_negative_nans) {
+  // x86 produces negative NaNs; the sorted blocks start with them before the merges
+  int global_vector_size = 20000;
+  std::vector<double> global_vector = kudryashova_i_radix_batcher_tbb::GetRandomDoubleVector(global_vector_size);
+  global_vector[17] = -std::numeric_limits<double>::quiet_NaN();
+  global_vector[9000] = -std::numeric_limits<double>::quiet_NaN();
+  global_vector[15000] = std::numeric_limits<double>::quiet_NaN();
+  std::vector<double> result(global_vector_size);
+  std::shared_ptr<ppc::core::TaskData> task_data = std::make_shared<ppc::core::TaskData>();
+  task_data->inputs.emplace_back(reinterpret_cast<uint8_t *>(global_vector.data()));
+  task_data->inputs_count.emplace_back(global_vector.size());
+  task_data->outputs.emplace_back(reinterpret_cast<uint8_t *>(result.data()));
+  task_data->outputs_count.emplace_back(result.size());
+  kudryashova_i_radix_batcher_tbb::TestTaskTBB task_tbb(task_data);
+  ASSERT_TRUE(task_tbb.ValidationImpl());
+  task_tbb.PreProcessingImpl();
+  task_tbb.RunImpl();
+  task_tbb.PostProcessingImpl();
+  EXPECT_TRUE(ppc::core::IsSortedPermutation(global_vector, result));
+}
@@ -10,6 +10,10 @@
 
 namespace kudryashova_i_radix_batcher_tbb {
 std::vector<double> GetRandomDoubleVector(int size);
+// Blocks up to this size are sorted with SIMD sorting networks instead of radix passes
+constexpr size_t kNetworkSortMaxSize = 4096;
+// Radix passes split a block into chunks of at least this size
+constexpr size_t kMinChunkSize = size_t{1} << 14;
 void ConvertDoublesToUint64(const std::vector<double>& data, std::vector<uint64_t>& converted, size_t first);
 void ConvertUint64ToDoubles(std::vector<double>& data, const std::vector<uint64_t>& converted, size_t first);
 void RadixDoubleSort(std::vector<double>& data, size_t first, size_t last);
@@ -1,20 +1,22 @@
 #include "tbb/kudryashova_i_radix_batcher/include/kudryashovaRadixBatcherTBB.hpp"
 
-#include <oneapi/tbb/combinable.h>
 #include <oneapi/tbb/parallel_for.h>
-#include <oneapi/tbb/parallel_invoke.h>
 #include <tbb/blocked_range.h>
 #include <tbb/global_control.h>
 #include <tbb/partitioner.h>
 
 #include <algorithm>
-#include <array>
-#include <climits>
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
+#include <span>
 #include <vector>
 
+#include "core/task/include/registry.hpp"
+#include "core/util/include/radix_sort.hpp"
+#include "core/util/include/sorting_network.hpp"
+#include "core/util/include/util.hpp"
+
 void kudryashova_i_radix_batcher_tbb::ConvertDoublesToUint64(const std::vector<double>& data,
                                                              std::vector<uint64_t>& converted, size_t first) {
   tbb::parallel_for(
@@ -45,85 +47,104 @@ void kudryashova_i_radix_batcher_tbb::ConvertUint64ToDoubles(std::vector<double>
 
 void kudryashova_i_radix_batcher_tbb::RadixDoubleSort(std::vector<double>& data, size_t first, size_t last) {
   const size_t sort_size = last - first;
+  if (sort_size <= kNetworkSortMaxSize) {
+    ppc::util::NetworkSort(std::span<double>(data).subspan(first, sort_size));
+    return;
+  }
   std::vector<uint64_t> converted(sort_size);
   // Convert each double to uint64_t representation
   ConvertDoublesToUint64(data, converted, first);
 
-  std::vector<uint64_t> buffer(sort_size);
-  int bits_int_byte = 8;
-  int max_byte_value = 255;
-  size_t total_bits = sizeof(uint64_t) * CHAR_BIT;
-  for (size_t shift = 0; shift < total_bits; shift += bits_int_byte) {
-    tbb::combinable<std::array<size_t, 256>> local_counts;
-    tbb::parallel_for(tbb::blocked_range<size_t>(0, sort_size), [&](const auto& range) {
-      auto& counts = local_counts.local();
-      for (size_t i = range.begin(); i != range.end(); ++i) {
-        ++counts[(converted[i] >> shift) & max_byte_value];
+  constexpr int kKeyBits = 64;
+  const int digit_bits = ppc::util::RadixDigitBits(sort_size, kKeyBits);
+  const int num_passes = ppc::util::RadixNumPasses(kKeyBits, digit_bits);
+  const size_t num_digits = size_t{1} << digit_bits;
+  // Every chunk keeps the same contiguous block in all passes
+  const size_t num_chunks = std::clamp<size_t>(sort_size / kMinChunkSize, 1, ppc::util::GetPPCNumThreads());
+  const auto chunk_begin = [&](size_t chunk) { return sort_size * chunk / num_chunks; };
+  const auto for_each_chunk = [&](const auto& func) {
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, num_chunks, 1), [&](const auto& range) {
+      for (size_t chunk = range.begin(); chunk != range.end(); ++chunk) {
+        func(chunk);
       }
     });
+  };
 
-    std::array<size_t, 256> total_counts{};
-    local_counts.combine_each([&](const auto& local_count) {
-      for (size_t i = 0; i < 256; ++i) {
-        total_counts[i] += local_count[i];
-      }
-    });
-    // Convert the count array to a prefix sum array
-    size_t total = 0;
-    for (auto& safe : total_counts) {
-      size_t old = safe;
-      safe = total;
-      total += old;
+  // digit counts of all passes in one sweep
+  std::vector<std::vector<size_t>> counts(num_chunks, std::vector<size_t>(num_passes * num_digits));
+  for_each_chunk([&](size_t chunk) {
+    ppc::util::RadixCountAll(converted.data(), chunk_begin(chunk), chunk_begin(chunk + 1), digit_bits,
+                             counts[chunk].data());
+  });
+  std::vector<size_t> totals(num_passes * num_digits);
+  for (const auto& chunk_counts : counts) {
+    for (size_t j = 0; j < totals.size(); ++j) {
+      totals[j] += chunk_counts[j];
     }
+  }
 
-    tbb::parallel_for(tbb::blocked_range<size_t>(0, 256), [&](const auto& range) {
-      for (size_t j = range.begin(); j != range.end(); ++j) {
-        size_t count = total_counts[j];
-        for (size_t i = 0; i < sort_size; ++i) {
-          if (((converted[i] >> shift) & max_byte_value) == j) {
-            buffer[count++] = converted[i];
-          }
-        }
+  std::vector<uint64_t> buffer(sort_size);
+  bool scattered = false;
+  for (int pass = 0; pass < num_passes; ++pass) {
+    const size_t pass_offset = static_cast<size_t>(pass) * num_digits;
+    const int shift = pass * digit_bits;
+    // all keys share the digit: the pass would only copy the data
+    if (ppc::util::RadixPassIsConstant(totals.data() + pass_offset, digit_bits, sort_size)) {
+      continue;
+    }
+    // after a scatter a chunk holds other keys than in the sweep
+    if (scattered) {
+      for_each_chunk([&](size_t chunk) {
+        ppc::util::RadixCount(converted.data(), chunk_begin(chunk), chunk_begin(chunk + 1), shift, digit_bits,
+                              counts[chunk].data() + pass_offset);
+      });
+    }
+    // digits in order, chunks in order within a digit, so the scatter is stable
+    size_t sum = 0;
+    for (size_t digit = 0; digit < num_digits; ++digit) {
+      for (auto& chunk_counts : counts) {
+        const size_t count = chunk_counts[pass_offset + digit];
+        chunk_counts[pass_offset + digit] = sum;
+        sum += count;
+      }
+    }
+    for_each_chunk([&](size_t chunk) {
+      size_t* index = counts[chunk].data() + pass_offset;
+      for (size_t i = chunk_begin(chunk); i < chunk_begin(chunk + 1); ++i) {
+        buffer[index[(converted[i] >> shift) & (num_digits - 1)]++] = converted[i];
       }
     });
-
     converted.swap(buffer);
+    scattered = true;
   }
   ConvertUint64ToDoubles(data, converted, first);
 }
 
 void kudryashova_i_radix_batcher_tbb::BatcherMerge(std::vector<double>& target_array, size_t merge_start,
                                                    size_t mid_point, size_t merge_end) {
-  const size_t n = merge_end - merge_start;
-  if (n <= 1) {
-    return;
-  }
-  tbb::parallel_invoke([&] { BatcherMerge(target_array, merge_start, (merge_start + mid_point) / 2, mid_point); },
-                       [&] { BatcherMerge(target_array, mid_point, (mid_point + merge_end) / 2, merge_end); });
-
-  for (size_t step = 1; step < n; step *= 2) {
-    tbb::parallel_for(tbb::blocked_range<size_t>(0, n / (2 * step)), [&](const auto& batch_range) {
-      for (size_t i = batch_range.begin(); i != batch_range.end(); ++i) {
-        const size_t left = merge_start + (2 * step * i);
-        const size_t block_end = std::min(left + (2 * step), merge_end);
-        for (size_t j = left + 1; j < block_end; j += 2) {
-          if (target_array[j - 1] > target_array[j]) {
-            std::swap(target_array[j - 1], target_array[j]);
-          }
-        }
-      }
-    });
-  }
+  // Both runs are sorted, so one branch-free network pass merges them; only the left run is copied away
+  const std::vector<double> left_array(target_array.begin() + static_cast<std::ptrdiff_t>(merge_start),
+                                       target_array.begin() + static_cast<std::ptrdiff_t>(mid_point));
+  ppc::util::NetworkMerge(left_array, std::span<const double>(target_array).subspan(mid_point, merge_end - mid_point),
+                          target_array.data() + merge_start);
 }
 
 bool kudryashova_i_radix_batcher_tbb::TestTaskTBB::RunImpl() {
-  size_t n = input_data_.size();
-  RadixDoubleSort(input_data_, 0, n);
-  for (size_t step = 1; step < n; step *= 2) {
-    tbb::parallel_for(tbb::blocked_range<size_t>(0, n / (2 * step)), [&](const auto& merge_range) {
+  const size_t n = input_data_.size();
+  const size_t num_threads = ppc::util::GetPPCNumThreads();
+  const size_t block_size = (n + num_threads - 1) / num_threads;
+  const size_t num_blocks = (n + block_size - 1) / block_size;
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, num_blocks, 1), [&](const auto& block_range) {
+    for (size_t i = block_range.begin(); i != block_range.end(); ++i) {
+      RadixDoubleSort(input_data_, i * block_size, std::min((i + 1) * block_size, n));
+    }
+  });
+  for (size_t step = block_size; step < n; step *= 2) {
+    const size_t num_merges = (n + (2 * step) - 1) / (2 * step);
+    tbb::parallel_for(tbb::blocked_range<size_t>(0, num_merges, 1), [&](const auto& merge_range) {
       for (size_t i = merge_range.begin(); i != merge_range.end(); ++i) {
         const size_t start = 2 * step * i;
-        const size_t mid = start + step;
+        const size_t mid = std::min(start + step, n);
         const size_t end = std::min(start + (2 * step), n);
         if (mid < end) {
           BatcherMerge(input_data_, start, mid, end);
@@ -152,3 +173,5 @@ bool kudryashova_i_radix_batcher_tbb::TestTaskTBB::PostProcessingImpl() {
   std::ranges::copy(input_data_, reinterpret_cast<double*>(task_data->outputs[0]));
   return true;
 }
+
+PPC_REGISTER_SORT_TASK(kudryashova_i_radix_batcher_tbb::TestTaskTBB, "kudryashova_i_radix_batcher", "tbb", double);
@@ -1,8 +1,8 @@
 #pragma once
 
 #include <cstddef>
+#include <span>
 #include <utility>
-#include <vector>
 
 #include "core/task/include/task.hpp"
 
@@ -17,8 +17,9 @@ class TestTaskTBB : public ppc::core::Task {
   bool PostProcessingImpl() override;
 
  private:
-  std::vector<int> graph_data_;
-  std::vector<int> distances_;
+  // views over caller's buffers, distances are computed in the output
+  std::span<const int> graph_data_;
+  std::span<int> distances_;
   size_t start_vertex_;
   size_t num_vertices_;
   static const int kEndOfVertexList;
@@ -5,16 +5,18 @@
 #include <oneapi/tbb/parallel_for.h>
 #include <oneapi/tbb/spin_mutex.h>
 
+#include <algorithm>
 #include <climits>
 #include <cstddef>
 #include <functional>
+#include <span>
 #include <utility>
 #include <vector>
 
 const int muhina_m_dijkstra_tbb::TestTaskTBB::kEndOfVertexList = -1;
 
 namespace {
-void RunDijkstraAlgorithm(const std::vector<std::vector<std::pair<size_t, int>>> &adj_list, std::vector<int> &distances,
+void RunDijkstraAlgorithm(const std::vector<std::vector<std::pair<size_t, int>>> &adj_list, std::span<int> distances,
                           size_t start_vertex) {
   oneapi::tbb::concurrent_priority_queue<std::pair<int, size_t>, std::greater<>> pq;
   pq.push({0, start_vertex});
@@ -57,15 +59,11 @@ void RunDijkstraAlgorithm(const std::vector<std::vector<std::pair<size_t, int>>>
 }  // namespace
 
 bool muhina_m_dijkstra_tbb::TestTaskTBB::PreProcessingImpl() {
-  unsigned int input_size = task_data->inputs_count[0];
-  auto *in_ptr = reinterpret_cast<int *>(task_data->inputs[0]);
-  graph_data_.assign(in_ptr, in_ptr + input_size);
+  graph_data_ = task_data->GetInput<int>(0);
 
   num_vertices_ = task_data->outputs_count[0];
-  distances_.resize(num_vertices_);
-  for (size_t i = 0; i < num_vertices_; ++i) {
-    distances_[i] = INT_MAX;
-  }
+  distances_ = task_data->GetOutput<int>(0);
+  std::ranges::fill(distances_, INT_MAX);
   if (task_data->inputs.size() > 1 && task_data->inputs[1] != nullptr) {
     start_vertex_ = *reinterpret_cast<int *>(task_data->inputs[1]);
   } else {
@@ -114,9 +112,4 @@ bool muhina_m_dijkstra_tbb::TestTaskTBB::RunImpl() {
   return true;
 }
 
-bool muhina_m_dijkstra_tbb::TestTaskTBB::PostProcessingImpl() {
-  for (size_t i = 0; i < distances_.size(); ++i) {
-    reinterpret_cast<int *>(task_data->outputs[0])[i] = distances_[i];
-  }
-  return true;
-}
+bool muhina_m_dijkstra_tbb::TestTaskTBB::PostProcessingImpl() { return true; }
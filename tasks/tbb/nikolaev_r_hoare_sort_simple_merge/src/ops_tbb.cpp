@@ -9,6 +9,7 @@
 #include <utility>
 #include <vector>
 
+#include "core/task/include/registry.hpp"
 #include "oneapi/tbb/task_arena.h"
 #include "oneapi/tbb/task_group.h"
 
@@ -103,3 +104,6 @@ void nikolaev_r_hoare_sort_simple_merge_tbb::HoareSortSimpleMergeTBB::QuickSort(
   }
   QuickSort(pivot + 1, high);
 }
+
+PPC_REGISTER_SORT_TASK(nikolaev_r_hoare_sort_simple_merge_tbb::HoareSortSimpleMergeTBB,
+                       "nikolaev_r_hoare_sort_simple_merge", "tbb", double);
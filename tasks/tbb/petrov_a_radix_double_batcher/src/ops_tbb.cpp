@@ -4,9 +4,12 @@
 #include <cmath>
 #include <cstddef>
 #include <cstdint>
+#include <span>
 #include <utility>
 #include <vector>
 
+#include "core/task/include/registry.hpp"
+#include "core/util/include/sorting_network.hpp"
 #include "core/util/include/util.hpp"
 #include "oneapi/tbb/blocked_range.h"
 #include "oneapi/tbb/parallel_for.h"
@@ -48,7 +51,11 @@ void Radix(double *p, int len) {
 }
 
 void OddEvenBatcherMergeBlocksStep(std::pair<double *, int> &left, std::pair<double *, int> &right) {
-  std::inplace_merge(left.first, right.first, right.first + right.second);
+  // Branch-free network merge of [left.first, right.first) and the right block,
+  // only the left part is copied away
+  const std::vector<double> left_run(left.first, right.first);
+  const std::span<const double> right_run(right.first, static_cast<size_t>(right.second));
+  ppc::util::NetworkMerge(left_run, right_run, left.first);
   left.second += right.second;
 }
 
@@ -120,3 +127,6 @@ bool petrov_a_radix_double_batcher_tbb::TestTaskParallelTbb::PostProcessingImpl(
   std::ranges::copy(res_, reinterpret_cast<double *>(task_data->outputs[0]));
   return true;
 }
+
+PPC_REGISTER_SORT_TASK(petrov_a_radix_double_batcher_tbb::TestTaskParallelTbb, "petrov_a_radix_double_batcher", "tbb",
+                       double);
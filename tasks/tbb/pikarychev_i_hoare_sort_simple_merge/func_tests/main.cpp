@@ -41,4 +41,6 @@ TEST(pikarychev_i_hoare_sort_simple_merge_tbb, standard_1) { PerformTest(1, fals
 TEST(pikarychev_i_hoare_sort_simple_merge_tbb, standard_2) { PerformTest(2, false); }
 TEST(pikarychev_i_hoare_sort_simple_merge_tbb, standard_3) { PerformTest(3, false); }
 TEST(pikarychev_i_hoare_sort_simple_merge_tbb, standard_4) { PerformTest(4, false); }
-TEST(pikarychev_i_hoare_sort_simple_merge_tbb, standard_5) { PerformTest(5, false); }
\ No newline at end of file
+TEST(pikarychev_i_hoare_sort_simple_merge_tbb, standard_5) { PerformTest(5, false); }
+TEST(pikarychev_i_hoare_sort_simple_merge_tbb, standard_20000) { PerformTest(20000, false); }
+TEST(pikarychev_i_hoare_sort_simple_merge_tbb, reverse_20000) { PerformTest(20000, true); }
\ No newline at end of file
@@ -1,12 +1,21 @@
 #include <gtest/gtest.h>
 #include <tbb/global_control.h>
 
+#include <memory>
+
+#include "core/util/include/topology_tbb.hpp"
 #include "core/util/include/util.hpp"
 #include "oneapi/tbb/global_control.h"
 
 int main(int argc, char** argv) {
-  // Limit the number of threads in TBB
-  tbb::global_control control(tbb::global_control::max_allowed_parallelism, ppc::util::GetPPCNumThreads());
+  // Limit the number of threads in TBB, scaling sweeps change the limit through SetPPCNumThreads()
+  auto control = std::make_unique<tbb::global_control>(tbb::global_control::max_allowed_parallelism,
+                                                       ppc::util::GetPPCNumThreads());
+  ppc::util::AddNumThreadsObserver([&control](int num_threads) {
+    control.reset();
+    control = std::make_unique<tbb::global_control>(tbb::global_control::max_allowed_parallelism, num_threads);
+  });
+  ppc::util::PinningObserver observer;
 
   ::testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
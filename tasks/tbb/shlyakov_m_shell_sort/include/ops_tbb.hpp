@@ -1,5 +1,6 @@
 #pragma once
 
+#include <span>
 #include <utility>
 #include <vector>
 
@@ -7,7 +8,7 @@
 
 namespace shlyakov_m_shell_sort_tbb {
 
-void ShellSort(int left, int right, std::vector<int>& arr);
+void ShellSort(std::span<int> arr);
 void Merge(int left, int mid, int right, std::vector<int>& arr, std::vector<int>& buffer);
 
 class TestTaskTBB : public ppc::core::Task {
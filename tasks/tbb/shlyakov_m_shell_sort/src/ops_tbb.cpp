@@ -6,9 +6,13 @@
 #include <algorithm>
 #include <core/util/include/util.hpp>
 #include <cstddef>
+#include <span>
 #include <utility>
 #include <vector>
 
+#include "core/task/include/registry.hpp"
+#include "core/util/include/natural_merge.hpp"
+
 namespace shlyakov_m_shell_sort_tbb {
 
 bool TestTaskTBB::PreProcessingImpl() {
@@ -46,7 +50,9 @@ bool TestTaskTBB::RunImpl() {
     for (const auto& seg : segs) {
       const int l = seg.first;
       const int r = seg.second;
-      tg.run([this, l, r] { ShellSort(l, r, input_); });
+      if (l < r) {
+        tg.run([this, l, r] { ppc::util::AdaptiveSort(std::span<int>(input_).subspan(l, r - l + 1), ShellSort); });
+      }
     }
     tg.wait();
   });
@@ -63,18 +69,18 @@ bool TestTaskTBB::RunImpl() {
   return true;
 }
 
-void ShellSort(int left, int right, std::vector<int>& arr) {
+void ShellSort(std::span<int> arr) {
   int gap = 1;
-  const int size = right - left + 1;
+  const int size = static_cast<int>(arr.size());
   while (gap <= size / 3) {
     gap = gap * 3 + 1;
   }
 
   for (; gap > 0; gap /= 3) {
-    for (int k = left + gap; k <= right; ++k) {
+    for (int k = gap; k < size; ++k) {
       const int val = arr[k];
       int j = k;
-      while (j >= left + gap && arr[j - gap] > val) {
+      while (j >= gap && arr[j - gap] > val) {
         arr[j] = arr[j - gap];
         j -= gap;
       }
@@ -84,6 +90,15 @@ void ShellSort(int left, int right, std::vector<int>& arr) {
 }
 
 void Merge(int left, int mid, int right, std::vector<int>& arr, std::vector<int>& buffer) {
+  // blocks of partially ordered input are often in order already, otherwise
+  // only their overlapping ends need merging
+  if (mid >= right || arr[mid] <= arr[mid + 1]) {
+    return;
+  }
+  const auto first = arr.begin();
+  left = static_cast<int>(std::upper_bound(first + left, first + mid + 1, arr[mid + 1]) - first);
+  right = static_cast<int>(std::lower_bound(first + mid + 1, first + right + 1, arr[mid]) - first) - 1;
+
   const int merge_size = right - left + 1;
   if (buffer.size() < static_cast<std::size_t>(merge_size)) {
     buffer.resize(static_cast<std::size_t>(merge_size));
@@ -115,4 +130,6 @@ bool TestTaskTBB::PostProcessingImpl() {
   return true;
 }
 
-}  // namespace shlyakov_m_shell_sort_tbb
\ No newline at end of file
+}  // namespace shlyakov_m_shell_sort_tbb
+
+PPC_REGISTER_SORT_TASK(shlyakov_m_shell_sort_tbb::TestTaskTBB, "shlyakov_m_shell_sort", "tbb", int);
@@ -5,45 +5,15 @@
 #include <algorithm>
 #include <cmath>
 #include <cstddef>
-#include <deque>
 #include <numeric>
+#include <span>
 #include <utility>
 #include <vector>
 
-#include "oneapi/tbb/mutex.h"
+#include "core/util/include/multiway_merge.hpp"
+#include "oneapi/tbb/parallel_for.h"
 #include "oneapi/tbb/task_arena.h"
-#include "oneapi/tbb/task_group.h"
 
-std::vector<int> smirnov_i_radix_sort_simple_merge_tbb::TestTaskTBB::Merge(std::vector<int>& mas1,
-                                                                           std::vector<int>& mas2) {
-  std::vector<int> res;
-  res.reserve(mas1.size() + mas2.size());
-  int p1 = 0;
-  int p2 = 0;
-  while (static_cast<int>(mas1.size()) != p1 && static_cast<int>(mas2.size()) != p2) {
-    if (mas1[p1] < mas2[p2]) {
-      res.push_back(mas1[p1]);
-      p1++;
-    } else if (mas2[p2] < mas1[p1]) {
-      res.push_back(mas2[p2]);
-      p2++;
-    } else {
-      res.push_back(mas1[p1]);
-      res.push_back(mas2[p2]);
-      p1++;
-      p2++;
-    }
-  }
-  while (static_cast<int>(mas1.size()) != p1) {
-    res.push_back(mas1[p1]);
-    p1++;
-  }
-  while (static_cast<int>(mas2.size()) != p2) {
-    res.push_back(mas2[p2]);
-    p2++;
-  }
-  return res;
-}
 void smirnov_i_radix_sort_simple_merge_tbb::TestTaskTBB::RadixSort(std::vector<int>& mas) {
   if (mas.empty()) {
     return;
@@ -66,32 +36,13 @@ void smirnov_i_radix_sort_simple_merge_tbb::TestTaskTBB::RadixSort(std::vector<i
     std::swap(mas, sorting);
   }
 }
-void smirnov_i_radix_sort_simple_merge_tbb::TestTaskTBB::SortChunk(int i, int size, int nth, int& start,
-                                                                   tbb::mutex& mtx_start, tbb::mutex& mtx_firstdq,
-                                                                   std::deque<std::vector<int>>& firstdq) {
-  if (size <= 0 || mas_.empty()) {
-    return;
-  }
-  int self_offset = size / nth;
-  if (size % nth != 0) {
-    self_offset += static_cast<int>(i < size % nth);
-  }
-  std::vector<int> local_mas(self_offset);
-  mtx_start.lock();
-  int self_start = start;
-  start += self_offset;
-  mtx_start.unlock();
-  if (self_start < 0 || self_start >= static_cast<int>(mas_.size()) || self_offset < 0 ||
-      self_start + self_offset > static_cast<int>(mas_.size())) {
-    return;
-  }
-  std::copy(mas_.begin() + self_start, mas_.begin() + self_start + self_offset, local_mas.begin());
-  if (!local_mas.empty()) {
-    RadixSort(local_mas);
-    mtx_firstdq.lock();
-    firstdq.push_back(std::move(local_mas));
-    mtx_firstdq.unlock();
-  }
+std::vector<int> smirnov_i_radix_sort_simple_merge_tbb::TestTaskTBB::SortChunk(int i, int nth) const {
+  const size_t start = i * mas_.size() / nth;
+  const size_t end = (i + 1) * mas_.size() / nth;
+  std::vector<int> local_mas(mas_.begin() + static_cast<std::ptrdiff_t>(start),
+                             mas_.begin() + static_cast<std::ptrdiff_t>(end));
+  RadixSort(local_mas);
+  return local_mas;
 }
 bool smirnov_i_radix_sort_simple_merge_tbb::TestTaskTBB::PreProcessingImpl() {
   unsigned int input_size = task_data->inputs_count[0];
@@ -106,59 +57,15 @@ bool smirnov_i_radix_sort_simple_merge_tbb::TestTaskTBB::ValidationImpl() {
   return task_data->inputs_count[0] == task_data->outputs_count[0];
 }
 bool smirnov_i_radix_sort_simple_merge_tbb::TestTaskTBB::RunImpl() {
-  std::deque<std::vector<int>> firstdq;
-  std::deque<std::vector<int>> seconddq;
-  tbb::task_group tg;
-  int size = static_cast<int>(mas_.size());
-  const int nth = std::min(size, tbb::this_task_arena::max_concurrency());
-  tbb::mutex mtx;
-  tbb::mutex mtx_firstdq;
-  tbb::mutex mtx_start;
-  int start = 0;
+  const int nth = std::max(1, std::min(static_cast<int>(mas_.size()), tbb::this_task_arena::max_concurrency()));
+  std::vector<std::vector<int>> runs(nth);
+  tbb::parallel_for(0, nth, [&](int i) { runs[i] = SortChunk(i, nth); });
 
-  for (int i = 0; i < nth; i++) {
-    tg.run([this, i, size, nth, &start, &mtx_firstdq, &firstdq, &mtx_start]() {
-      SortChunk(i, size, nth, start, mtx_start, mtx_firstdq, firstdq);
-    });
-  }
-  tg.wait();
-  bool flag = static_cast<int>(firstdq.size()) != 1;
-  while (flag) {
-    for (int i = 0; i < nth; i++) {
-      tg.run([&firstdq, &mtx, &seconddq]() {
-        std::vector<int> mas1{};
-        std::vector<int> mas2{};
-        std::vector<int> merge_mas{};
-        mtx.lock();
-        if (static_cast<int>(firstdq.size()) >= 2) {
-          mas1 = std::move(firstdq.front());
-          firstdq.pop_front();
-          mas2 = std::move(firstdq.front());
-          firstdq.pop_front();
-        } else {
-          mtx.unlock();
-          return;
-        }
-        mtx.unlock();
-        if (!mas1.empty() && !mas2.empty()) {
-          merge_mas = Merge(mas1, mas2);
-        }
-        if (!merge_mas.empty()) {
-          mtx.lock();
-          seconddq.push_back(std::move(merge_mas));
-          mtx.unlock();
-        }
-      });
-    }
-    tg.wait();
-    if (static_cast<int>(firstdq.size()) == 1) {
-      seconddq.push_back(std::move(firstdq.front()));
-      firstdq.pop_front();
-    }
-    std::swap(firstdq, seconddq);
-    flag = static_cast<int>(firstdq.size()) != 1;
-  }
-  output_ = std::move(firstdq.front());
+  // All runs are merged in one pass, every task writes an equal part of the output
+  const std::vector<std::span<const int>> sorted_runs(runs.begin(), runs.end());
+  tbb::parallel_for(0, nth, [&](int part) {
+    ppc::util::MultiwayMergePart(sorted_runs, output_.data(), static_cast<size_t>(part), static_cast<size_t>(nth));
+  });
   return true;
 }
 bool smirnov_i_radix_sort_simple_merge_tbb::TestTaskTBB::PostProcessingImpl() {
@@ -24,11 +24,5 @@ class CannonTBB : public ppc::core::Task {
   std::vector<double> A_;
   std::vector<double> B_;
   std::vector<double> C_;
-
-  void InitialShift();
-  void BlockMultiply();
-  void ShiftBlocks();
-  void CopyBlocksToLocal(std::vector<double>& a_block, std::vector<double>& b_block, int base_row, int base_col);
-  void ComputeBlock(const std::vector<double>& a_block, const std::vector<double>& b_block, int base_row, int base_col);
 };
 }  // namespace vavilov_v_cannon_tbb